@@ -0,0 +1,296 @@
+// Execution engine benchmark
+//
+// Runs the same in-memory script through three execution paths:
+//   command : CommandFactory::create + virtual Command::execute per line (the original path)
+//   step    : CommandExecutor switch dispatch on the decoded value
+//   status  : the same through the no-throw tryExecute, on the runtime-sized and on a StaticGround<5, 5>,
+//             and on a ground with an (all free) ObstacleMap, for the cost of the obstacle bit test
+//   vm      : compileProgram once, then the threaded-code BytecodeVM (compile and run timed separately)
+//   fused   : the same program after Program::fuseRuns()
+//   segment : the fused program on SegmentEngine (closed-form MOVE/LEFT/RIGHT stretches)
+// then compares the Robot path with PackedRobot and TableExecutor lookups on pre-decoded commands, and
+// fused VM and segment engine on long runs across a 1000x1000 open floor, and finally 4096 robots sharing
+// one command stream: a Robot per robot against each LockstepEngine kernel (cost per robot-command).
+//
+// Usage: bench_engine [lines]   (default: 20000000)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Bytecode.hpp"
+#include "CommandExecutor.hpp"
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "LockstepEngine.hpp"
+#include "Logger.hpp"
+#include "ObstacleMap.hpp"
+#include "SegmentEngine.hpp"
+#include "StaticGround.hpp"
+#include "TableExecutor.hpp"
+
+namespace {
+
+using namespace simulator;
+
+class VectorReader : public InputReader {
+public:
+  explicit VectorReader(const std::vector<std::string> &lines) : lines(lines) {}
+
+  bool nextLine(std::string_view &line) override {
+    if (next >= lines.size()) {
+      return false;
+    }
+    line = lines[next++];
+    return true;
+  }
+
+private:
+  const std::vector<std::string> &lines;
+  std::size_t                     next = 0;
+};
+
+// Discards everything written to it, so REPORT lines do not measure the terminal
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override {
+    return c;
+  }
+};
+
+// Path-planner style script: runs of moves and turns, a few PLACEs and REPORTs, some failing moves
+std::vector<std::string> makeScript(std::size_t lines) {
+  const char *pattern[] = {"PLACE 0,0,NORTH", "MOVE",  "MOVE", "MOVE", "RIGHT", "MOVE", "MOVE",   "RIGHT",
+                           "MOVE",            "MOVE",  "RIGHT", "MOVE", "MOVE",  "LEFT", "MOVE",   "RIGHT",
+                           "LEFT",            "RIGHT", "MOVE",  "LEFT", "LEFT",  "MOVE", "REPORT", "MOVE"};
+
+  std::vector<std::string> script;
+  script.reserve(lines);
+  for (std::size_t i = 0; i < lines; ++i) {
+    script.emplace_back(pattern[i % (sizeof(pattern) / sizeof(pattern[0]))]);
+  }
+  return script;
+}
+
+// Square loops of 49-cell sides in the middle of a 1000x1000 ground, with a REPORT every 1000 lines
+std::vector<std::string> makeOpenFloorScript(std::size_t lines) {
+  std::vector<std::string> script;
+  script.reserve(lines);
+  script.emplace_back("PLACE 500,500,NORTH");
+  for (std::size_t i = 1; i < lines; ++i) {
+    if (i % 1000 == 0) {
+      script.emplace_back("REPORT");
+    } else if (i % 50 == 0) {
+      script.emplace_back("RIGHT");
+    } else {
+      script.emplace_back("MOVE");
+    }
+  }
+  return script;
+}
+
+template <typename Fn>
+void measure(const char *name, std::size_t lines, Fn &&body) {
+  auto start  = std::chrono::steady_clock::now();
+  int  errors = body();
+  auto end    = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::printf("%-12s %8.2f ns/line %10.3f s  (%d errors)\n", name, seconds * 1e9 / double(lines), seconds, errors);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000ULL;
+  std::printf("Executing %zu lines\n", lines);
+
+  Logger::getInstance().setLogLevel(LogLevel::NONE);
+
+  std::vector<std::string> script = makeScript(lines);
+  CommandFactory           factory;
+  SimulatorGround          ground(5, 5);
+
+  NullBuffer      nullBuffer;
+  std::streambuf *console = std::cout.rdbuf(&nullBuffer);
+
+  measure("command", lines, [&] {
+    Robot robot;
+    int   errors = 0;
+    for (const std::string &line : script) {
+      try {
+        factory.parse(line)->execute(robot, ground);
+      } catch (const SimulatorException &) {
+        ++errors;
+      }
+    }
+    return errors;
+  });
+
+  measure("step", lines, [&] {
+    Robot           robot;
+    CommandExecutor executor;
+    int             errors = 0;
+    for (const std::string &line : script) {
+      try {
+        executor.execute(factory.decode(line), robot, ground);
+      } catch (const InvalidInputException &) {
+        ++errors;
+      }
+    }
+    return errors;
+  });
+
+  auto measureStatus = [&](const char *name, const auto &bounds) {
+    measure(name, lines, [&] {
+      Robot           robot;
+      CommandExecutor executor;
+      int             errors = 0;
+      for (const std::string &line : script) {
+        errors += executor.tryExecute(factory.decode(line), robot, bounds).ok() ? 0 : 1;
+      }
+      return errors;
+    });
+  };
+  measureStatus("status", ground);
+  measureStatus("status 5x5", StaticGround<5, 5>());
+  SimulatorGround mapped(5, 5);
+  mapped.setObstacles(std::make_shared<const ObstacleMap>(5, 5));
+  measureStatus("status map", mapped);
+
+  Program program;
+  measure("vm compile", lines, [&] {
+    VectorReader reader(script);
+    program = compileProgram(reader, factory);
+    return 0;
+  });
+  measure("vm run", lines, [&] {
+    Robot      robot;
+    BytecodeVM vm;
+    return vm.run(program, robot, ground);
+  });
+  measure("fuse pass", lines, [&] {
+    program.fuseRuns();
+    return 0;
+  });
+  measure("fused run", lines, [&] {
+    Robot      robot;
+    BytecodeVM vm;
+    return vm.run(program, robot, ground);
+  });
+  std::unique_ptr<SegmentEngine> segments;
+  measure("segment build", lines, [&] {
+    segments = std::make_unique<SegmentEngine>(program);
+    return 0;
+  });
+  measure("segment run", lines, [&] {
+    Robot robot;
+    return segments->run(robot, ground);
+  });
+
+  std::printf("\nPre-decoded, 5x5\n");
+  std::vector<ParsedCommand> decoded;
+  decoded.reserve(lines);
+  for (const std::string &line : script) {
+    decoded.push_back(factory.decode(line));
+  }
+
+  measure("robot", lines, [&] {
+    Robot           robot;
+    CommandExecutor executor;
+    int             errors = 0;
+    for (const ParsedCommand &command : decoded) {
+      errors += executor.tryExecute(command, robot, ground).ok() ? 0 : 1;
+    }
+    return errors;
+  });
+  measure("packed", lines, [&] {
+    PackedRobot     robot;
+    CommandExecutor executor;
+    int             errors = 0;
+    for (const ParsedCommand &command : decoded) {
+      errors += executor.tryExecute(command, robot, ground).ok() ? 0 : 1;
+    }
+    return errors;
+  });
+  measure("table", lines, [&] {
+    TableExecutor table(ground);
+    RobotState    state  = table.unplaced();
+    int           errors = 0;
+    for (const ParsedCommand &command : decoded) {
+      errors += table.tryExecute(command, state).ok() ? 0 : 1;
+    }
+    return errors;
+  });
+
+  std::printf("\nOpen floor, 1000x1000\n");
+  std::vector<std::string> openFloor = makeOpenFloorScript(lines);
+  SimulatorGround          largeGround(1000, 1000);
+
+  VectorReader openFloorReader(openFloor);
+  program = compileProgram(openFloorReader, factory);
+  program.fuseRuns();
+  segments = std::make_unique<SegmentEngine>(program);
+
+  measure("fused run", lines, [&] {
+    Robot      robot;
+    BytecodeVM vm;
+    return vm.run(program, robot, largeGround);
+  });
+  measure("segment run", lines, [&] {
+    Robot robot;
+    return segments->run(robot, largeGround);
+  });
+  SimulatorGround mappedFloor(1000, 1000);
+  mappedFloor.setObstacles(std::make_shared<const ObstacleMap>(1000, 1000));
+  measure("segment map", lines, [&] {
+    Robot robot;
+    return segments->run(robot, mappedFloor);
+  });
+
+  // REPORT would dominate with thousands of robots, so the lockstep stream has none
+  const std::size_t  robots = 4096;
+  std::size_t        steps  = lines / robots + 1;
+  std::vector<Robot> starts(robots);
+  for (std::size_t i = 0; i < robots; ++i) {
+    starts[i].place(Position(static_cast<int>(i % 5), static_cast<int>(i / 5 % 5)), static_cast<Direction>(i % 4));
+  }
+  std::vector<ParsedCommand> stream;
+  for (std::size_t i = 0; i < steps; ++i) {
+    ParsedCommand command = decoded[i % decoded.size()];
+    stream.push_back(command.opcode == Opcode::REPORT ? factory.decode("MOVE") : command);
+  }
+
+  std::printf("\nLockstep, %zu robots x %zu commands, 5x5\n", robots, steps);
+  measure("robots", robots * steps, [&] {
+    std::vector<Robot> fleet = starts;
+    CommandExecutor    executor;
+    int                errors = 0;
+    for (const ParsedCommand &command : stream) {
+      for (Robot &robot : fleet) {
+        errors += executor.tryExecute(command, robot, ground).ok() ? 0 : 1;
+      }
+    }
+    return errors;
+  });
+  for (SimdKernel kernel : {SimdKernel::SCALAR, SimdKernel::SSE2, SimdKernel::AVX2}) {
+    if (!LockstepEngine::supports(kernel)) {
+      continue;
+    }
+    measure(toString(kernel), robots * steps, [&] {
+      LockstepEngine lockstep(ground, starts, kernel);
+      std::uint64_t  errors = 0;
+      for (const ParsedCommand &command : stream) {
+        errors += lockstep.execute(command).failures();
+      }
+      return static_cast<int>(errors);
+    });
+  }
+
+  std::cout.rdbuf(console);
+  return 0;
+}
@@ -0,0 +1,141 @@
+// Parser micro-benchmark
+//
+// Compares the per-line cost of four parse paths over a synthetic script:
+//   legacy  : the original trim/toUpperCase/split/stoi pipeline returning a heap Command
+//   parse   : CommandFactory::parse (decode + heap Command)
+//   decode  : CommandFactory::decode (string_view in, ParsedCommand value out)
+//   cached  : CachingCommandFactory::decode (one hash lookup per repeated line)
+//
+// Usage: bench_parser [lines]   (default: 100000000)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "CachingCommandFactory.hpp"
+#include "CommandFactory.hpp"
+
+namespace {
+
+std::atomic<std::size_t> allocationCount{0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace legacy {
+
+using namespace simulator;
+
+// Reference copy of the original CommandFactory::parse pipeline
+Direction parseDirection(const std::string &direction) {
+  std::string upper = toUpperCase(direction);
+
+  if (upper == "NORTH") {
+    return Direction::NORTH;
+  } else if (upper == "EAST") {
+    return Direction::EAST;
+  } else if (upper == "SOUTH") {
+    return Direction::SOUTH;
+  } else if (upper == "WEST") {
+    return Direction::WEST;
+  }
+  throw ParseException("Invalid direction: " + direction + ". Must be NORTH, EAST, SOUTH, or WEST");
+}
+
+std::unique_ptr<Command> parsePlaceCommand(const std::string &input) {
+  size_t spacePos = input.find(' ');
+  if (spacePos == std::string::npos) {
+    throw ParseException("PLACE command requires parameters: PLACE <x>,<y>,<FACE-DIRECTION>");
+  }
+
+  std::string              params = trim(input.substr(spacePos + 1));
+  std::vector<std::string> tokens = split(params, ',');
+  if (tokens.size() != 3) {
+    throw ParseException("PLACE command requires exactly 3 parameters: x,y,direction");
+  }
+
+  int x = std::stoi(trim(tokens[0]));
+  int y = std::stoi(trim(tokens[1]));
+
+  return std::make_unique<PlaceCommand>(Position(x, y), parseDirection(trim(tokens[2])));
+}
+
+std::unique_ptr<Command> parse(const std::string &input) {
+  std::string inputCommand = toUpperCase(trim(input));
+
+  if (inputCommand.find("PLACE") == 0) {
+    return parsePlaceCommand(inputCommand);
+  } else if (inputCommand == "MOVE") {
+    return std::make_unique<MoveCommand>();
+  } else if (inputCommand == "LEFT") {
+    return std::make_unique<LeftCommand>();
+  } else if (inputCommand == "RIGHT") {
+    return std::make_unique<RightCommand>();
+  } else if (inputCommand == "REPORT") {
+    return std::make_unique<ReportCommand>();
+  }
+  throw ParseException("Unknown command: " + inputCommand);
+}
+
+} // namespace legacy
+
+// Representative mix of a generated script: mostly moves and turns, a few PLACE variants
+const std::array<std::string, 8> SCRIPT = {"PLACE 1,2,NORTH", "MOVE", "MOVE", "left", "MOVE", "RIGHT", "report",
+                                           "Place 3 , 0 , east"};
+
+template <typename Fn>
+void measure(const char *name, std::size_t lines, Fn &&parseLine) {
+  std::size_t checksum = 0;
+
+  allocationCount.store(0);
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < lines; ++i) {
+    checksum += parseLine(SCRIPT[i % SCRIPT.size()]);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::printf("%-8s %10.2f ns/line %8.2f allocs/line %10.3f s  (checksum %zu)\n", name, seconds * 1e9 / double(lines),
+              double(allocationCount.load()) / double(lines), seconds, checksum);
+}
+
+int main(int argc, char *argv[]) {
+  std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000ULL;
+  std::printf("Parsing %zu lines\n", lines);
+
+  simulator::CommandFactory        factory;
+  simulator::CachingCommandFactory cache;
+
+  measure("legacy", lines, [](const std::string &line) { return legacy::parse(line) != nullptr ? 1U : 0U; });
+  measure("parse", lines, [&](const std::string &line) { return factory.parse(line) != nullptr ? 1U : 0U; });
+  measure("decode", lines, [&](const std::string &line) {
+    simulator::ParsedCommand command = factory.decode(line);
+    return static_cast<unsigned>(command.opcode) + static_cast<unsigned>(command.position.x);
+  });
+  measure("cached", lines, [&](const std::string &line) {
+    simulator::ParsedCommand command = cache.decode(line);
+    return static_cast<unsigned>(command.opcode) + static_cast<unsigned>(command.position.x);
+  });
+
+  return 0;
+}
@@ -13,6 +13,7 @@ file(GLOB_RECURSE ALL_CXX_SOURCE_FILES
     "${CMAKE_SOURCE_DIR}/include/*.[ch]pp"
     "${CMAKE_SOURCE_DIR}/include/*.[ch]xx"
     "${CMAKE_SOURCE_DIR}/tests/*.[ch]pp"
+    "${CMAKE_SOURCE_DIR}/bench/*.[ch]pp"
     "${CMAKE_SOURCE_DIR}/*.[ch]pp"
     "${CMAKE_SOURCE_DIR}/*.[ch]xx"
 )
@@ -4,7 +4,11 @@
 #include <cctype>
 #include <string>
 
+#include "Engine.hpp"
+#include "InputReader.hpp"
 #include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "Position.hpp"
 #include "SimulatorException.hpp"
 #include "utils.hpp"
 
@@ -27,6 +31,40 @@ public:
         } else {
           throw InvalidInputException("--file requires a filename argument");
         }
+      } else if (arg == "--pipe") {
+        pipeInput = true;
+      } else if (arg == "--batch") {
+        if (i + 1 < argc) {
+          batchPath = argv[++i];
+        } else {
+          throw InvalidInputException("--batch requires a directory or manifest argument");
+        }
+      } else if (arg == "--starts") {
+        if (i + 1 < argc) {
+          startsFile = argv[++i];
+        } else {
+          throw InvalidInputException("--starts requires a filename argument");
+        }
+      } else if (arg == "--map") {
+        if (i + 1 < argc) {
+          mapFile = argv[++i];
+        } else {
+          throw InvalidInputException("--map requires a filename argument");
+        }
+      } else if (arg == "--compile") {
+        if (i + 1 < argc) {
+          compileFile = argv[++i];
+        } else {
+          throw InvalidInputException("--compile requires a filename argument");
+        }
+      } else if (arg == "-o" || arg == "--output") {
+        if (i + 1 < argc) {
+          outputFile = argv[++i];
+        } else {
+          throw InvalidInputException(arg + " requires a filename argument");
+        }
+      } else if (arg == "--interactive") {
+        interactive = true;
       } else if (arg.find("--loglevel") == 0) {
 
         size_t pos = arg.find('=');
@@ -42,6 +80,29 @@ public:
 
         logLevel = parseLogLevel(levelStr);
 
+      } else if (arg.find("--parse-threads") == 0) {
+        std::string value = optionValue(arg, "--parse-threads", "a non-negative integer");
+        parseThreads      = parseCount(value, "--parse-threads");
+      } else if (arg.find("--threads") == 0) {
+        threads = parseCount(optionValue(arg, "--threads", "a non-negative integer"), "--threads");
+      } else if (arg.find("--pipeline") == 0) {
+        std::string value = optionValue(arg, "--pipeline", "a power of two queue depth, e.g. 4096");
+        pipelineDepth     = parseCount(value, "--pipeline");
+        if (pipelineDepth == 0 || (pipelineDepth & (pipelineDepth - 1)) != 0) {
+          throw InvalidInputException("--pipeline queue depth must be a power of two, got '" + value + "'");
+        }
+      } else if (arg.find("--parse-cache") == 0) {
+        parseCacheSize = parseCount(optionValue(arg, "--parse-cache", "a non-negative integer"), "--parse-cache");
+      } else if (arg.find("--engine") == 0) {
+        engine = parseEngine(optionValue(arg, "--engine", "step, table, fleet, lockstep, vm, segment"));
+      } else if (arg.find("--optimize") == 0) {
+        optimizations = parseOptimizations(optionValue(arg, "--optimize", "fuse, dce"));
+      } else if (arg.find("--output-format") == 0) {
+        outputFormat = parseOutputFormat(optionValue(arg, "--output-format", "text, jsonl, csv, binary"));
+      } else if (arg.find("--io") == 0) {
+        ioMode = parseIoMode(optionValue(arg, "--io", "stream, mmap"));
+      } else if (arg.find("--ground") == 0) {
+        parseGroundSize(optionValue(arg, "--ground", "<cols>x<rows>, e.g. 1000x1000"));
       } else {
         throw InvalidInputException("Unknown argument: " + arg + "\nUse --help for usage information");
       }
@@ -64,23 +125,294 @@ public:
     return !inputFile.empty();
   }
 
+  bool isPipeInput() const {
+    return pipeInput;
+  }
+
+  bool isInteractive() const {
+    return interactive;
+  }
+
+  bool isBatchMode() const {
+    return !batchPath.empty();
+  }
+
+  std::string getBatchPath() const {
+    return batchPath;
+  }
+
+  bool hasStartsFile() const {
+    return !startsFile.empty();
+  }
+
+  std::string getStartsFile() const {
+    return startsFile;
+  }
+
+  bool hasMapFile() const {
+    return !mapFile.empty();
+  }
+
+  std::string getMapFile() const {
+    return mapFile;
+  }
+
+  bool hasGroundSize() const {
+    return groundRows > 0;
+  }
+
+  Coordinate getGroundRows() const {
+    return groundRows;
+  }
+
+  Coordinate getGroundCols() const {
+    return groundCols;
+  }
+
+  // 0 = one batch worker per hardware thread
+  unsigned getThreads() const {
+    return threads;
+  }
+
+  bool isCompileMode() const {
+    return !compileFile.empty();
+  }
+
+  std::string getCompileFile() const {
+    return compileFile;
+  }
+
+  std::string getOutputFile() const {
+    return outputFile;
+  }
+
+  bool hasOutputFile() const {
+    return !outputFile.empty();
+  }
+
+  // 0 = serial parsing, otherwise number of parser threads
+  unsigned getParseThreads() const {
+    return parseThreads;
+  }
+
+  // 0 = no pipeline, otherwise queue depth between reader, parser and executor threads
+  unsigned getPipelineDepth() const {
+    return pipelineDepth;
+  }
+
+  // 0 = no cache, otherwise number of decoded lines to memoize
+  unsigned getParseCacheSize() const {
+    return parseCacheSize;
+  }
+
+  IoMode getIoMode() const {
+    return ioMode;
+  }
+
+  OutputFormat getOutputFormat() const {
+    return outputFormat;
+  }
+
+  Engine getEngine() const {
+    return engine;
+  }
+
+  Optimizations getOptimizations() const {
+    return optimizations;
+  }
+
   static void printHelp(std::ostream &ostream = std::cout) {
     ostream << "Robot Simulator - Command Line Options\n\n"
             << "Usage: simulator [OPTIONS]\n\n"
             << "Options:\n"
-            << "  --file <filename>        Specify input file to read\n"
+            << "  --file <filename>        Specify input file to read (text or compiled .rbc)\n"
+            << "  --pipe                   Read standard input to end of stream with large buffered\n"
+            << "                           reads (for piped input; empty lines do not stop input)\n"
+            << "  --batch <dir|manifest>   Run every script of a directory, or listed one per line in a\n"
+            << "                           manifest, on a thread pool; output is written in script order\n"
+            << "  --threads=<n>            Worker threads for --batch (default 0 = all cores)\n"
+            << "  --compile <filename>     Compile a text script into the binary .rbc format\n"
+            << "  -o, --output <filename>  Output file: the .rbc for --compile, otherwise REPORT results\n"
+            << "  --output-format=<format> Set how REPORT results are written\n"
+            << "                           Valid formats: text (default), jsonl, csv (with line numbers),\n"
+            << "                           binary (fixed 32-byte records, requires --output)\n"
+            << "  --interactive            Write each REPORT result immediately instead of buffering\n"
+            << "                           (always on when reading from the console)\n"
             << "  --loglevel=<level>       Set logging level\n"
             << "                           Valid levels: NONE, ERROR, WARNING, INFO, DEBUG, TRACE\n"
             << "                           (not case sensitive)\n"
+            << "  --io=<mode>              Set how input files are read\n"
+            << "                           Valid modes: stream (default), mmap\n"
+            << "  --parse-threads=<n>      Parse input files on <n> worker threads (0 = serial)\n"
+            << "  --pipeline=<depth>       Read, parse and execute on separate threads connected by\n"
+            << "                           queues of <depth> lines (power of two); .rbc and\n"
+            << "                           --parse-threads input is already decoded and skips parsing\n"
+            << "  --engine=<engine>        Set how scripts are executed\n"
+            << "                           Valid engines: step (default, line by line),\n"
+            << "                           table (step, with precomputed transitions on small grounds),\n"
+            << "                           fleet (step, with \"<id>: <command>\" lines driving many robots),\n"
+            << "                           lockstep (every command on all --starts robots, SIMD kernels),\n"
+            << "                           vm (compile the whole script to bytecode, then run it),\n"
+            << "                           segment (vm, with MOVE/LEFT/RIGHT stretches in closed form)\n"
+            << "  --starts <filename>      Starting PLACE of each robot for --engine=lockstep, one per line\n"
+            << "  --map <filename>         Obstacle map, one line per row from north to south, '#' blocked\n"
+            << "                           and '.' free (the ground takes the map's size), or one blocked\n"
+            << "                           \"x,y\" cell per line for large sparse grounds (needs --ground)\n"
+            << "  --ground=<cols>x<rows>   Ground size, each side from 1 to 2^40 cells (default 5x5)\n"
+            << "  --optimize=<passes>      Comma separated optimization passes for compiled engines\n"
+            << "                           Valid passes: fuse (merge MOVE runs and LEFT/RIGHT runs),\n"
+            << "                           dce (remove commands no REPORT can observe)\n"
+            << "  --parse-cache=<n>        Memoize up to <n> decoded lines (for highly repetitive scripts)\n"
+            << "                           Text input only; not with --parse-threads, --pipeline or --batch\n"
             << "  --help, -h               Display this help message\n\n"
             << "Examples:\n"
             << "  simulator --file input.txt --loglevel=DEBUG\n"
+            << "  simulator --file input.txt --io=mmap\n"
+            << "  simulator --file input.txt --engine=vm --optimize=dce,fuse\n"
+            << "  simulator --compile input.txt -o input.rbc\n"
+            << "  simulator --batch scripts/ --threads=8 --output results.txt\n"
+            << "  simulator --file input.txt --map floor.txt\n"
+            << "  simulator --file input.txt --ground=1000000000x1000000000 --map cells.txt\n"
+            << "  simulator --file input.txt --output results.txt\n"
+            << "  simulator --file input.txt --output-format=binary --output results.rbr\n"
+            << "  generator | simulator --pipe\n"
             << "  simulator --loglevel=error\n"
             << "  simulator --help\n"
             << std::endl;
   }
 
 private:
+  // Extract <value> from an option of the form --name=<value>
+  std::string optionValue(const std::string &arg, const std::string &name, const std::string &validValues) {
+    size_t pos = arg.find('=');
+    if (pos != name.size()) {
+      throw InvalidInputException(name + " must use format: " + name + "=<VALUE>\nValid values: " + validValues);
+    }
+
+    std::string value = arg.substr(pos + 1);
+    if (value.empty()) {
+      throw InvalidInputException(name + " requires a value after '='");
+    }
+
+    return value;
+  }
+
+  unsigned parseCount(const std::string &value, const std::string &name) {
+    unsigned long count = 0;
+    size_t        used  = 0;
+    try {
+      count = std::stoul(value, &used);
+    } catch (const std::exception &) {
+      used = 0;
+    }
+
+    if (used != value.size() || value[0] == '-' || count > (1UL << 24)) {
+      throw InvalidInputException("Invalid value for " + name + ": '" + value + "'");
+    }
+
+    return static_cast<unsigned>(count);
+  }
+
+  // <cols>x<rows>
+  void parseGroundSize(const std::string &value) {
+    size_t     split = value.find_first_of("xX");
+    Coordinate cols  = split == std::string::npos ? 0 : parseSide(value.substr(0, split));
+    Coordinate rows  = split == std::string::npos ? 0 : parseSide(value.substr(split + 1));
+
+    if (cols == 0 || rows == 0) {
+      throw InvalidInputException("Invalid value for --ground: '" + value +
+                                  "'\nUse <cols>x<rows> with sides from 1 to 2^40, e.g. 1000x1000");
+    }
+    groundCols = cols;
+    groundRows = rows;
+  }
+
+  // Whole number from 1 to MAX_GROUND_SIDE, 0 for anything else
+  static Coordinate parseSide(const std::string &text) {
+    long long side = 0;
+    size_t    used = 0;
+    try {
+      side = std::stoll(text, &used);
+    } catch (const std::exception &) {
+      return 0;
+    }
+
+    if (used != text.size() || !std::isdigit(static_cast<unsigned char>(text[0])) || side > MAX_GROUND_SIDE) {
+      return 0;
+    }
+    return side;
+  }
+
+  IoMode parseIoMode(const std::string &modeStr) {
+    std::string upper = toUpperCase(modeStr);
+
+    if (upper == "STREAM") {
+      return IoMode::STREAM;
+    } else if (upper == "MMAP") {
+      return IoMode::MMAP;
+    } else {
+      throw InvalidInputException("Invalid io mode: '" + modeStr + "'\n" +
+                                  "Valid modes are: stream, mmap (not case sensitive)");
+    }
+  }
+
+  OutputFormat parseOutputFormat(const std::string &formatStr) {
+    std::string upper = toUpperCase(formatStr);
+
+    if (upper == "TEXT") {
+      return OutputFormat::TEXT;
+    } else if (upper == "JSONL") {
+      return OutputFormat::JSONL;
+    } else if (upper == "CSV") {
+      return OutputFormat::CSV;
+    } else if (upper == "BINARY") {
+      return OutputFormat::BINARY;
+    } else {
+      throw InvalidInputException("Invalid output format: '" + formatStr + "'\n" +
+                                  "Valid formats are: text, jsonl, csv, binary (not case sensitive)");
+    }
+  }
+
+  Engine parseEngine(const std::string &engineStr) {
+    std::string upper = toUpperCase(engineStr);
+
+    if (upper == "STEP") {
+      return Engine::STEP;
+    } else if (upper == "TABLE") {
+      return Engine::TABLE;
+    } else if (upper == "FLEET") {
+      return Engine::FLEET;
+    } else if (upper == "LOCKSTEP") {
+      return Engine::LOCKSTEP;
+    } else if (upper == "VM") {
+      return Engine::VM;
+    } else if (upper == "SEGMENT") {
+      return Engine::SEGMENT;
+    } else {
+      throw InvalidInputException("Invalid engine: '" + engineStr + "'\n" +
+                                  "Valid engines are: step, table, fleet, lockstep, vm, segment (not case sensitive)");
+    }
+  }
+
+  Optimizations parseOptimizations(const std::string &passesStr) {
+    Optimizations passes;
+
+    for (const std::string &pass : split(passesStr, ',')) {
+      std::string upper = toUpperCase(trim(pass));
+
+      if (upper == "FUSE") {
+        passes.fuseRuns = true;
+      } else if (upper == "DCE") {
+        passes.eliminateDeadCode = true;
+      } else {
+        throw InvalidInputException("Invalid optimization pass: '" + pass + "'\n" +
+                                    "Valid passes are: fuse, dce (not case sensitive)");
+      }
+    }
+
+    return passes;
+  }
+
   LogLevel parseLogLevel(const std::string &levelStr) {
     std::string upper = toUpperCase(levelStr);
 
@@ -102,11 +434,28 @@ private:
     }
   }
 
-  int         argc;
-  char      **argv;
-  bool        showHelp = false;
-  std::string inputFile;
-  LogLevel    logLevel = LogLevel::NONE; // Default log level
+  int           argc;
+  char        **argv;
+  bool          showHelp    = false;
+  bool          pipeInput   = false;
+  bool          interactive = false;
+  std::string   inputFile;
+  std::string   compileFile;
+  std::string   batchPath;
+  std::string   startsFile;
+  std::string   mapFile;
+  std::string   outputFile;
+  LogLevel      logLevel       = LogLevel::NONE; // Default log level
+  IoMode        ioMode         = IoMode::STREAM;
+  OutputFormat  outputFormat   = OutputFormat::TEXT;
+  Engine        engine         = Engine::STEP;
+  Optimizations optimizations;
+  unsigned      parseThreads   = 0;
+  unsigned      pipelineDepth  = 0;
+  unsigned      parseCacheSize = 0;
+  unsigned      threads        = 0;
+  Coordinate    groundRows     = 0; // 0 = not given
+  Coordinate    groundCols     = 0;
 };
 
 } // namespace simulator
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine.hpp"
+#include "InputReader.hpp"
+#include "Logger.hpp"
+#include "ObstacleMap.hpp"
+#include "OutputSink.hpp"
+
+namespace simulator {
+
+// Outcome of a BatchRunner::run()
+struct BatchStats {
+  std::size_t   scripts = 0; // Scripts in the batch
+  std::size_t   failed  = 0; // Scripts that could not be run (unreadable, corrupt .rbc, ...)
+  unsigned      threads = 0; // Worker threads used
+  std::uint64_t steals  = 0; // Work-stealing events, see WorkStealingPool
+};
+
+// Runs many independent scripts in one process (--batch)
+//
+// Each script gets its own reader, parser, robot and ground and runs on a
+// WorkStealingPool worker, with its results and log lines captured per script
+// (OutputSink::Capture). Captures are written to the OutputSink strictly in
+// script order as soon as every earlier script has finished, so the output is
+// the same as running the scripts one after another, whatever the thread count.
+class BatchRunner {
+public:
+  // `threads` == 0 uses one worker per hardware thread
+  explicit BatchRunner(Engine executionEngine = Engine::STEP, Optimizations programOptimizations = Optimizations(),
+                       IoMode inputMode = IoMode::STREAM, unsigned threads = 0, Coordinate groundRows = 5,
+                       Coordinate groundCols = 5);
+
+  // Scripts named by `path`: the regular files of a directory sorted by name, or the
+  // lines of a manifest file (blank lines and '#' comments are skipped, relative
+  // paths are taken from the manifest's directory). Throws FileException.
+  static std::vector<std::string> collectScripts(const std::string &path);
+
+  // Give every script's ground these obstacles (shared, not copied); the ground takes the map's size
+  void setObstacles(std::shared_ptr<const ObstacleMap> map);
+
+  // Reader for one script file: compiled .rbc, compressed or text (read as `mode` says)
+  static std::unique_ptr<InputReader> openScript(const std::string &path, IoMode mode);
+
+  // Run all scripts and write their output in order; text output starts each script with "== <path> =="
+  BatchStats run(const std::vector<std::string> &scripts);
+
+private:
+  // Returns false if the script could not be run; the reason is logged into the capture
+  bool runScript(const std::string &path) const;
+
+  Engine                             engine;
+  Optimizations                      optimizations;
+  IoMode                             ioMode;
+  unsigned                           threadCount;
+  Coordinate                         rows;
+  Coordinate                         cols;
+  std::shared_ptr<const ObstacleMap> obstacles;
+  Logger                            &logger;
+  OutputSink                        &output;
+};
+
+} // namespace simulator
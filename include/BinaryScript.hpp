@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "MappedFile.hpp"
+#include "ParsedCommand.hpp"
+
+namespace simulator {
+
+// Compact binary encoding of a command script (.rbc)
+//
+// Layout, all integers little-endian:
+//   header  : magic "RBC\0", u16 version, u16 header size, u64 record count,
+//             u64 payload size, u64 FNV-1a checksum of the payload
+//   payload : one record per source line
+//     MOVE, LEFT, RIGHT, REPORT : 1 byte opcode
+//     PLACE                     : 1 byte (opcode | direction << 4), zigzag varint x, zigzag varint y
+//                                 (64-bit varints; 32-bit coordinates encode as they always did)
+//     parse error               : 1 byte INVALID opcode, 1 byte ParseError, varint length, raw line text
+//
+// Error records keep the original text so diagnostics match the text path exactly.
+namespace rbc {
+constexpr char          MAGIC[4]    = {'R', 'B', 'C', '\0'};
+constexpr std::uint16_t VERSION     = 1;
+constexpr std::size_t   HEADER_SIZE = 32;
+} // namespace rbc
+
+class BinaryScriptWriter {
+public:
+  // Opens `path` for writing, throws FileException on failure
+  explicit BinaryScriptWriter(const std::string &path);
+
+  BinaryScriptWriter(const BinaryScriptWriter &)            = delete;
+  BinaryScriptWriter &operator=(const BinaryScriptWriter &) = delete;
+
+  // Append the record for one source line; `line` is only stored for parse errors
+  void write(const ParsedCommand &command, std::string_view line);
+
+  // Flush the payload and fill in the header; must be called once all records are written
+  void finish();
+
+  std::uint64_t getRecordCount() const {
+    return recordCount;
+  }
+
+  std::uint64_t getPayloadSize() const {
+    return payloadSize;
+  }
+
+private:
+  void flush();
+
+  std::string       filepath;
+  std::ofstream     file;
+  std::vector<char> buffer;
+  std::uint64_t     recordCount = 0;
+  std::uint64_t     payloadSize = 0;
+  std::uint64_t     checksum;
+};
+
+// Compile every line of `reader` into an .rbc file, returns the number of records written
+std::uint64_t compileScript(InputReader &reader, const CommandFactory &factory, const std::string &outputPath);
+
+// Reads an .rbc file and hands out pre-decoded commands, no text parsing involved
+class BinaryScriptReader : public InputReader {
+public:
+  explicit BinaryScriptReader(const std::string path) : filepath(path) {}
+
+  // True if `path` starts with the .rbc magic bytes
+  static bool isBinaryScript(const std::string &path);
+
+  // Canonical text of the next record (e.g. for inspection or readInput())
+  bool nextLine(std::string_view &line) override;
+
+  bool nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) override;
+
+  bool decodesCommands() const override {
+    return true;
+  }
+
+private:
+  // Map the file and validate header and checksum, throws FileException if stale or corrupt
+  void open();
+  bool decodeRecord(ParsedCommand &command, std::string_view &text);
+
+  std::string                 filepath;
+  std::unique_ptr<MappedFile> file;
+  std::size_t                 offset      = 0;
+  std::size_t                 end         = 0;
+  std::size_t                 releaseMark = 0;
+  std::uint64_t               recordCount = 0;
+  std::uint64_t               recordsRead = 0;
+  std::string                 textBuffer;
+};
+
+} // namespace simulator
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CommandExecutor.hpp"
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "PackedRobot.hpp"
+#include "ParsedCommand.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Cells between an in-bounds (x, y) and the edge of a cols x rows ground, looking along `direction`
+inline std::uint64_t stepsToEdge(Coordinate x, Coordinate y, unsigned direction, std::uint64_t cols,
+                                 std::uint64_t rows) {
+  const auto          ux      = static_cast<std::uint64_t>(x);
+  const auto          uy      = static_cast<std::uint64_t>(y);
+  const std::uint64_t room[4] = {rows - 1 - uy, cols - 1 - ux, uy, ux};
+  return room[direction];
+}
+
+// Instruction set of the bytecode interpreter. The compiler emits one instruction per
+// input line plus a final HALT; MOVE_N, TURN and FAIL are only produced by optimization passes.
+enum class VmOp : std::uint8_t {
+  HALT,
+  PLACE,
+  MOVE,
+  LEFT,
+  RIGHT,
+  REPORT,
+  PARSE_ERROR,
+  MOVE_N, // `operand` consecutive MOVE lines
+  TURN,   // `operand` consecutive LEFT/RIGHT lines, net effect `direction` quarter turns to the right
+  FAIL    // `operand` removed lines that would have failed; x, y, direction hold the robot state they saw
+};
+
+struct Instruction {
+  // FAIL: `direction` value for a robot that had not been placed yet
+  static constexpr std::uint8_t UNPLACED = 0xFF;
+
+  VmOp          op        = VmOp::HALT;
+  std::uint8_t  direction = 0; // PLACE: Direction, TURN: net quarter turns to the right (0-3)
+  std::uint32_t operand   = 0; // PARSE_ERROR: index into Program::failures, MOVE_N/TURN/FAIL: number of lines
+  Coordinate    x         = 0; // PLACE: target position, FAIL: robot position
+  Coordinate    y         = 0;
+};
+
+// Summary of Program::eliminateDeadCommands()
+struct EliminationStats {
+  std::size_t commands = 0; // Lines in the program
+  std::size_t removed  = 0; // Lines no longer executed
+  std::size_t failures = 0; // Removed lines whose errors are counted without executing them
+};
+
+// A whole script lowered to a flat instruction array
+class Program {
+public:
+  // Number of source lines (the trailing HALT is not counted)
+  std::size_t lineCount() const {
+    return code.size() - 1;
+  }
+
+  // Instructions the VM executes: one per line, or the optimized form once a pass has run
+  const std::vector<Instruction> &instructions() const {
+    return optimized.empty() ? code : optimized;
+  }
+
+  // First source line (0-based) covered by instruction `pc` of instructions()
+  std::size_t lineOf(std::size_t pc) const {
+    return optimized.empty() ? pc : optimizedLines[pc];
+  }
+
+  // Decoded form of line `index` (0-based), as the factory produced it
+  ParsedCommand command(std::size_t index) const;
+
+  // Source text of line `index`; only kept for lines that failed to parse, empty otherwise
+  std::string_view source(std::size_t index) const;
+
+  // Optimization pass: merge runs of consecutive MOVE lines into MOVE_N and runs of
+  // LEFT/RIGHT lines into one TURN by their net rotation. The per-line code is kept,
+  // so errors inside a merged run are still reported against their own line.
+  // Returns the number of instructions removed.
+  std::size_t fuseRuns();
+
+  // Optimization pass: remove lines whose effects can never be observed by a REPORT.
+  // These are commands that fail (before the first valid PLACE, off the edge, parse
+  // errors), LEFT/RIGHT runs that cancel out, and anything overwritten by a later
+  // PLACE (or the end of the script) before the next REPORT. Failing lines become FAIL
+  // instructions, so error counts stay exact. With `keepMessages` every failing line
+  // keeps its own FAIL, which is needed to log its error message; otherwise adjacent
+  // ones are merged. Assumes a robot that has not been placed yet; must run before fuseRuns().
+  EliminationStats eliminateDeadCommands(const SimulatorGround &ground, bool keepMessages);
+
+  // Robot state recorded in a FAIL instruction
+  static Robot failedState(const Instruction &instruction);
+
+private:
+  friend Program compileProgram(InputReader &reader, const CommandFactory &factory);
+
+  struct ParseFailure {
+    ParsedCommand command;
+    std::string   text;
+  };
+
+  std::vector<Instruction>  code{Instruction{}}; // One per line, then HALT
+  std::vector<ParseFailure> failures;
+  std::vector<Instruction>  optimized; // Output of the optimization passes, empty if none ran
+  std::vector<std::size_t>  optimizedLines;
+};
+
+// Decode every remaining line of `reader` into a Program
+Program compileProgram(InputReader &reader, const CommandFactory &factory);
+
+// Threaded-code interpreter for compiled programs
+//
+// Robot state lives in locals for the whole run and each handler jumps straight to
+// the next one (computed goto on GCC/Clang, a switch loop elsewhere). Results and
+// error counts match the step-by-step engine; error messages are only built when
+// error logging is enabled. Per-command info logging is not done here: with info
+// enabled, callers step through the program with CommandExecutor instead.
+class BytecodeVM {
+public:
+  BytecodeVM() : logger(Logger::getInstance()), output(OutputSink::getInstance()) {}
+
+  // Run `program` on `robot`, returns the number of failed lines
+  int run(const Program &program, Robot &robot, const SimulatorGround &ground) const;
+
+  // Log the error of line `line` (0-based) as if it ran on `robot`; only called for lines that fail
+  void logFailure(const Program &program, std::size_t line, const Robot &robot, const SimulatorGround &ground) const;
+
+private:
+  CommandExecutor executor;
+  Logger         &logger;
+  OutputSink     &output;
+};
+
+} // namespace simulator
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "ParsedCommand.hpp"
+
+namespace simulator {
+
+// Hit/miss counters of a CachingCommandFactory
+struct ParseCacheStats {
+  std::size_t   capacity  = 0; // Number of cache slots
+  std::uint64_t hits      = 0; // Lines answered from the cache
+  std::uint64_t misses    = 0; // Lines decoded and stored
+  std::uint64_t evictions = 0; // Stored lines that replaced a different line
+  std::uint64_t uncached  = 0; // Lines too long to be cached, decoded every time
+};
+
+// Memoizing front end of CommandFactory for highly repetitive scripts
+//
+// Maps the raw bytes of a line to its decoded command, so a repeated line costs
+// one hash and one compare instead of a full decode. The cache is a bounded,
+// direct-mapped table: each line hashes to exactly one slot and a different line
+// landing there replaces it. Keys are stored inline, so lookups never allocate.
+//
+// Not thread-safe; use one instance per decoding thread.
+class CachingCommandFactory : public CommandFactory {
+public:
+  // Lines longer than this are decoded without caching
+  static constexpr std::size_t MAX_KEY_LENGTH = 31;
+
+  // `capacity` is rounded up to a power of two
+  explicit CachingCommandFactory(std::size_t capacity = 1024);
+
+  ParsedCommand decode(std::string_view input) const noexcept override;
+
+  ParseCacheStats getStats() const;
+
+  // Drop all cached lines (counters are kept)
+  void clear();
+
+private:
+  struct Entry {
+    std::uint64_t hash   = 0;
+    std::uint8_t  length = 0;
+    bool          used   = false;
+    char          key[MAX_KEY_LENGTH];
+    ParsedCommand command;
+  };
+
+  mutable std::vector<Entry> entries;
+  std::size_t                mask;
+  mutable ParseCacheStats    stats;
+};
+
+} // namespace simulator
@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "Logger.hpp"
+#include "OutputSink.hpp"
 #include "Robot.hpp"
 #include "SimulatorGround.hpp"
 #include "utils.hpp"
@@ -62,11 +63,12 @@ private:
 
 class ReportCommand : public Command {
 public:
-  ReportCommand() : logger(Logger::getInstance()) {}
+  ReportCommand() : logger(Logger::getInstance()), output(OutputSink::getInstance()) {}
 
   void execute(Robot &robot, SimulatorGround &ground) override;
 
 private:
-  Logger &logger;
+  Logger     &logger;
+  OutputSink &output;
 };
 } // namespace simulator
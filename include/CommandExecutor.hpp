@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+
+#include "ExecutionResult.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "PackedRobot.hpp"
+#include "ParsedCommand.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Runs decoded commands directly, without building a Command object per line
+//
+// Dispatch is a single switch over ParsedCommand::opcode, so executing a line
+// involves no heap allocation and no virtual call. Behaviour (state changes,
+// error messages, log output) matches the Command classes, which remain the
+// extensibility API. Info messages are only formatted when enabled.
+//
+// The ground is a template parameter: SimulatorGround, or a StaticGround whose
+// bounds are compile-time constants.
+class CommandExecutor {
+public:
+  CommandExecutor() : logger(Logger::getInstance()), output(OutputSink::getInstance()) {}
+
+  // Execute a command and report failures as a status code. Routine failures (not
+  // placed yet, off the edge) neither throw nor allocate; `line` is copied into the result.
+  // REPORT throws FileException when the output sink cannot write its results.
+  template <typename Ground>
+  ExecutionResult tryExecute(const ParsedCommand &command, Robot &robot, const Ground &ground,
+                             std::size_t line = 0) const;
+
+  // Same on the packed state of a robot; the ground must pass PackedRobot::fits() and have no obstacles
+  template <typename Ground>
+  ExecutionResult tryExecute(const ParsedCommand &command, PackedRobot &robot, const Ground &ground,
+                             std::size_t line = 0) const;
+
+  // Execute a command, throws InvalidInputException when it cannot run
+  void execute(const ParsedCommand &command, Robot &robot, const SimulatorGround &ground) const;
+
+  // Error message for a failed tryExecute() (only built when it is actually needed)
+  template <typename Ground>
+  static std::string describe(const ExecutionResult &result, const Ground &ground) {
+    return describe(result, ground.getRows(), ground.getCols());
+  }
+
+  static std::string describe(const ExecutionResult &result, Coordinate rows, Coordinate cols);
+
+private:
+  // Cold paths, kept out of line
+  void logPlaced(const ParsedCommand &command) const;
+  void logMoved(const Robot &robot) const;
+  void logRotated(Opcode opcode, const Robot &robot) const;
+  void report(const Robot &robot, std::size_t line) const;
+
+  Logger     &logger;
+  OutputSink &output;
+};
+
+template <typename Ground>
+ExecutionResult CommandExecutor::tryExecute(const ParsedCommand &command, Robot &robot, const Ground &ground,
+                                            std::size_t line) const {
+  ExecutionResult result;
+  result.opcode = command.opcode;
+  result.line   = line;
+
+  switch (command.opcode) {
+  case Opcode::PLACE:
+    if (!ground.isValidPosition(command.position)) {
+      result.error    = ground.isInside(command.position) ? ExecutionError::OBSTACLE
+                                                          : ExecutionError::PLACE_OUT_OF_BOUNDS;
+      result.position = command.position;
+      break;
+    }
+    robot.place(command.position, command.direction);
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logPlaced(command);
+    }
+    break;
+
+  case Opcode::MOVE: {
+    if (!robot.hasPlaced()) {
+      result.error = ExecutionError::NOT_PLACED;
+      break;
+    }
+    Position nextPosition = robot.calculateNextPosition();
+    if (!ground.isValidPosition(nextPosition)) {
+      result.error    = ground.isInside(nextPosition) ? ExecutionError::OBSTACLE : ExecutionError::MOVE_OUT_OF_BOUNDS;
+      result.position = nextPosition;
+      break;
+    }
+    robot.move();
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logMoved(robot);
+    }
+    break;
+  }
+
+  case Opcode::LEFT:
+  case Opcode::RIGHT:
+    if (!robot.hasPlaced()) {
+      result.error = ExecutionError::NOT_PLACED;
+      break;
+    }
+    if (command.opcode == Opcode::LEFT) {
+      robot.rotateLeft();
+    } else {
+      robot.rotateRight();
+    }
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logRotated(command.opcode, robot);
+    }
+    break;
+
+  case Opcode::REPORT:
+    report(robot, line);
+    break;
+
+  default:
+    result.error = ExecutionError::INVALID_COMMAND;
+    break;
+  }
+
+  return result;
+}
+
+template <typename Ground>
+ExecutionResult CommandExecutor::tryExecute(const ParsedCommand &command, PackedRobot &robot, const Ground &ground,
+                                            std::size_t line) const {
+  ExecutionResult result;
+  result.opcode = command.opcode;
+  result.line   = line;
+
+  switch (command.opcode) {
+  case Opcode::PLACE:
+    if (!ground.isValidPosition(command.position)) {
+      result.error    = ground.isInside(command.position) ? ExecutionError::OBSTACLE
+                                                          : ExecutionError::PLACE_OUT_OF_BOUNDS;
+      result.position = command.position;
+      break;
+    }
+    robot = PackedRobot::placed(command.position, command.direction);
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logPlaced(command);
+    }
+    break;
+
+  case Opcode::MOVE:
+    if (!robot.move(static_cast<std::uint32_t>(ground.getCols()), static_cast<std::uint32_t>(ground.getRows()))) {
+      result.error    = robot.hasPlaced() ? ExecutionError::MOVE_OUT_OF_BOUNDS : ExecutionError::NOT_PLACED;
+      result.position = robot.hasPlaced() ? robot.nextPosition() : Position();
+      break;
+    }
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logMoved(robot.toRobot());
+    }
+    break;
+
+  case Opcode::LEFT:
+  case Opcode::RIGHT:
+    if (!robot.hasPlaced()) {
+      result.error = ExecutionError::NOT_PLACED;
+      break;
+    }
+    if (command.opcode == Opcode::LEFT) {
+      robot.rotateLeft();
+    } else {
+      robot.rotateRight();
+    }
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logRotated(command.opcode, robot.toRobot());
+    }
+    break;
+
+  case Opcode::REPORT:
+    if (robot.hasPlaced()) {
+      output.report(line, robot.getPosition(), robot.getDirection());
+    } else {
+      report(Robot(), line);
+    }
+    break;
+
+  default:
+    result.error = ExecutionError::INVALID_COMMAND;
+    break;
+  }
+
+  return result;
+}
+
+} // namespace simulator
@@ -5,8 +5,10 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "Command.hpp"
+#include "ParsedCommand.hpp"
 #include "SimulatorException.hpp"
 #include "utils.hpp"
 
@@ -14,11 +16,21 @@ namespace simulator {
 
 class CommandFactory {
 public:
+  virtual ~CommandFactory() = default;
+
+  // Parse a line into an executable command, throws ParseException on invalid input
   std::unique_ptr<Command> parse(const std::string &input);
 
-private:
-  std::unique_ptr<Command> parsePlaceCommand(const std::string &input);
-  Direction                parseDirection(const std::string &direction);
+  // Allocation-free parse path: keywords are matched case-insensitively in place and
+  // errors are reported through ParsedCommand::error instead of exceptions.
+  // Virtual so a caching layer can sit in front of it (see CachingCommandFactory)
+  virtual ParsedCommand decode(std::string_view input) const noexcept;
+
+  // Build the command object for a successfully decoded line
+  std::unique_ptr<Command> create(const ParsedCommand &command) const;
+
+  // Error message for a failed decode of `input` (only built when it is actually needed)
+  static std::string describe(const ParsedCommand &command, std::string_view input);
 };
 
 } // namespace simulator
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "InputReader.hpp"
+#include "QueueSignal.hpp"
+#include "SpscRingBuffer.hpp"
+
+namespace simulator {
+
+enum class Compression {
+  NONE,
+  GZIP,
+  ZSTD
+};
+
+// Reader for gzip or zstd compressed scripts, decoded on the fly
+//
+// The format is detected from the file's magic bytes. A background thread
+// decompresses fixed-size blocks into a small ring of reusable buffers while the
+// caller splits lines out of them, so decompression overlaps with simulation and
+// the decompressed text is never held in memory as a whole. Whichever side finds the
+// ring empty or full polls briefly, then sleeps until the other side signals it.
+class CompressedFileReader : public InputReader {
+public:
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = std::size_t(1) << 20;
+  static constexpr std::size_t QUEUE_DEPTH        = 4;
+
+  explicit CompressedFileReader(const std::string path, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+  ~CompressedFileReader() override;
+
+  CompressedFileReader(const CompressedFileReader &)            = delete;
+  CompressedFileReader &operator=(const CompressedFileReader &) = delete;
+
+  // Compression format of `path` according to its magic bytes
+  static Compression detect(const std::string &path);
+
+  // Whether this build can decode `format`
+  static bool isSupported(Compression format);
+
+  bool nextLine(std::string_view &line) override;
+
+private:
+  struct Block {
+    std::vector<char> data;
+    std::size_t       size = 0;
+  };
+
+  void   start();
+  void   stop();
+  void   decodeLoop();
+  Block *waitForBlock(); // nullptr at end of stream
+
+  std::string           filepath;
+  std::size_t           blockSize;
+  SpscRingBuffer<Block> blocks;
+  QueueSignal           blockReady; // Decoder pushed a block or finished
+  QueueSignal           blockFree;  // Reader released a block
+  std::thread           decoderThread;
+  std::atomic<bool>     decoderDone{false};
+  std::atomic<bool>     stopping{false};
+  std::exception_ptr    decoderError;
+  std::string           carry; // Line spanning a block boundary
+  Block                *current  = nullptr;
+  std::size_t           position = 0;
+  bool                  started  = false;
+  bool                  finished = false;
+};
+
+} // namespace simulator
@@ -7,19 +7,24 @@ namespace simulator {
 
 class ConsoleReader : public InputReader {
 public:
-  std::vector<std::string> readInput() override {
-    std::vector<std::string> lines;
+  bool nextLine(std::string_view &line) override {
+    if (finished) {
+      return false;
+    }
 
-    std::string line;
-    while (std::getline(std::cin, line)) {
-      if (line.empty()) {
-        break;
-      }
-      lines.push_back(line);
+    // An empty line (or end of stream) terminates console input
+    if (!std::getline(std::cin, buffer) || buffer.empty()) {
+      finished = true;
+      return false;
     }
 
-    return lines;
+    line = buffer;
+    return true;
   }
+
+private:
+  std::string buffer;
+  bool        finished = false;
 };
 
 } // namespace simulator
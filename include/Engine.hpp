@@ -0,0 +1,25 @@
+#pragma once
+
+namespace simulator {
+
+// How RobotSimulator executes a script
+enum class Engine {
+  STEP,     // decode and execute one line at a time (constant memory, works on live input)
+  TABLE,    // like STEP, with precomputed state transitions on small grounds (TableExecutor)
+  FLEET,    // like STEP, with "<id>: <command>" lines driving many robots on one ground (RobotFleet)
+  LOCKSTEP, // like STEP, every command applied to many robots at once with vector kernels (LockstepEngine)
+  VM,       // compile the whole script to bytecode first, then run it in a threaded interpreter
+  SEGMENT   // compile, then run MOVE/LEFT/RIGHT stretches in closed form (SegmentEngine)
+};
+
+// Optimization passes applied to compiled programs (Engine::VM and Engine::SEGMENT)
+struct Optimizations {
+  bool fuseRuns          = false; // merge MOVE runs and LEFT/RIGHT runs, see Program::fuseRuns()
+  bool eliminateDeadCode = false; // drop commands REPORT can never observe, see Program::eliminateDeadCommands()
+
+  bool any() const {
+    return fuseRuns || eliminateDeadCode;
+  }
+};
+
+} // namespace simulator
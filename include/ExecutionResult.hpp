@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ParsedCommand.hpp"
+#include "Position.hpp"
+
+namespace simulator {
+
+// Why a command could not run; the message text is built on demand by CommandExecutor::describe
+enum class ExecutionError : std::uint8_t {
+  NONE,
+  NOT_PLACED,          // MOVE, LEFT or RIGHT before a valid PLACE
+  PLACE_OUT_OF_BOUNDS, // PLACE target outside the ground
+  MOVE_OUT_OF_BOUNDS,  // MOVE would leave the ground
+  INVALID_COMMAND,     // Command that did not decode
+  OCCUPIED,            // PLACE or MOVE onto a cell held by another robot (RobotFleet)
+  OBSTACLE             // PLACE or MOVE onto a blocked cell of the ground's ObstacleMap
+};
+
+// Value-type outcome of executing one command (no exception, no heap allocation)
+struct ExecutionResult {
+  ExecutionError error  = ExecutionError::NONE;
+  Opcode         opcode = Opcode::INVALID;
+  std::uint32_t  robot  = 0; // Robot that ran the command (RobotFleet), 0 otherwise
+  std::size_t    line   = 0; // Source line number, as passed by the caller
+  Position       position;   // *_OUT_OF_BOUNDS / OCCUPIED / OBSTACLE: the rejected position
+
+  bool ok() const {
+    return error == ExecutionError::NONE;
+  }
+};
+
+static_assert(std::is_trivially_copyable<ExecutionResult>::value, "ExecutionResult must stay a plain value type");
+
+} // namespace simulator
@@ -11,25 +11,35 @@ class FileReader : public InputReader {
 public:
   explicit FileReader(const std::string path) : filepath(path) {}
 
-  std::vector<std::string> readInput() override {
-    std::vector<std::string> lines;
-
-    std::ifstream file(filepath);
+  bool nextLine(std::string_view &line) override {
+    // Open lazily so that construction never touches the filesystem
     if (!file.is_open()) {
-      throw simulator::FileException(filepath);
+      if (finished) {
+        return false;
+      }
+
+      file.open(filepath);
+      if (!file.is_open()) {
+        throw simulator::FileException(filepath);
+      }
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-      lines.push_back(line);
+    // std::getline reuses the capacity of `buffer`, so memory stays constant
+    if (!std::getline(file, buffer)) {
+      file.close();
+      finished = true;
+      return false;
     }
 
-    file.close();
-    return lines;
+    line = buffer;
+    return true;
   }
 
 private:
-  std::string filepath;
+  std::string   filepath;
+  std::ifstream file;
+  std::string   buffer;
+  bool          finished = false;
 };
 
 } // namespace simulator
@@ -1,15 +1,58 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "CommandFactory.hpp"
+#include "ParsedCommand.hpp"
+
 namespace simulator {
 
+// How input files are read
+enum class IoMode {
+  STREAM, // std::ifstream + std::getline
+  MMAP    // memory-mapped, zero-copy line slices
+};
+
 // Abstract interface for reading inputs
+//
+// Readers are pull-based: each call to nextLine() hands out a single line, so the
+// simulator can execute it before the rest of the input has been read. The view
+// returned through `line` is only valid until the next call to nextLine().
 class InputReader {
 public:
   virtual ~InputReader() = default;
 
-  virtual std::vector<std::string> readInput() = 0;
+  // Fetch the next line; returns false once the input is exhausted
+  virtual bool nextLine(std::string_view &line) = 0;
+
+  // Fetch the next line already decoded into a command. Text readers decode with
+  // `factory`; readers of pre-compiled input override this to skip text parsing.
+  // `line` carries the source text when the reader has it, and may be empty otherwise.
+  virtual bool nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) {
+    if (!nextLine(line)) {
+      return false;
+    }
+    command = factory.decode(line);
+    return true;
+  }
+
+  // Whether nextCommand() hands out commands the reader decoded itself, without `factory`
+  virtual bool decodesCommands() const {
+    return false;
+  }
+
+  // Convenience helper that drains the remaining input into memory
+  std::vector<std::string> readInput() {
+    std::vector<std::string> lines;
+
+    std::string_view line;
+    while (nextLine(line)) {
+      lines.emplace_back(line);
+    }
+
+    return lines;
+  }
 };
 } // namespace simulator
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "ParsedCommand.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Vector instruction set used by LockstepEngine
+enum class SimdKernel {
+  SCALAR, // plain loops, any target
+  SSE2,   // 4 robots per instruction (x86-64 baseline)
+  AVX2    // 8 robots per instruction, chosen at run time when the CPU has it
+};
+
+inline const char *toString(SimdKernel kernel) {
+  switch (kernel) {
+  case SimdKernel::SSE2:
+    return "SSE2";
+  case SimdKernel::AVX2:
+    return "AVX2";
+  default:
+    return "scalar";
+  }
+}
+
+// Failures of one command across all robots of a LockstepEngine
+struct LockstepResult {
+  Opcode        opcode    = Opcode::INVALID;
+  std::size_t   line      = 0;
+  std::uint32_t notPlaced = 0; // Robots a MOVE, LEFT or RIGHT could not run on, not placed yet
+  std::uint32_t blocked   = 0; // Robots a MOVE would have taken off the ground or onto an obstacle, or a PLACE
+                               // could not place
+  Position      position;      // PLACE: the rejected position
+
+  std::uint32_t failures() const {
+    return notPlaced + blocked;
+  }
+};
+
+// Many independent robots driven by one command stream (Monte Carlo runs)
+//
+// Every robot starts from its own PLACE and then receives the same commands. State
+// is kept as a structure of arrays (x[], y[], dir[], placed[]) of 32-bit lanes,
+// padded to a whole number of AVX2 registers, and MOVE/LEFT/RIGHT run as vector
+// kernels over all robots: the step comes from direction compares, the bounds
+// check is a vector compare whose mask gates the update, and failures are counted
+// in a vector accumulator, so no lane ever branches. Obstacles of the ground are
+// one more mask: AVX2 gathers the obstacle bits of 8 targets at once from a dense
+// map, sparse maps and the SSE2 and scalar kernels test them lane by lane. Robots do not collide.
+//
+// Results match running each robot through CommandExecutor on a Robot, which stays
+// the reference implementation; PLACE and REPORT are rare and run scalar.
+class LockstepEngine {
+public:
+  // Best kernel this CPU supports
+  static SimdKernel bestKernel();
+  static bool       supports(SimdKernel kernel);
+
+  // One robot per PLACE line of `reader`; throws InvalidInputException for any other
+  // line and for starts that are not free cells of `ground`
+  static std::vector<Robot> readStarts(InputReader &reader, const CommandFactory &factory,
+                                       const SimulatorGround &ground);
+
+  // `kernel` must be supported, see supports(); lanes are 32-bit, so the ground may be at
+  // most 2^31 - 1 cells a side (InvalidInputException otherwise)
+  LockstepEngine(const SimulatorGround &simulatorGround, const std::vector<Robot> &starts,
+                 SimdKernel kernel = bestKernel());
+
+  // Run a decoded command on every robot; source line `line` tags REPORT results
+  LockstepResult execute(const ParsedCommand &command, std::size_t line = 0);
+
+  std::size_t size() const {
+    return robotCount;
+  }
+
+  std::size_t placedCount() const {
+    return placed;
+  }
+
+  SimdKernel getKernel() const {
+    return kernel;
+  }
+
+  // Copy of one robot's state
+  Robot robot(std::size_t id) const;
+
+private:
+  void report(std::size_t line) const;
+
+  const SimulatorGround &ground;
+  SimdKernel             kernel;
+  std::size_t            robotCount;
+  std::size_t            placed = 0; // Robots placed so far (PLACE places all or none)
+  Logger                &logger;
+  OutputSink            &output;
+
+  // One lane per robot, padded with unplaced robots; placedMask lanes are 0 or -1
+  std::vector<std::int32_t> xs;
+  std::vector<std::int32_t> ys;
+  std::vector<std::int32_t> directions;
+  std::vector<std::int32_t> placedMask;
+};
+
+} // namespace simulator
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 
+#include "OutputSink.hpp"
+
 namespace simulator {
 
 enum class LogLevel {
@@ -37,6 +41,11 @@ inline std::ostream &operator<<(std::ostream &ostream, LogLevel level) {
   }
 }
 
+// Process-wide logger
+//
+// Safe to use from several threads: the level is atomic and console lines are
+// written whole. Threads running under an OutputSink::Capture (batch workers)
+// log into their capture, next to their results.
 class Logger {
 public:
   static Logger &getInstance() {
@@ -51,27 +60,41 @@ public:
   Logger &operator=(Logger &&)      = delete;
 
   void setLogLevel(LogLevel level) {
-    currentLevel = level;
+    currentLevel.store(level, std::memory_order_relaxed);
   }
 
   LogLevel getLogLevel() const {
-    return currentLevel;
+    return currentLevel.load(std::memory_order_relaxed);
   }
 
   std::string getLogLevelAsString() const {
     std::ostringstream oss;
-    oss << currentLevel;
+    oss << getLogLevel();
     return oss.str();
   }
 
+  // Lets callers skip building messages that would be discarded anyway
+  bool isEnabled(LogLevel level) const {
+    LogLevel current = getLogLevel();
+    return current != LogLevel::NONE && level <= current;
+  }
+
   void log(LogLevel level, const std::string &message) {
     // Check if logging is disabled or level is too low
-    if (currentLevel == LogLevel::NONE || level > currentLevel) {
+    if (!isEnabled(level)) {
       return;
     }
 
     std::string logMessage = formatLogMessage(level, message);
 
+    if (std::string *capture = OutputSink::captured()) {
+      capture->append(logMessage).push_back('\n');
+      return;
+    }
+
+    // Pending REPORT results were produced before this line
+    std::lock_guard<std::mutex> lock(consoleMutex);
+    OutputSink::getInstance().flushConsole();
     std::cout << logMessage << std::endl;
   }
 
@@ -104,10 +127,11 @@ private:
     std::ostringstream oss;
 
     // Add timestamp
-    std::time_t now      = std::time(nullptr);
-    std::tm    *timeinfo = std::localtime(&now);
-    char        timestamp[20];
-    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
+    std::time_t now = std::time(nullptr);
+    std::tm     timeinfo{};
+    localtime_r(&now, &timeinfo);
+    char timestamp[20];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
 
     oss << "[" << timestamp << "] " << "[" << std::left << std::setw(7) << level << "] " << message;
     // oss << "[" << timestamp << "] " << "[" << level << "] " << message;
@@ -115,7 +139,8 @@ private:
     return oss.str();
   }
 
-  LogLevel currentLevel;
+  std::atomic<LogLevel> currentLevel;
+  std::mutex            consoleMutex;
 };
 
 } // namespace simulator
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace simulator {
+
+// Read-only mmap(2) of a whole file, unmapped on destruction
+class MappedFile {
+public:
+  // Throws FileException if the file cannot be opened or mapped
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &)            = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data() const {
+    return bytes;
+  }
+
+  std::size_t size() const {
+    return length;
+  }
+
+  // Hand pages that lie entirely before `offset` back to the kernel. Callers must
+  // not touch that range again without faulting it back in from the file.
+  void releaseBefore(std::size_t offset);
+
+private:
+  const char *bytes    = nullptr;
+  std::size_t length   = 0;
+  std::size_t released = 0; // Bytes already handed back to the kernel
+};
+
+} // namespace simulator
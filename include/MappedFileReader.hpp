@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "InputReader.hpp"
+#include "MappedFile.hpp"
+
+namespace simulator {
+
+// Zero-copy file reader backed by mmap(2)
+//
+// The whole file is mapped read-only and nextLine() returns slices that point
+// straight into the mapping, so no line is ever copied or allocated. Pages that
+// the cursor has moved past are released periodically to keep the resident set
+// bounded on very large inputs.
+class MappedFileReader : public InputReader {
+public:
+  explicit MappedFileReader(const std::string path) : filepath(path) {}
+
+  bool nextLine(std::string_view &line) override;
+
+private:
+  std::string                 filepath;
+  std::unique_ptr<MappedFile> file;
+  std::size_t                 offset      = 0;
+  std::size_t                 releaseMark = 0; // Offset of the last page release
+};
+
+} // namespace simulator
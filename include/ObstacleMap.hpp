@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Position.hpp"
+
+namespace simulator {
+
+// Blocked cells of a floor (shelving, pillars), one bit per cell
+//
+// Maps of up to DENSE_CELLS cells pack their bits row-major into 64-bit words, so a
+// blocked-cell check is a shift and a mask, a 1000x1000 floor takes 125 KB, and free
+// runs along a row are scanned a word at a time. Larger maps (up to 2^40 cells a
+// side) are sparse: one 64-bit word per 8x8 tile that holds an obstacle, in a hash
+// table keyed by tile, so memory follows the number of obstacles rather than the
+// area, and ray and rectangle queries visit either the tiles they cross or every
+// stored tile, whichever is fewer.
+//
+// A map is not changed once built: grounds share it through a
+// shared_ptr<const ObstacleMap>, so one loaded map serves any number of grounds,
+// threads and simulations without copies or locks.
+class ObstacleMap {
+public:
+  // Largest map kept as a dense bitset (8 MB)
+  static constexpr std::size_t DENSE_CELLS = std::size_t{1} << 26;
+
+  // All cells free; throws InvalidInputException for non-positive dimensions or sides over MAX_GROUND_SIDE
+  ObstacleMap(Coordinate rows, Coordinate cols);
+
+  // Map file, in one of two formats:
+  //  - grid: one line per row, the northmost row (y = rows - 1) first; '#' marks a
+  //    blocked cell and '.' a free one. Every row must have the same length; the
+  //    map's size is the ground's size.
+  //  - cell list: one blocked cell "x,y" per line, for large sparse grounds; the
+  //    map takes the ground size rows x cols, which must be given.
+  // Throws FileException, ParseException or InvalidInputException.
+  static std::shared_ptr<const ObstacleMap> load(const std::string &path, Coordinate rows = 0, Coordinate cols = 0);
+
+  // Same from the rows of a grid map file
+  static ObstacleMap fromRows(const std::vector<std::string> &lines);
+
+  // Same from the lines of a cell list map file
+  static ObstacleMap fromCells(const std::vector<std::string> &lines, Coordinate rows, Coordinate cols);
+
+  void block(const Position &pos);
+
+  // `pos` must lie on the map
+  bool isBlocked(const Position &pos) const {
+    if (!dense) {
+      auto tile = tiles.find(Position(pos.x >> TILE_SHIFT, pos.y >> TILE_SHIFT));
+      return tile != tiles.end() && (tile->second >> tileBit(pos.x, pos.y) & 1) != 0;
+    }
+    std::size_t index = cell(pos.x, pos.y);
+    return (bits[index >> 6] >> (index & 63) & 1) != 0;
+  }
+
+  // Free cells a robot at x,y facing `direction` can move through, at most `limit`;
+  // the `limit` cells ahead must lie on the map
+  std::uint32_t freeSteps(Coordinate x, Coordinate y, unsigned direction, std::uint32_t limit) const;
+
+  // True if no cell of the rectangle [lowX, highX] x [lowY, highY] (on the map) is blocked
+  bool isClear(std::int64_t lowX, std::int64_t lowY, std::int64_t highX, std::int64_t highY) const;
+
+  std::size_t blockedCount() const;
+
+  Coordinate getRows() const {
+    return rows;
+  }
+
+  Coordinate getCols() const {
+    return cols;
+  }
+
+  // False for sparse (tiled) maps
+  bool isDense() const {
+    return dense;
+  }
+
+  // Packed bits of a dense map, cell y * cols + x is bit (cell % 64) of word cell / 64;
+  // nullptr for a sparse map
+  const std::uint64_t *data() const {
+    return dense ? bits.data() : nullptr;
+  }
+
+private:
+  // Sparse maps: 8x8 tiles, cell (x & 7, y & 7) of a tile is bit (y & 7) * 8 + (x & 7)
+  static constexpr int TILE_SHIFT = 3;
+
+  static unsigned tileBit(Coordinate x, Coordinate y) {
+    return static_cast<unsigned>((y & 7) << TILE_SHIFT | (x & 7));
+  }
+
+  std::size_t cell(std::int64_t x, std::int64_t y) const {
+    return static_cast<std::size_t>(y) * static_cast<std::size_t>(cols) + static_cast<std::size_t>(x);
+  }
+
+  // Sparse maps: a blocked cell of the rectangle, false if it is clear; for a rectangle one
+  // cell wide or tall, the one nearest to its low end (or to its high end if `fromHigh`)
+  bool nearestTileCell(Coordinate lowX, Coordinate lowY, Coordinate highX, Coordinate highY, bool fromHigh,
+                       Position &found) const;
+
+  // First blocked cell in [begin, end), or `end`
+  std::size_t firstBlocked(std::size_t begin, std::size_t end) const;
+  // Number of free cells directly below `end` going down to `begin`, i.e. end - 1 - last blocked cell
+  std::size_t freeBelow(std::size_t begin, std::size_t end) const;
+
+  Coordinate                                                rows;
+  Coordinate                                                cols;
+  bool                                                      dense;
+  std::vector<std::uint64_t>                                bits;  // Dense maps
+  std::unordered_map<Position, std::uint64_t, PositionHash> tiles; // Sparse maps: tile x,y -> its cells
+};
+
+} // namespace simulator
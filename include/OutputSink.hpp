@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Direction.hpp"
+#include "Position.hpp"
+
+namespace simulator {
+
+// How REPORT results are written
+enum class OutputFormat {
+  TEXT,  // "Output: x,y,DIRECTION" (default)
+  JSONL, // {"line":n,"x":x,"y":y,"direction":"DIRECTION"} per line
+  CSV,   // "line,x,y,direction" header, then one row per result
+         // With robot ids (multi-robot runs): "id: Output: ...", a "robot" field, a robot column
+  BINARY // fixed-size records, see rbr below
+};
+
+// Fixed-size binary result records (--output-format=binary)
+//
+// Layout, all integers little-endian:
+//   header  : magic "RBR\0", u16 version, u16 header size, u16 record size, 6 reserved bytes
+//   records : ReportRecord, back to back until the end of the file
+//
+// Nothing follows the records and the header carries no count, so a file can be
+// streamed and read (or mapped) while it grows: records = (size - header) / record size.
+namespace rbr {
+constexpr char          MAGIC[4]    = {'R', 'B', 'R', '\0'};
+constexpr std::uint16_t VERSION     = 1;
+constexpr std::size_t   HEADER_SIZE = 16;
+constexpr std::size_t   RECORD_SIZE = 32;
+} // namespace rbr
+
+// In-memory view of one binary record on a little-endian host
+struct ReportRecord {
+  std::uint64_t line;      // 1-based source line, 0 when unknown (Command::execute)
+  std::int64_t  x;         // Coordinates are stored 64-bit so the layout does not depend on Position
+  std::int64_t  y;
+  std::uint32_t direction; // Direction value: NORTH 0, EAST 1, SOUTH 2, WEST 3
+  std::uint32_t robot;     // Robot id in multi-robot runs, 0 otherwise
+};
+
+static_assert(sizeof(ReportRecord) == rbr::RECORD_SIZE && std::is_trivially_copyable<ReportRecord>::value,
+              "ReportRecord must match the on-disk record layout");
+
+// Buffered destination of REPORT results
+//
+// Results are formatted with std::to_chars into one reusable buffer, which is
+// written out only when it is full, when flush() is called (RobotSimulator does
+// at the end of a run), or after every result in interactive mode. The target is
+// the console (std::cout, as redirected at flush time) or a file.
+//
+// Results and log lines share the console, so Logger flushes pending console
+// results before every log line to keep their order.
+//
+// The buffer and target belong to one thread at a time. Other threads produce
+// output under a Capture, which keeps their results and log lines in a string
+// of their own (BatchRunner hands those to write() in order).
+class OutputSink {
+public:
+  static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+  // Redirects the results, log lines and notices of the calling thread into `target` while it lives.
+  // Results are formatted as configured; the buffer and target of the sink are left alone.
+  class Capture {
+  public:
+    explicit Capture(std::string &target);
+    ~Capture();
+
+    Capture(const Capture &)            = delete;
+    Capture &operator=(const Capture &) = delete;
+
+  private:
+    std::string *previous;
+  };
+
+  // Capture target of the calling thread, nullptr if it has none
+  static std::string *captured();
+
+  static OutputSink &getInstance() {
+    static OutputSink instance;
+    return instance;
+  }
+
+  OutputSink(const OutputSink &)            = delete;
+  OutputSink &operator=(const OutputSink &) = delete;
+  OutputSink(OutputSink &&)                 = delete;
+  OutputSink &operator=(OutputSink &&)      = delete;
+
+  // Write results to `path` (truncated), throws FileException if it cannot be created
+  void openFile(const std::string &path);
+
+  // Write results to std::cout again (the default)
+  void useConsole();
+
+  bool writesToConsole() const {
+    return !file.is_open();
+  }
+
+  // Label results with the robot that reported them (RobotFleet); call before setFormat()
+  void setRobotIds(bool enabled) {
+    robotIds = enabled;
+  }
+
+  bool hasRobotIds() const {
+    return robotIds;
+  }
+
+  // Choose the target first: CSV and BINARY start with their header
+  void setFormat(OutputFormat outputFormat);
+
+  OutputFormat getFormat() const {
+    return format;
+  }
+
+  // Flush after every result, for input typed or streamed by someone waiting on the answer
+  void setInteractive(bool enabled) {
+    interactive = enabled;
+  }
+
+  bool isInteractive() const {
+    return interactive;
+  }
+
+  // Append the result of the REPORT on source line `line` (1-based, 0 if unknown) by robot `robot`
+  void report(std::size_t line, const Position &position, Direction direction, std::uint32_t robot = 0);
+
+  // Console notice (e.g. "No input lines to process"), written after the pending console results
+  void print(std::string_view text);
+
+  // Append already formatted output, e.g. a capture, as is
+  void write(std::string_view text);
+
+  // Write out pending results, throws FileException if the output file cannot be written.
+  // Does nothing under a Capture.
+  void flush();
+
+  // Flush only if pending results go to the console
+  void flushConsole() {
+    if (captured() == nullptr && used > 0 && writesToConsole()) {
+      flush();
+    }
+  }
+
+  ~OutputSink();
+
+private:
+  OutputSink() : buffer(BUFFER_SIZE) {}
+
+  char *formatReport(char *out, char *end, std::size_t line, const Position &position, Direction direction,
+                     std::uint32_t robot) const;
+
+  std::vector<char> buffer;
+  std::size_t       used        = 0;
+  OutputFormat      format      = OutputFormat::TEXT;
+  bool              interactive = false;
+  bool              robotIds    = false;
+  std::ofstream     file;
+  std::string       filePath;
+};
+
+} // namespace simulator
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "Direction.hpp"
+#include "Position.hpp"
+#include "Robot.hpp"
+
+namespace simulator {
+
+// Unit steps indexed by Direction (NORTH, EAST, SOUTH, WEST)
+constexpr std::int32_t DELTA_X[4] = {0, 1, 0, -1};
+constexpr std::int32_t DELTA_Y[4] = {1, 0, -1, 0};
+
+// Direction after LEFT / RIGHT, indexed by Direction
+constexpr std::uint32_t ROTATE_LEFT[4]  = {3, 0, 1, 2};
+constexpr std::uint32_t ROTATE_RIGHT[4] = {1, 2, 3, 0};
+
+// Robot state in one 32-bit word
+//
+//   bits  0-13  x
+//   bits 14-27  y
+//   bits 28-29  direction
+//   bit  30     placed
+//
+// Sixteen states fit in a cache line, and MOVE/LEFT/RIGHT are table lookups,
+// shifts and a conditional select, without branching on the direction or on
+// the bounds check. The default value is an unplaced robot. Grounds up to
+// 16384 cells on each side fit, see fits().
+class PackedRobot {
+public:
+  static constexpr int COORDINATE_BITS = 14;
+  static constexpr int MAX_SIDE        = 1 << COORDINATE_BITS;
+
+  constexpr PackedRobot() = default;
+
+  static constexpr bool fits(Coordinate rows, Coordinate cols) {
+    return rows <= MAX_SIDE && cols <= MAX_SIDE;
+  }
+
+  // `position` must lie on a ground that fits()
+  static PackedRobot placed(const Position &position, Direction direction) {
+    return PackedRobot(static_cast<std::uint32_t>(position.x) |
+                       static_cast<std::uint32_t>(position.y) << Y_SHIFT |
+                       static_cast<std::uint32_t>(direction) << DIRECTION_SHIFT | PLACED_BIT);
+  }
+
+  static PackedRobot fromRobot(const Robot &robot) {
+    return robot.hasPlaced() ? placed(robot.getPosition(), robot.getDirection()) : PackedRobot();
+  }
+
+  Robot toRobot() const {
+    Robot robot;
+    if (hasPlaced()) {
+      robot.place(getPosition(), getDirection());
+    }
+    return robot;
+  }
+
+  bool hasPlaced() const {
+    return (word & PLACED_BIT) != 0;
+  }
+
+  Position getPosition() const {
+    return Position(static_cast<Coordinate>(x()), static_cast<Coordinate>(y()));
+  }
+
+  Direction getDirection() const {
+    return static_cast<Direction>(direction());
+  }
+
+  // MOVE on a cols x rows ground; the state is left as is when the robot is not
+  // placed or would leave the ground, in which case this returns false
+  bool move(std::uint32_t cols, std::uint32_t rows) {
+    const std::uint32_t d      = direction();
+    const std::uint32_t nextX  = x() + static_cast<std::uint32_t>(DELTA_X[d]);
+    const std::uint32_t nextY  = y() + static_cast<std::uint32_t>(DELTA_Y[d]);
+    const bool          inside = hasPlaced() & (nextX < cols) & (nextY < rows);
+    const std::uint32_t moved  = (word & ~COORDINATE_MASK) | nextX | nextY << Y_SHIFT;
+
+    word = inside ? moved : word;
+    return inside;
+  }
+
+  // Cell MOVE would go to (only meaningful for a placed robot)
+  Position nextPosition() const {
+    const std::uint32_t d = direction();
+    return Position(static_cast<Coordinate>(x()) + DELTA_X[d], static_cast<Coordinate>(y()) + DELTA_Y[d]);
+  }
+
+  // Unplaced robots are left as is
+  void rotateLeft() {
+    rotate(ROTATE_LEFT);
+  }
+
+  void rotateRight() {
+    rotate(ROTATE_RIGHT);
+  }
+
+  std::uint32_t raw() const {
+    return word;
+  }
+
+  bool operator==(const PackedRobot &other) const {
+    return word == other.word;
+  }
+
+  bool operator!=(const PackedRobot &other) const {
+    return word != other.word;
+  }
+
+private:
+  static constexpr int           Y_SHIFT         = COORDINATE_BITS;
+  static constexpr int           DIRECTION_SHIFT = 2 * COORDINATE_BITS;
+  static constexpr std::uint32_t COORDINATE_MASK = (1U << DIRECTION_SHIFT) - 1;
+  static constexpr std::uint32_t AXIS_MASK       = (1U << COORDINATE_BITS) - 1;
+  static constexpr std::uint32_t DIRECTION_MASK  = 3U << DIRECTION_SHIFT;
+  static constexpr std::uint32_t PLACED_BIT      = 1U << (DIRECTION_SHIFT + 2);
+
+  explicit PackedRobot(std::uint32_t packed) : word(packed) {}
+
+  std::uint32_t x() const {
+    return word & AXIS_MASK;
+  }
+
+  std::uint32_t y() const {
+    return word >> Y_SHIFT & AXIS_MASK;
+  }
+
+  std::uint32_t direction() const {
+    return word >> DIRECTION_SHIFT & 3U;
+  }
+
+  void rotate(const std::uint32_t (&table)[4]) {
+    const std::uint32_t rotated = (word & ~DIRECTION_MASK) | table[direction()] << DIRECTION_SHIFT;
+    word                        = hasPlaced() ? rotated : word;
+  }
+
+  std::uint32_t word = 0;
+};
+
+static_assert(sizeof(PackedRobot) == 4 && std::is_trivially_copyable<PackedRobot>::value,
+              "PackedRobot must stay a single 32-bit word");
+
+} // namespace simulator
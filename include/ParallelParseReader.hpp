@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "MappedFile.hpp"
+#include "ParsedCommand.hpp"
+
+namespace simulator {
+
+// Text file reader that parses on a pool of worker threads
+//
+// The mapped file is cut into newline-aligned chunks. Workers decode chunks
+// independently into command buffers while the caller consumes them strictly in
+// file order, so execution order and line numbers are exactly those of the serial
+// path. Only a bounded window of chunks is in flight, keeping memory constant.
+class ParallelParseReader : public InputReader {
+public:
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t(1) << 20;
+
+  // `threads` == 0 uses one worker per hardware thread
+  explicit ParallelParseReader(const std::string path, unsigned threads = 0,
+                               std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+  ~ParallelParseReader() override;
+
+  ParallelParseReader(const ParallelParseReader &)            = delete;
+  ParallelParseReader &operator=(const ParallelParseReader &) = delete;
+
+  bool nextLine(std::string_view &line) override;
+
+  // Commands come pre-decoded by the workers; `factory` is not used
+  bool nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) override;
+
+  bool decodesCommands() const override {
+    return true;
+  }
+
+  unsigned getThreadCount() const {
+    return threadCount;
+  }
+
+private:
+  struct Chunk {
+    std::vector<ParsedCommand>    commands;
+    std::vector<std::string_view> lines;
+    bool                          ready = false;
+  };
+
+  void        start();
+  void        stop();
+  void        worker();
+  void        parseChunk(std::size_t index, Chunk &chunk) const;
+  std::size_t chunkBegin(std::size_t index) const;
+  bool        advance(); // Make `current` point at a chunk with unread lines
+
+  std::string                 filepath;
+  unsigned                    threadCount;
+  std::size_t                 chunkSize;
+  std::unique_ptr<MappedFile> file;
+  CommandFactory              decoder;
+
+  std::vector<Chunk>       window; // Chunk k lives in window[k % window.size()]
+  std::vector<std::thread> workers;
+  std::mutex               mutex;
+  std::condition_variable  chunkReady;
+  std::condition_variable  slotFree;
+  std::size_t              chunkCount  = 0;
+  std::size_t              nextToParse = 0; // Next chunk a worker will claim
+  std::size_t              current     = 0; // Chunk being consumed
+  std::size_t              position    = 0;     // Next record within the current chunk
+  std::size_t              releaseMark = 0;     // Offset of the last page release
+  bool                     holding     = false; // Whether `current` has been taken from the window
+  bool                     stopping    = false;
+};
+
+} // namespace simulator
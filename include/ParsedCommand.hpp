@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "Direction.hpp"
+#include "Position.hpp"
+
+namespace simulator {
+
+enum class Opcode : std::uint8_t {
+  INVALID,
+  PLACE,
+  MOVE,
+  LEFT,
+  RIGHT,
+  REPORT
+};
+
+// Why a line could not be decoded; the message text is built on demand by CommandFactory::describe
+enum class ParseError : std::uint8_t {
+  NONE,
+  EMPTY_COMMAND,
+  PLACE_MISSING_PARAMETERS,
+  PLACE_PARAMETER_COUNT,
+  INVALID_COORDINATES,
+  INVALID_DIRECTION,
+  UNKNOWN_COMMAND
+};
+
+// Value-type result of decoding one input line (no heap allocation involved)
+struct ParsedCommand {
+  Opcode     opcode    = Opcode::INVALID;
+  ParseError error     = ParseError::NONE;
+  Direction  direction = Direction::NORTH; // PLACE only
+  Position   position;                     // PLACE only
+
+  bool ok() const {
+    return error == ParseError::NONE;
+  }
+};
+
+// Commands are passed around and stored by value (queues, .rbc records, CommandExecutor)
+static_assert(std::is_trivially_copyable<ParsedCommand>::value, "ParsedCommand must stay a plain value type");
+
+// Canonical text form of a successfully decoded command
+inline std::ostream &operator<<(std::ostream &ostream, const ParsedCommand &command) {
+  switch (command.opcode) {
+  case Opcode::PLACE:
+    return ostream << "PLACE " << command.position << "," << command.direction;
+  case Opcode::MOVE:
+    return ostream << "MOVE";
+  case Opcode::LEFT:
+    return ostream << "LEFT";
+  case Opcode::RIGHT:
+    return ostream << "RIGHT";
+  case Opcode::REPORT:
+    return ostream << "REPORT";
+  default:
+    return ostream << "INVALID";
+  }
+}
+
+inline std::string toString(const ParsedCommand &command) {
+  std::ostringstream oss;
+  oss << command;
+  return oss.str();
+}
+
+} // namespace simulator
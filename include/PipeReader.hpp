@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "InputReader.hpp"
+
+namespace simulator {
+
+// High-throughput reader for piped input (stdin by default)
+//
+// Unlike ConsoleReader it reads to end of stream rather than stopping at an empty
+// line, and it bypasses iostreams: large read(2) calls fill a reusable buffer and
+// lines are handed out as slices of that buffer. read(2) is only issued when no
+// complete line is buffered, so each command is returned as soon as it arrives.
+class PipeReader : public InputReader {
+public:
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t(1) << 20;
+
+  explicit PipeReader(int fd = 0, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+  bool nextLine(std::string_view &line) override;
+
+private:
+  // Read more bytes into the buffer; returns false at end of stream
+  bool fill();
+
+  int               fd;
+  std::vector<char> buffer;
+  std::size_t       begin = 0; // Start of unconsumed data
+  std::size_t       end   = 0; // End of valid data
+  std::size_t       scan  = 0; // Bytes from `begin` already known to hold no '\n'
+  bool              eof   = false;
+};
+
+} // namespace simulator
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "CommandFactory.hpp"
+#include "InputReader.hpp"
+#include "ParsedCommand.hpp"
+#include "QueueSignal.hpp"
+#include "SpscRingBuffer.hpp"
+
+namespace simulator {
+
+// Counters for sizing the pipeline queues
+struct PipelineStats {
+  std::size_t   queueCapacity        = 0;
+  std::size_t   maxLineQueueDepth    = 0; // Highest observed depth between reader and parser
+  std::size_t   maxCommandQueueDepth = 0; // Highest observed depth between parser and executor
+  std::uint64_t readerStalls         = 0; // Reader found its output queue full
+  std::uint64_t parserStarved        = 0; // Parser found the line queue empty
+  std::uint64_t parserStalls         = 0; // Parser found the command queue full
+  std::uint64_t executorStarved      = 0; // Executor found the command queue empty
+};
+
+// Decorator that overlaps I/O, parsing and execution
+//
+// A reader thread pulls lines from the wrapped reader, a parser thread decodes them,
+// and the caller (the executor) consumes decoded commands. The stages are connected
+// by bounded lock-free SPSC ring buffers whose slots are reused, so the pipeline
+// runs in constant memory. A stage facing an empty or full queue polls it briefly and
+// then sleeps until the neighbouring stage signals it. Errors raised by the wrapped reader are rethrown to the
+// caller once all lines read before the failure have been consumed.
+//
+// Sources that decode on their own (compiled .rbc scripts, parallel parsing) skip the
+// parser stage: the reader thread pulls their commands straight into the command queue.
+class PipelinedReader : public InputReader {
+public:
+  static constexpr std::size_t DEFAULT_QUEUE_DEPTH = 4096;
+
+  // `queueDepth` must be a power of two
+  explicit PipelinedReader(std::unique_ptr<InputReader> source, std::size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+  ~PipelinedReader() override;
+
+  PipelinedReader(const PipelinedReader &)            = delete;
+  PipelinedReader &operator=(const PipelinedReader &) = delete;
+
+  bool nextLine(std::string_view &line) override;
+
+  // Commands are decoded on the parser thread; `factory` is not used
+  bool nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) override;
+
+  bool decodesCommands() const override {
+    return true;
+  }
+
+  // Snapshot of the counters; exact once the input has been fully consumed
+  PipelineStats getStats() const;
+
+private:
+  struct DecodedLine {
+    ParsedCommand command;
+    std::string   text;
+  };
+
+  void start();
+  void stop();
+  void readerLoop();
+  void commandReaderLoop(); // Reader stage for sources that decode on their own
+  void parserLoop();
+  void logStats() const;
+
+  std::unique_ptr<InputReader> source;
+  CommandFactory               decoder;
+  SpscRingBuffer<std::string>  lineQueue;
+  SpscRingBuffer<DecodedLine>  commandQueue;
+  QueueSignal                  lineReady;    // Reader pushed a line or finished
+  QueueSignal                  lineFree;     // Parser released a line slot
+  QueueSignal                  commandReady; // Parser pushed a command or finished
+  QueueSignal                  commandFree;  // Executor released a command slot
+  std::thread                  readerThread;
+  std::thread                  parserThread;
+  std::atomic<bool>            readerDone{false};
+  std::atomic<bool>            parserDone{false};
+  std::atomic<bool>            stopping{false};
+  std::exception_ptr           readerError;
+  bool                         started  = false;
+  bool                         finished = false;
+  bool                         holding  = false; // Whether the front command has been handed out
+
+  // Each counter is written by a single stage only
+  std::atomic<std::size_t>   maxLineQueueDepth{0};
+  std::atomic<std::size_t>   maxCommandQueueDepth{0};
+  std::atomic<std::uint64_t> readerStalls{0};
+  std::atomic<std::uint64_t> parserStarved{0};
+  std::atomic<std::uint64_t> parserStalls{0};
+  std::atomic<std::uint64_t> executorStarved{0};
+};
+
+} // namespace simulator
@@ -1,15 +1,24 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 
 namespace simulator {
 
+// Grid coordinate; 64-bit so grounds can reach 2^40 cells a side
+using Coordinate = std::int64_t;
+
+// Largest side of a ground or obstacle map; far enough from the 64-bit limits that
+// x + steps and rows * cols (as a double) never overflow
+constexpr Coordinate MAX_GROUND_SIDE = Coordinate{1} << 40;
+
 struct Position {
-  int x;
-  int y;
+  Coordinate x;
+  Coordinate y;
 
   Position() : x(0), y(0) {}
-  Position(int x_pos, int y_pos) : x(x_pos), y(y_pos) {}
+  Position(Coordinate x_pos, Coordinate y_pos) : x(x_pos), y(y_pos) {}
 
   bool operator==(const Position &other) const {
     return x == other.x && y == other.y;
@@ -20,6 +29,15 @@ struct Position {
   }
 };
 
+// Hash for cells in unordered containers (sparse grounds)
+struct PositionHash {
+  std::size_t operator()(const Position &pos) const noexcept {
+    std::uint64_t hash = static_cast<std::uint64_t>(pos.x) * 0x9E3779B97F4A7C15ULL;
+    hash ^= static_cast<std::uint64_t>(pos.y) + 0x7F4A7C159E3779B9ULL + (hash << 6) + (hash >> 2);
+    return static_cast<std::size_t>(hash);
+  }
+};
+
 inline std::ostream &operator<<(std::ostream &ostream, const Position &pos) {
   return ostream << pos.x << "," << pos.y;
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace simulator {
+
+// Spin-then-block wake-up for one end of a lock-free queue
+//
+// wait() polls its condition up to SPIN_LIMIT times, yielding in between, and then
+// sleeps on a condition variable until the other end calls notify(). notify() only
+// takes the mutex when a waiter is asleep, so a busy pipeline never locks; an idle
+// one stops burning a core after a bounded number of polls.
+class QueueSignal {
+public:
+  static constexpr unsigned SPIN_LIMIT = 64;
+
+  // Return once `ready()` holds; it is re-evaluated after every notify()
+  template <typename Predicate>
+  void wait(Predicate ready) {
+    for (unsigned spin = 0; spin < SPIN_LIMIT; ++spin) {
+      if (ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    sleepers.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in notify(): either the notifier sees the sleeper, or ready() sees its update
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    condition.wait(lock, ready);
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Call after making the waiter's condition true (publishing to the queue, setting a flag)
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    // A waiter between its last check and the sleep holds the mutex, so this cannot slip in between
+    { std::lock_guard<std::mutex> lock(mutex); }
+    condition.notify_all();
+  }
+
+private:
+  std::mutex              mutex;
+  std::condition_variable condition;
+  std::atomic<unsigned>   sleepers{0};
+};
+
+} // namespace simulator
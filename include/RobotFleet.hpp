@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "ExecutionResult.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "ParsedCommand.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Many robots on one ground, addressed by id
+//
+// Robot state is kept as a structure of arrays (x, y, direction, placed), so a
+// command touches four small, dense vectors and a broadcast (tick()) walks them
+// sequentially. Robots share the ground: the fleet turns on its occupancy grid,
+// a PLACE or MOVE onto a cell held by another robot fails with
+// ExecutionError::OCCUPIED, and each collision check is a single lookup.
+//
+// Ids are dense, starting at 0; addressing a robot creates it (and every lower id)
+// unplaced. The fleet owns the occupancy of the ground while it lives.
+class RobotFleet {
+public:
+  // Highest robot id + 1 accepted by parseAddress()
+  static constexpr std::uint32_t MAX_ROBOTS = 1U << 20;
+
+  // Address of a line sent to every robot, see parseAddress()
+  static constexpr std::uint32_t ALL_ROBOTS = UINT32_MAX;
+
+  enum class Address {
+    OK,
+    INVALID_ID // prefix is not "*" or a number below MAX_ROBOTS
+  };
+
+  explicit RobotFleet(SimulatorGround &simulatorGround);
+  ~RobotFleet();
+
+  RobotFleet(const RobotFleet &)            = delete;
+  RobotFleet &operator=(const RobotFleet &) = delete;
+
+  // Split "<id>: <command>" into the robot and the command text. Lines without a
+  // prefix go to robot 0, "*: <command>" to ALL_ROBOTS.
+  static Address parseAddress(std::string_view line, std::uint32_t &robot, std::string_view &command) noexcept;
+
+  // Execute a command on one robot; `robot` must be below MAX_ROBOTS
+  ExecutionResult tryExecute(std::uint32_t robot, const ParsedCommand &command, std::size_t line = 0);
+
+  // Execute a command on every robot addressed so far in id order, calling `onFailure(result)`
+  // for each one that fails. Robots that are not placed yet are skipped, except for PLACE,
+  // which goes to every robot: collisions are resolved in id order, so a broadcast PLACE
+  // onto one cell places the lowest id there and fails the others with OCCUPIED.
+  template <typename OnFailure>
+  void tick(const ParsedCommand &command, std::size_t line, OnFailure &&onFailure);
+
+  // Robots addressed so far
+  std::size_t size() const {
+    return placedFlags.size();
+  }
+
+  std::size_t placedCount() const;
+
+  // Copy of one robot's state (unplaced if it was never addressed)
+  Robot robot(std::uint32_t id) const;
+
+  const SimulatorGround &getGround() const {
+    return ground;
+  }
+
+private:
+  void grow(std::uint32_t robot);
+  void report(std::uint32_t robot, std::size_t line) const;
+  void logChanged(std::uint32_t robot, Opcode opcode) const;
+
+  SimulatorGround &ground;
+  Logger          &logger;
+  OutputSink      &output;
+
+  std::vector<Coordinate>   xs;
+  std::vector<Coordinate>   ys;
+  std::vector<std::uint8_t> directions;
+  std::vector<std::uint8_t> placedFlags;
+};
+
+template <typename OnFailure>
+void RobotFleet::tick(const ParsedCommand &command, std::size_t line, OnFailure &&onFailure) {
+  auto count = static_cast<std::uint32_t>(placedFlags.size());
+  for (std::uint32_t robot = 0; robot < count; ++robot) {
+    if (placedFlags[robot] == 0 && command.opcode != Opcode::PLACE) {
+      continue;
+    }
+    ExecutionResult result = tryExecute(robot, command, line);
+    if (!result.ok()) {
+      onFailure(result);
+    }
+  }
+}
+
+} // namespace simulator
@@ -4,22 +4,35 @@
 #include <string>
 #include <vector>
 
+#include "Bytecode.hpp"
+#include "CommandExecutor.hpp"
 #include "CommandFactory.hpp"
+#include "Engine.hpp"
 #include "InputReader.hpp"
+#include "LockstepEngine.hpp"
 #include "Logger.hpp"
 #include "Robot.hpp"
+#include "RobotFleet.hpp"
+#include "SegmentEngine.hpp"
 #include "SimulatorException.hpp"
 #include "SimulatorGround.hpp"
+#include "StaticGround.hpp"
+#include "TableExecutor.hpp"
 
 namespace simulator {
 
 class RobotSimulator {
 public:
   explicit RobotSimulator(std::unique_ptr<InputReader> inputReader, std::unique_ptr<CommandFactory> commandParser,
-                          std::unique_ptr<SimulatorGround> simulatorGround)
+                          std::unique_ptr<SimulatorGround> simulatorGround, Engine executionEngine = Engine::STEP,
+                          Optimizations      programOptimizations = Optimizations(),
+                          std::vector<Robot> lockstepStarts       = std::vector<Robot>())
     : reader(std::move(inputReader))
     , parser(std::move(commandParser))
     , ground(std::move(simulatorGround))
+    , engine(executionEngine)
+    , optimizations(programOptimizations)
+    , starts(std::move(lockstepStarts))
     , logger(Logger::getInstance()) {
 
     if (!reader) {
@@ -41,9 +54,40 @@ public:
   void run();
 
 private:
+  void runStepwise(std::size_t &lineNumber, int &errorNumber);
+  void runTable(std::size_t &lineNumber, int &errorNumber);
+  void runFleet(std::size_t &lineNumber, int &errorNumber);
+  void runLockstep(std::size_t &lineNumber, int &errorNumber);
+  void runCompiled(std::size_t &lineNumber, int &errorNumber);
+
+  // Ground is SimulatorGround or a StaticGround of the same size, State is Robot or PackedRobot
+  template <typename Ground>
+  void stepLoop(const Ground &bounds, std::size_t &lineNumber, int &errorNumber);
+  template <typename Ground, typename State>
+  void stepLoop(const Ground &bounds, State &state, std::size_t &lineNumber, int &errorNumber);
+  template <typename Ground, typename State>
+  void executeLine(const Ground &bounds, State &state, std::size_t lineNumber, const ParsedCommand &decoded,
+                   std::string_view line, int &errorNumber);
+
+  // Debug-log a line and count it if it did not decode; returns whether it can be executed
+  bool checkDecoded(std::size_t lineNumber, const ParsedCommand &decoded, std::string_view line, int &errorNumber);
+  // Log and count a failed command
+  template <typename Ground>
+  void checkResult(const ExecutionResult &result, const Ground &bounds, int &errorNumber);
+  // Same for a command run by a robot of a RobotFleet, the message names the robot
+  void checkFleetResult(const ExecutionResult &result, int &errorNumber);
+  // Same for a command run on all robots of a LockstepEngine, one message per kind of failure
+  void checkLockstepResult(const LockstepResult &result, const ParsedCommand &command, const LockstepEngine &lockstep,
+                           int &errorNumber);
+
   std::unique_ptr<InputReader>     reader;
   std::unique_ptr<CommandFactory>  parser;
   std::unique_ptr<SimulatorGround> ground;
+  Engine                           engine;
+  Optimizations                    optimizations;
+  std::vector<Robot>               starts; // Engine::LOCKSTEP: one robot per start, none = a single unplaced robot
+  CommandExecutor                  executor;
+  BytecodeVM                       vm;
   Robot                            robot;
   Logger                          &logger;
 };
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Bytecode.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Executes runs of MOVE/LEFT/RIGHT in closed form
+//
+// A segment is a maximal stretch of movement instructions between PLACE, REPORT
+// and failing lines. Its path is summarised once, in the frame of the direction
+// the robot faces on entry: net displacement, net rotation and the bounding box of
+// every cell it visits. At run time a placed robot whose rotated and translated
+// box fits the ground, clear of obstacles, takes the whole segment in O(1).
+// Otherwise the segment is walked one leg at a time, each leg clamped at the edge
+// or the first obstacle, so the cost follows the number of direction changes, not
+// the number of moves. REPORT output, error counts and error messages match
+// the step-by-step engine.
+//
+// The program should have been through Program::fuseRuns(), so each leg is a
+// single MOVE_N/TURN instruction.
+class SegmentEngine {
+public:
+  explicit SegmentEngine(const Program &program);
+
+  // Run the program on `robot`, returns the number of failed lines
+  int run(Robot &robot, const SimulatorGround &ground) const;
+
+  std::size_t segmentCount() const {
+    return segments.size();
+  }
+
+private:
+  struct Segment {
+    std::size_t   begin      = 0; // Instruction range [begin, end) in Program::instructions()
+    std::size_t   end        = 0;
+    std::uint64_t lines      = 0;
+    std::int64_t  netForward = 0; // Displacement, in cells ahead of and to the right of the entry direction
+    std::int64_t  netRight   = 0;
+    std::int64_t  minForward = 0; // Bounding box of the path in the same frame
+    std::int64_t  maxForward = 0;
+    std::int64_t  minRight   = 0;
+    std::int64_t  maxRight   = 0;
+    unsigned      netTurns   = 0; // Quarter turns to the right
+  };
+
+  struct State {
+    bool       placed    = false;
+    Coordinate x         = 0;
+    Coordinate y         = 0;
+    unsigned   direction = 0;
+  };
+
+  void runSegment(const Segment &segment, State &state, const SimulatorGround &ground, int &errors) const;
+  void walkSegment(const Segment &segment, State &state, const SimulatorGround &ground, int &errors) const;
+
+  // `count` lines failed starting at `line` (0-based), all seeing `state`
+  void fail(std::size_t line, std::uint64_t count, const State &state, const SimulatorGround &ground,
+            int &errors) const;
+
+  const Program       &program;
+  std::vector<Segment> segments; // In program order
+  BytecodeVM           vm;       // Error message replay
+  Logger              &logger;
+  OutputSink          &output;
+};
+
+} // namespace simulator
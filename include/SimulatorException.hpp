@@ -22,6 +22,9 @@ private:
 class FileException : public SimulatorException {
 public:
   explicit FileException(const std::string &filename) : SimulatorException("Cannot open or read file: " + filename) {}
+
+  FileException(const std::string &filename, const std::string &reason)
+    : SimulatorException("Cannot open or read file: " + filename + " (" + reason + ")") {}
 };
 
 class ParseException : public SimulatorException {
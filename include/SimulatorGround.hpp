@@ -1,5 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ObstacleMap.hpp"
 #include "Position.hpp"
 #include "SimulatorException.hpp"
 
@@ -7,28 +16,115 @@ namespace simulator {
 
 class SimulatorGround {
 public:
-  SimulatorGround(int rows, int cols) : maxRows(rows), maxCols(cols) {
+  // Grounds of up to this many cells track occupancy in a dense byte grid, larger ones in a hash set
+  static constexpr std::size_t DENSE_OCCUPANCY_CELLS = std::size_t{1} << 24;
+
+  SimulatorGround(Coordinate rows, Coordinate cols) : maxRows(rows), maxCols(cols) {
 
     if (rows <= 0 || cols <= 0) {
       throw InvalidInputException("Simulator Ground dimensions must be positive");
     }
+    if (rows > MAX_GROUND_SIDE || cols > MAX_GROUND_SIDE) {
+      throw InvalidInputException("Simulator Ground sides must be at most 2^40 cells");
+    }
   }
 
+  // On the ground and not blocked: a bounds check, then one bit test when there are obstacles
   bool isValidPosition(const Position &pos) const {
+    return isInside(pos) && (obstacles == nullptr || !obstacles->isBlocked(pos));
+  }
+
+  // Within the ground's bounds, obstacles or not
+  bool isInside(const Position &pos) const {
     return pos.x >= 0 && pos.x < maxCols && pos.y >= 0 && pos.y < maxRows;
   }
 
-  int getRows() const {
+  // Share a read-only obstacle map of the same size as the ground (nullptr removes it)
+  void setObstacles(std::shared_ptr<const ObstacleMap> map) {
+    if (map != nullptr && (map->getRows() != maxRows || map->getCols() != maxCols)) {
+      throw InvalidInputException("Obstacle map of " + std::to_string(map->getCols()) + "x" +
+                                  std::to_string(map->getRows()) + " does not match the " + std::to_string(maxCols) +
+                                  "x" + std::to_string(maxRows) + " ground");
+    }
+    obstacleMap = std::move(map);
+    obstacles   = obstacleMap.get();
+  }
+
+  // nullptr when every cell is free
+  const ObstacleMap *getObstacles() const {
+    return obstacles;
+  }
+
+  bool hasObstacles() const {
+    return obstacles != nullptr;
+  }
+
+  Coordinate getRows() const {
     return maxRows;
   }
 
-  int getCols() const {
+  Coordinate getCols() const {
     return maxCols;
   }
 
+  // Occupancy for multi-robot runs, only kept after trackOccupancy(): one byte per cell on
+  // small grounds, a hash set of the occupied cells on large ones, so memory follows the
+  // number of robots rather than the area. The cell checks expect valid positions and are O(1).
+  void trackOccupancy() {
+    tracking = true;
+    occupiedCells.clear();
+    occupancy.clear();
+    if (static_cast<double>(maxRows) * static_cast<double>(maxCols) <= static_cast<double>(DENSE_OCCUPANCY_CELLS)) {
+      occupancy.assign(static_cast<std::size_t>(maxRows) * static_cast<std::size_t>(maxCols), 0);
+    }
+  }
+
+  void clearOccupancy() {
+    tracking = false;
+    occupancy.clear();
+    occupancy.shrink_to_fit();
+    occupiedCells.clear();
+  }
+
+  bool tracksOccupancy() const {
+    return tracking;
+  }
+
+  bool isOccupied(const Position &pos) const {
+    if (!tracking) {
+      return false;
+    }
+    return occupancy.empty() ? occupiedCells.count(pos) != 0 : occupancy[cell(pos)] != 0;
+  }
+
+  void occupy(const Position &pos) {
+    if (occupancy.empty()) {
+      occupiedCells.insert(pos);
+    } else {
+      occupancy[cell(pos)] = 1;
+    }
+  }
+
+  void vacate(const Position &pos) {
+    if (occupancy.empty()) {
+      occupiedCells.erase(pos);
+    } else {
+      occupancy[cell(pos)] = 0;
+    }
+  }
+
 private:
-  int maxRows;
-  int maxCols;
+  std::size_t cell(const Position &pos) const {
+    return static_cast<std::size_t>(pos.y) * static_cast<std::size_t>(maxCols) + static_cast<std::size_t>(pos.x);
+  }
+
+  Coordinate                                 maxRows;
+  Coordinate                                 maxCols;
+  std::shared_ptr<const ObstacleMap>         obstacleMap;
+  const ObstacleMap                         *obstacles = nullptr; // obstacleMap.get(), without the indirection
+  bool                                       tracking  = false;
+  std::vector<std::uint8_t>                  occupancy;           // Dense occupancy, empty on large grounds
+  std::unordered_set<Position, PositionHash> occupiedCells;       // Sparse occupancy
 };
 
 } // namespace simulator
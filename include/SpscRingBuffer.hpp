@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+// Bounded lock-free single-producer/single-consumer ring buffer
+//
+// Slots are preallocated and reused in place: the producer fills the slot returned
+// by producerSlot() and publishes it with push(), the consumer reads front() and
+// releases it with pop(). Reusing slots lets element types such as std::string keep
+// their capacity, so the steady state does not allocate.
+template <typename T>
+class SpscRingBuffer {
+public:
+  // `capacity` must be a power of two
+  explicit SpscRingBuffer(std::size_t capacity) : slots(capacity), mask(capacity - 1) {
+    if (capacity == 0 || (capacity & mask) != 0) {
+      throw InvalidInputException("Ring buffer capacity must be a power of two");
+    }
+  }
+
+  SpscRingBuffer(const SpscRingBuffer &)            = delete;
+  SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+  // Producer side: slot to fill next, or nullptr if the buffer is full
+  T *producerSlot() {
+    const std::size_t tail = writeIndex.load(std::memory_order_relaxed);
+    if (tail - cachedReadIndex == slots.size()) {
+      cachedReadIndex = readIndex.load(std::memory_order_acquire);
+      if (tail - cachedReadIndex == slots.size()) {
+        return nullptr;
+      }
+    }
+    return &slots[tail & mask];
+  }
+
+  // Producer side: publish the slot returned by producerSlot()
+  void push() {
+    writeIndex.store(writeIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Consumer side: oldest published slot, or nullptr if the buffer is empty
+  T *front() {
+    const std::size_t head = readIndex.load(std::memory_order_relaxed);
+    if (head == cachedWriteIndex) {
+      cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+      if (head == cachedWriteIndex) {
+        return nullptr;
+      }
+    }
+    return &slots[head & mask];
+  }
+
+  // Consumer side: release the slot returned by front()
+  void pop() {
+    readIndex.store(readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Approximate number of published elements (exact when called from either endpoint)
+  std::size_t size() const {
+    return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const {
+    return slots.size();
+  }
+
+private:
+  std::vector<T>    slots;
+  const std::size_t mask;
+
+  // Producer and consumer indices live on separate cache lines to avoid false sharing
+  alignas(64) std::atomic<std::size_t> writeIndex{0};
+  std::size_t cachedReadIndex = 0; // Producer's last view of readIndex
+  alignas(64) std::atomic<std::size_t> readIndex{0};
+  std::size_t cachedWriteIndex = 0; // Consumer's last view of writeIndex
+};
+
+} // namespace simulator
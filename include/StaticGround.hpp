@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+
+#include "Position.hpp"
+
+namespace simulator {
+
+// Ground whose size is fixed at compile time
+//
+// Same interface as SimulatorGround, but the bounds are immediates: a bounds check
+// compiles to two unsigned compares against constants, with no load from the object.
+// Static grounds have no obstacles.
+template <int Rows, int Cols>
+class StaticGround {
+  static_assert(Rows > 0 && Cols > 0, "Simulator Ground dimensions must be positive");
+
+public:
+  static bool isValidPosition(const Position &pos) {
+    // Negative coordinates wrap to large unsigned values, so one compare covers both ends
+    return static_cast<std::uint64_t>(pos.x) < static_cast<std::uint64_t>(Cols) &&
+           static_cast<std::uint64_t>(pos.y) < static_cast<std::uint64_t>(Rows);
+  }
+
+  static bool isInside(const Position &pos) {
+    return isValidPosition(pos);
+  }
+
+  static constexpr bool hasObstacles() {
+    return false;
+  }
+
+  static constexpr int getRows() {
+    return Rows;
+  }
+
+  static constexpr int getCols() {
+    return Cols;
+  }
+};
+
+// Sizes with a pre-instantiated executor; any other size runs on the dynamic SimulatorGround
+using StaticGrounds = std::tuple<StaticGround<5, 5>, StaticGround<8, 8>, StaticGround<10, 10>, StaticGround<16, 16>,
+                                 StaticGround<32, 32>, StaticGround<64, 64>, StaticGround<100, 100>>;
+
+namespace detail {
+
+template <typename Fn, typename... Grounds>
+bool withStaticGround(Coordinate rows, Coordinate cols, Fn &fn, const std::tuple<Grounds...> *) {
+  return ((rows == Grounds::getRows() && cols == Grounds::getCols() && (fn(Grounds()), true)) || ...);
+}
+
+} // namespace detail
+
+// Call `fn` with the StaticGrounds entry of size rows x cols; returns false if there is none
+template <typename Fn>
+bool withStaticGround(Coordinate rows, Coordinate cols, Fn &&fn) {
+  return detail::withStaticGround(rows, cols, fn, static_cast<const StaticGrounds *>(nullptr));
+}
+
+} // namespace simulator
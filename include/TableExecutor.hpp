@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CommandExecutor.hpp"
+#include "ExecutionResult.hpp"
+#include "Logger.hpp"
+#include "ParsedCommand.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+namespace simulator {
+
+// Robot state as one integer: cell * 4 + direction, with cell = y * cols + x, or TableExecutor::unplaced()
+using RobotState = std::uint32_t;
+
+// Executes decoded commands with precomputed state transitions
+//
+// On a small ground the whole state space is rows * cols * 4 placed states plus
+// one unplaced state. The constructor builds a flat state x opcode table of
+// (next state, error), so MOVE, LEFT, RIGHT and invalid commands are a single
+// lookup, with no branch on direction and no bounds check. PLACE and REPORT
+// need their operand or produce output, and go through CommandExecutor, as does
+// everything while info logging is enabled. Obstacles are folded into the table
+// when it is built. Results, output and error messages match CommandExecutor.
+class TableExecutor {
+public:
+  // Largest ground, in cells, built by default (about 200 KB of table)
+  static constexpr std::size_t DEFAULT_MAX_CELLS = 1024;
+
+  // Throws InvalidInputException when the ground has more than `maxCells` cells
+  explicit TableExecutor(const SimulatorGround &ground, std::size_t maxCells = DEFAULT_MAX_CELLS);
+
+  static bool fits(const SimulatorGround &ground, std::size_t maxCells = DEFAULT_MAX_CELLS) {
+    // Divide rather than multiply: rows * cols overflows on the largest grounds
+    return static_cast<std::size_t>(ground.getRows()) <= maxCells / static_cast<std::size_t>(ground.getCols());
+  }
+
+  // Same contract as CommandExecutor::tryExecute(), on an encoded robot state
+  ExecutionResult tryExecute(const ParsedCommand &command, RobotState &state, std::size_t line = 0) const;
+
+  RobotState unplaced() const {
+    return unplacedState;
+  }
+
+  RobotState encode(const Robot &robot) const;
+  Robot      decode(RobotState state) const;
+
+  std::size_t stateCount() const {
+    return static_cast<std::size_t>(unplacedState) + 1;
+  }
+
+private:
+  static constexpr std::size_t OPCODES = static_cast<std::size_t>(Opcode::REPORT) + 1;
+
+  struct Transition {
+    RobotState     next  = 0;
+    ExecutionError error = ExecutionError::NONE;
+  };
+
+  // PLACE, REPORT and logged commands
+  ExecutionResult executeSlow(const ParsedCommand &command, RobotState &state, std::size_t line) const;
+
+  SimulatorGround         ground;
+  RobotState              unplacedState;
+  std::vector<Transition> transitions; // Indexed by state * OPCODES + opcode
+  CommandExecutor         executor;
+  Logger                 &logger;
+};
+
+inline ExecutionResult TableExecutor::tryExecute(const ParsedCommand &command, RobotState &state,
+                                                 std::size_t line) const {
+  if (command.opcode == Opcode::PLACE || command.opcode == Opcode::REPORT || logger.isEnabled(LogLevel::INFO)) {
+    return executeSlow(command, state, line);
+  }
+
+  const Transition &transition = transitions[state * OPCODES + static_cast<std::size_t>(command.opcode)];
+
+  ExecutionResult result;
+  result.opcode = command.opcode;
+  result.line   = line;
+  result.error  = transition.error;
+  if (transition.error == ExecutionError::MOVE_OUT_OF_BOUNDS || transition.error == ExecutionError::OBSTACLE) {
+    result.position = decode(state).calculateNextPosition();
+  }
+
+  state = transition.next;
+  return result;
+}
+
+} // namespace simulator
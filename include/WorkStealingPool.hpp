@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace simulator {
+
+// Runs a batch of independent jobs on all cores
+//
+// Job indices are dealt to the workers in contiguous blocks, so each worker
+// runs its block front to back. A worker whose block is used up steals the back
+// half of another worker's remaining block, which evens out jobs of very
+// different cost without a shared queue every worker would contend on. Blocks
+// are plain index ranges, so a batch of any size needs no per-job memory.
+//
+// Workers are started by run() (the calling thread is one of them) and joined
+// before it returns.
+class WorkStealingPool {
+public:
+  // `threads` == 0 uses one worker per hardware thread
+  explicit WorkStealingPool(unsigned threads = 0);
+
+  // Call job(index) for every index in [0, count) and wait for all of them. If a job
+  // throws, the remaining jobs are skipped and the first exception is rethrown.
+  void run(std::size_t count, const std::function<void(std::size_t)> &job);
+
+  unsigned getThreadCount() const {
+    return threadCount;
+  }
+
+  // Blocks taken from another worker during the last run()
+  std::uint64_t getSteals() const {
+    return steals.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Remaining job indices [begin, end) of one worker; the owner takes from the front, thieves from the back
+  struct alignas(64) Block {
+    std::mutex  mutex;
+    std::size_t begin = 0;
+    std::size_t end   = 0;
+  };
+
+  void worker(unsigned self, const std::function<void(std::size_t)> &job);
+  bool take(unsigned self, std::size_t &index);
+  bool steal(unsigned self, std::size_t &index);
+
+  unsigned                            threadCount;
+  std::vector<std::unique_ptr<Block>> blocks;
+  std::atomic<bool>                   failed{false};
+  std::atomic<std::uint64_t>          steals{0};
+  std::mutex                          errorMutex;
+  std::exception_ptr                  error;
+};
+
+} // namespace simulator
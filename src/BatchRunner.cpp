@@ -0,0 +1,147 @@
+#include "BatchRunner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#include "BinaryScript.hpp"
+#include "CommandFactory.hpp"
+#include "CompressedFileReader.hpp"
+#include "FileReader.hpp"
+#include "MappedFileReader.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+#include "SimulatorGround.hpp"
+#include "WorkStealingPool.hpp"
+#include "utils.hpp"
+
+namespace simulator {
+
+namespace fs = std::filesystem;
+
+BatchRunner::BatchRunner(Engine executionEngine, Optimizations programOptimizations, IoMode inputMode,
+                         unsigned threads, Coordinate groundRows, Coordinate groundCols)
+  : engine(executionEngine)
+  , optimizations(programOptimizations)
+  , ioMode(inputMode)
+  , threadCount(threads)
+  , rows(groundRows)
+  , cols(groundCols)
+  , logger(Logger::getInstance())
+  , output(OutputSink::getInstance()) {}
+
+void BatchRunner::setObstacles(std::shared_ptr<const ObstacleMap> map) {
+  if (map != nullptr) {
+    rows = map->getRows();
+    cols = map->getCols();
+  }
+  obstacles = std::move(map);
+}
+
+std::vector<std::string> BatchRunner::collectScripts(const std::string &path) {
+  std::vector<std::string> scripts;
+  std::error_code          error;
+
+  if (fs::is_directory(path, error)) {
+    for (const fs::directory_entry &entry : fs::directory_iterator(path, error)) {
+      if (entry.is_regular_file(error)) {
+        scripts.push_back(entry.path().string());
+      }
+    }
+    if (error) {
+      throw FileException(path, error.message());
+    }
+    std::sort(scripts.begin(), scripts.end());
+    return scripts;
+  }
+
+  std::ifstream manifest(path);
+  if (!manifest.is_open()) {
+    throw FileException(path, "not a directory or a readable manifest");
+  }
+
+  fs::path    base = fs::path(path).parent_path();
+  std::string line;
+  while (std::getline(manifest, line)) {
+    std::string entry = trim(line);
+    if (entry.empty() || entry[0] == '#') {
+      continue;
+    }
+    fs::path script(entry);
+    scripts.push_back(script.is_absolute() ? entry : (base / script).string());
+  }
+  return scripts;
+}
+
+std::unique_ptr<InputReader> BatchRunner::openScript(const std::string &path, IoMode mode) {
+  if (BinaryScriptReader::isBinaryScript(path)) {
+    return std::make_unique<BinaryScriptReader>(path);
+  }
+  if (CompressedFileReader::detect(path) != Compression::NONE) {
+    return std::make_unique<CompressedFileReader>(path);
+  }
+  if (mode == IoMode::MMAP) {
+    return std::make_unique<MappedFileReader>(path);
+  }
+  return std::make_unique<FileReader>(path);
+}
+
+BatchStats BatchRunner::run(const std::vector<std::string> &scripts) {
+  WorkStealingPool pool(threadCount);
+  BatchStats       stats;
+  stats.scripts = scripts.size();
+  stats.threads = pool.getThreadCount();
+
+  // Finished captures wait here until every earlier script has been written
+  std::vector<std::string> captures(scripts.size());
+  std::vector<char>        finished(scripts.size(), 0);
+  std::size_t              nextToWrite = 0;
+  std::mutex               writeMutex;
+  bool                     text = output.getFormat() == OutputFormat::TEXT;
+
+  pool.run(scripts.size(), [&](std::size_t index) {
+    std::string capture;
+    bool        ok = true;
+    {
+      OutputSink::Capture redirect(capture);
+      if (text) {
+        output.print("== " + scripts[index] + " ==\n");
+      }
+      ok = runScript(scripts[index]);
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    captures[index] = std::move(capture);
+    finished[index] = 1;
+    stats.failed += ok ? 0 : 1;
+    while (nextToWrite < scripts.size() && finished[nextToWrite] != 0) {
+      output.write(captures[nextToWrite]);
+      std::string().swap(captures[nextToWrite]);
+      ++nextToWrite;
+    }
+  });
+
+  output.flush();
+  stats.steals = pool.getSteals();
+  return stats;
+}
+
+bool BatchRunner::runScript(const std::string &path) const {
+  try {
+    auto ground = std::make_unique<SimulatorGround>(rows, cols);
+    ground->setObstacles(obstacles);
+
+    RobotSimulator simulator(openScript(path, ioMode), std::make_unique<CommandFactory>(), std::move(ground), engine,
+                             optimizations);
+    simulator.run();
+    return true;
+  } catch (const SimulatorException &e) {
+    if (logger.isEnabled(LogLevel::ERROR)) {
+      logger.error("Cannot run script " + path + ": " + e.what());
+    }
+    return false;
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,285 @@
+
+#include "BinaryScript.hpp"
+
+#include <cstring>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+namespace {
+
+constexpr std::size_t   WRITE_BUFFER_SIZE = std::size_t(1) << 20;
+constexpr std::size_t   RELEASE_WINDOW    = std::size_t(64) << 20;
+constexpr std::uint64_t FNV_OFFSET        = 14695981039346656037ULL;
+constexpr std::uint64_t FNV_PRIME         = 1099511628211ULL;
+
+std::uint64_t fnv1a(const char *data, std::size_t size, std::uint64_t hash) {
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+void putLittleEndian(char *out, std::uint64_t value, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+std::uint64_t getLittleEndian(const char *in, std::size_t bytes) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < bytes; ++i) {
+    value |= std::uint64_t(static_cast<unsigned char>(in[i])) << (8 * i);
+  }
+  return value;
+}
+
+void putVarint(std::vector<char> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+// Zigzag keeps small negative coordinates small
+std::uint64_t zigzag(Coordinate value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+Coordinate unzigzag(std::uint64_t value) {
+  return static_cast<Coordinate>(value >> 1) ^ -static_cast<Coordinate>(value & 1);
+}
+
+} // namespace
+
+// ---- Writer ----
+
+BinaryScriptWriter::BinaryScriptWriter(const std::string &path)
+  : filepath(path)
+  , file(path, std::ios::binary | std::ios::trunc)
+  , checksum(FNV_OFFSET) {
+
+  if (!file.is_open()) {
+    throw FileException(filepath);
+  }
+
+  // Placeholder, the real header is written by finish()
+  char header[rbc::HEADER_SIZE] = {};
+  file.write(header, sizeof(header));
+  buffer.reserve(WRITE_BUFFER_SIZE);
+}
+
+void BinaryScriptWriter::write(const ParsedCommand &command, std::string_view line) {
+  const auto opcode = static_cast<std::uint8_t>(command.opcode);
+
+  if (!command.ok()) {
+    buffer.push_back(static_cast<char>(Opcode::INVALID));
+    buffer.push_back(static_cast<char>(command.error));
+    putVarint(buffer, line.size());
+    buffer.insert(buffer.end(), line.begin(), line.end());
+  } else if (command.opcode == Opcode::PLACE) {
+    buffer.push_back(static_cast<char>(opcode | (static_cast<std::uint8_t>(command.direction) << 4)));
+    putVarint(buffer, zigzag(command.position.x));
+    putVarint(buffer, zigzag(command.position.y));
+  } else {
+    buffer.push_back(static_cast<char>(opcode));
+  }
+
+  ++recordCount;
+  if (buffer.size() >= WRITE_BUFFER_SIZE) {
+    flush();
+  }
+}
+
+void BinaryScriptWriter::flush() {
+  checksum = fnv1a(buffer.data(), buffer.size(), checksum);
+  payloadSize += buffer.size();
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  buffer.clear();
+}
+
+void BinaryScriptWriter::finish() {
+  flush();
+
+  char header[rbc::HEADER_SIZE] = {};
+  std::memcpy(header, rbc::MAGIC, sizeof(rbc::MAGIC));
+  putLittleEndian(header + 4, rbc::VERSION, 2);
+  putLittleEndian(header + 6, rbc::HEADER_SIZE, 2);
+  putLittleEndian(header + 8, recordCount, 8);
+  putLittleEndian(header + 16, payloadSize, 8);
+  putLittleEndian(header + 24, checksum, 8);
+
+  file.seekp(0);
+  file.write(header, sizeof(header));
+  file.close();
+
+  if (file.fail()) {
+    throw FileException(filepath, "write failed");
+  }
+}
+
+std::uint64_t compileScript(InputReader &reader, const CommandFactory &factory, const std::string &outputPath) {
+  BinaryScriptWriter writer(outputPath);
+
+  ParsedCommand    command;
+  std::string_view line;
+  while (reader.nextCommand(factory, command, line)) {
+    writer.write(command, line);
+  }
+
+  writer.finish();
+  return writer.getRecordCount();
+}
+
+// ---- Reader ----
+
+bool BinaryScriptReader::isBinaryScript(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  char          magic[sizeof(rbc::MAGIC)] = {};
+
+  return file.read(magic, sizeof(magic)) && std::memcmp(magic, rbc::MAGIC, sizeof(magic)) == 0;
+}
+
+void BinaryScriptReader::open() {
+  file = std::make_unique<MappedFile>(filepath);
+
+  const char *data = file->data();
+  if (file->size() < rbc::HEADER_SIZE || std::memcmp(data, rbc::MAGIC, sizeof(rbc::MAGIC)) != 0) {
+    throw FileException(filepath, "not a compiled .rbc script");
+  }
+
+  auto version = getLittleEndian(data + 4, 2);
+  if (version != rbc::VERSION) {
+    throw FileException(filepath, "unsupported .rbc version " + std::to_string(version) + ", expected " +
+                                      std::to_string(rbc::VERSION) + "; recompile the script");
+  }
+
+  auto headerSize  = getLittleEndian(data + 6, 2);
+  auto payloadSize = getLittleEndian(data + 16, 8);
+  if (headerSize != rbc::HEADER_SIZE || payloadSize != file->size() - rbc::HEADER_SIZE) {
+    throw FileException(filepath, "truncated or corrupt .rbc script");
+  }
+
+  if (fnv1a(data + rbc::HEADER_SIZE, payloadSize, FNV_OFFSET) != getLittleEndian(data + 24, 8)) {
+    throw FileException(filepath, "checksum mismatch in .rbc script");
+  }
+
+  recordCount = getLittleEndian(data + 8, 8);
+  offset      = rbc::HEADER_SIZE;
+  end         = file->size();
+}
+
+bool BinaryScriptReader::decodeRecord(ParsedCommand &command, std::string_view &text) {
+  if (!file) {
+    open();
+  }
+
+  if (recordsRead == recordCount) {
+    return false;
+  }
+
+  if (offset - releaseMark >= RELEASE_WINDOW) {
+    file->releaseBefore(offset);
+    releaseMark = offset;
+  }
+
+  const char *data    = file->data();
+  auto        corrupt = [this]() { return FileException(filepath, "corrupt record in .rbc script"); };
+  auto        varint  = [&]() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (offset >= end) {
+        throw corrupt();
+      }
+      auto byte = static_cast<unsigned char>(data[offset++]);
+      if (shift == 63 && byte > 1) { // The 10th byte holds only bit 63
+        throw corrupt();
+      }
+      value |= std::uint64_t(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw corrupt();
+  };
+
+  if (offset >= end) {
+    throw corrupt();
+  }
+
+  const auto tag = static_cast<std::uint8_t>(data[offset++]);
+  command        = ParsedCommand();
+  command.opcode = static_cast<Opcode>(tag & 0x0F);
+  text           = {};
+
+  // Only PLACE packs a direction into the upper nibble
+  if (command.opcode != Opcode::PLACE && (tag >> 4) != 0) {
+    throw corrupt();
+  }
+
+  switch (command.opcode) {
+  case Opcode::INVALID: {
+    if (offset >= end) {
+      throw corrupt();
+    }
+    const auto error = static_cast<std::uint8_t>(data[offset++]);
+    if (error == static_cast<std::uint8_t>(ParseError::NONE) ||
+        error > static_cast<std::uint8_t>(ParseError::UNKNOWN_COMMAND)) {
+      throw corrupt();
+    }
+    command.error      = static_cast<ParseError>(error);
+    std::size_t length = varint();
+    if (length > end - offset) {
+      throw corrupt();
+    }
+    text = std::string_view(data + offset, length);
+    offset += length;
+    break;
+  }
+  case Opcode::PLACE: {
+    if ((tag >> 4) > static_cast<std::uint8_t>(Direction::WEST)) {
+      throw corrupt();
+    }
+    command.direction = static_cast<Direction>(tag >> 4);
+    Coordinate x      = unzigzag(varint());
+    Coordinate y      = unzigzag(varint());
+    command.position  = Position(x, y);
+    break;
+  }
+  case Opcode::MOVE:
+  case Opcode::LEFT:
+  case Opcode::RIGHT:
+  case Opcode::REPORT:
+    break;
+  default:
+    throw corrupt();
+  }
+
+  ++recordsRead;
+  return true;
+}
+
+bool BinaryScriptReader::nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) {
+  UNUSED(factory); // Records are already decoded
+
+  return decodeRecord(command, line);
+}
+
+bool BinaryScriptReader::nextLine(std::string_view &line) {
+  ParsedCommand command;
+  if (!decodeRecord(command, line)) {
+    return false;
+  }
+
+  if (command.ok()) {
+    textBuffer = toString(command);
+    line       = textBuffer;
+  }
+
+  return true;
+}
+
+} // namespace simulator
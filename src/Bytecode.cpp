@@ -0,0 +1,484 @@
+#include "Bytecode.hpp"
+
+#include <algorithm>
+
+namespace simulator {
+
+namespace {
+
+static_assert(static_cast<int>(VmOp::PLACE) == static_cast<int>(Opcode::PLACE) &&
+                  static_cast<int>(VmOp::REPORT) == static_cast<int>(Opcode::REPORT),
+              "VmOp and Opcode must number commands the same way");
+
+// Robot state as the optimizer tracks it while walking the program
+struct StaticState {
+  bool       placed    = false;
+  Coordinate x         = 0;
+  Coordinate y         = 0;
+  unsigned   direction = 0;
+};
+
+// Apply one per-line instruction to `state`; returns false if the line fails
+bool stepStatic(const Instruction &instruction, StaticState &state, const SimulatorGround &ground) {
+  switch (instruction.op) {
+  case VmOp::PLACE:
+    if (!ground.isValidPosition(Position(instruction.x, instruction.y))) {
+      return false;
+    }
+    state = StaticState{true, instruction.x, instruction.y, instruction.direction};
+    return true;
+  case VmOp::MOVE: {
+    Position next(state.x + DELTA_X[state.direction], state.y + DELTA_Y[state.direction]);
+    if (!state.placed || !ground.isValidPosition(next)) {
+      return false;
+    }
+    state.x = next.x;
+    state.y = next.y;
+    return true;
+  }
+  case VmOp::LEFT:
+  case VmOp::RIGHT:
+    if (!state.placed) {
+      return false;
+    }
+    state.direction = (state.direction + (instruction.op == VmOp::RIGHT ? 1 : 3)) & 3;
+    return true;
+  case VmOp::REPORT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+ParsedCommand Program::command(std::size_t index) const {
+  const Instruction &instruction = code[index];
+
+  if (instruction.op == VmOp::PARSE_ERROR) {
+    return failures[instruction.operand].command;
+  }
+
+  ParsedCommand command;
+  if (instruction.op != VmOp::HALT) {
+    command.opcode = static_cast<Opcode>(instruction.op);
+  }
+  if (instruction.op == VmOp::PLACE) {
+    command.direction = static_cast<Direction>(instruction.direction);
+    command.position  = Position(instruction.x, instruction.y);
+  }
+  return command;
+}
+
+std::string_view Program::source(std::size_t index) const {
+  const Instruction &instruction = code[index];
+  return instruction.op == VmOp::PARSE_ERROR ? std::string_view(failures[instruction.operand].text)
+                                             : std::string_view();
+}
+
+std::size_t Program::fuseRuns() {
+  const std::vector<Instruction> &input = instructions();
+
+  std::vector<Instruction> fused;
+  std::vector<std::size_t> fusedLines;
+  fused.reserve(input.size());
+  fusedLines.reserve(input.size());
+
+  for (std::size_t pc = 0; pc < input.size();) {
+    const Instruction &first    = input[pc];
+    const std::size_t  line     = lineOf(pc);
+    const bool         rotation = first.op == VmOp::LEFT || first.op == VmOp::RIGHT;
+
+    if (first.op != VmOp::MOVE && !rotation) {
+      fused.push_back(first);
+      fusedLines.push_back(line);
+      ++pc;
+      continue;
+    }
+
+    // Extend the run over directly following lines of the same kind
+    std::uint32_t count = 0;
+    unsigned      turns = 0;
+    for (; pc < input.size() && count < UINT32_MAX && lineOf(pc) == line + count; ++pc, ++count) {
+      VmOp op = input[pc].op;
+      if (rotation ? (op != VmOp::LEFT && op != VmOp::RIGHT) : op != VmOp::MOVE) {
+        break;
+      }
+      turns += op == VmOp::RIGHT ? 1 : 3;
+    }
+
+    Instruction run = first;
+    if (count > 1) {
+      run.op        = rotation ? VmOp::TURN : VmOp::MOVE_N;
+      run.operand   = count;
+      run.direction = static_cast<std::uint8_t>(rotation ? turns & 3 : 0);
+    }
+    fused.push_back(run);
+    fusedLines.push_back(line);
+  }
+
+  std::size_t removed = input.size() - fused.size();
+  optimized.swap(fused);
+  optimizedLines.swap(fusedLines);
+  return removed;
+}
+
+EliminationStats Program::eliminateDeadCommands(const SimulatorGround &ground, bool keepMessages) {
+  enum class Fate : std::uint8_t {
+    CHANGES_STATE,
+    PLACES,
+    REPORTS,
+    FAILS,
+    DEAD
+  };
+
+  const std::size_t lines = lineCount();
+  std::vector<Fate> fate(lines);
+
+  // Forward: the robot starts unplaced and every operand is a constant, so the state
+  // each line sees (and whether it fails) is known without running the program
+  std::vector<StaticState> failedStates;
+  StaticState              state;
+  for (std::size_t i = 0; i < lines; ++i) {
+    StaticState before = state;
+    if (!stepStatic(code[i], state, ground)) {
+      fate[i] = Fate::FAILS;
+      if (keepMessages) {
+        failedStates.push_back(before);
+      }
+    } else {
+      fate[i] = code[i].op == VmOp::REPORT ? Fate::REPORTS
+                : code[i].op == VmOp::PLACE ? Fate::PLACES
+                                            : Fate::CHANGES_STATE;
+    }
+  }
+
+  // Backward: a state change only matters if a REPORT sees it before a PLACE replaces it
+  bool observed = false;
+  for (std::size_t i = lines; i-- > 0;) {
+    switch (fate[i]) {
+    case Fate::REPORTS:
+      observed = true;
+      break;
+    case Fate::PLACES:
+      fate[i]  = observed ? Fate::PLACES : Fate::DEAD;
+      observed = false;
+      break;
+    case Fate::CHANGES_STATE:
+      fate[i] = observed ? Fate::CHANGES_STATE : Fate::DEAD;
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Rotation runs that cancel out; failing or dead lines in between do not touch the state
+  std::vector<std::size_t> run;
+  unsigned                 turns = 0;
+  for (std::size_t i = 0; i <= lines; ++i) {
+    if (i < lines && (fate[i] == Fate::FAILS || fate[i] == Fate::DEAD)) {
+      continue;
+    }
+    if (i < lines && (code[i].op == VmOp::LEFT || code[i].op == VmOp::RIGHT)) {
+      run.push_back(i);
+      turns += code[i].op == VmOp::RIGHT ? 1U : 3U;
+      continue;
+    }
+    if ((turns & 3) == 0) {
+      for (std::size_t line : run) {
+        fate[line] = Fate::DEAD;
+      }
+    }
+    run.clear();
+    turns = 0;
+  }
+
+  EliminationStats stats;
+  stats.commands = lines;
+
+  std::vector<Instruction> live;
+  std::vector<std::size_t> liveLines;
+  std::size_t              nextFailure = 0;
+  for (std::size_t i = 0; i < lines; ++i) {
+    if (fate[i] == Fate::DEAD) {
+      ++stats.removed;
+      continue;
+    }
+
+    if (fate[i] != Fate::FAILS) {
+      live.push_back(code[i]);
+      liveLines.push_back(i);
+      continue;
+    }
+
+    ++stats.removed;
+    ++stats.failures;
+    if (!keepMessages && !live.empty() && live.back().op == VmOp::FAIL) {
+      ++live.back().operand;
+      continue;
+    }
+
+    Instruction fail;
+    fail.op        = VmOp::FAIL;
+    fail.operand   = 1;
+    fail.direction = Instruction::UNPLACED;
+    if (keepMessages) {
+      const StaticState &seen = failedStates[nextFailure++];
+      if (seen.placed) {
+        fail.direction = static_cast<std::uint8_t>(seen.direction);
+        fail.x         = seen.x;
+        fail.y         = seen.y;
+      }
+    }
+    live.push_back(fail);
+    liveLines.push_back(i);
+  }
+
+  live.push_back(code.back()); // HALT
+  liveLines.push_back(lines);
+
+  optimized.swap(live);
+  optimizedLines.swap(liveLines);
+  return stats;
+}
+
+Robot Program::failedState(const Instruction &instruction) {
+  Robot robot;
+  if (instruction.direction != Instruction::UNPLACED) {
+    robot.place(Position(instruction.x, instruction.y), static_cast<Direction>(instruction.direction));
+  }
+  return robot;
+}
+
+Program compileProgram(InputReader &reader, const CommandFactory &factory) {
+  Program program;
+  program.code.clear();
+
+  std::string_view line;
+  ParsedCommand    command;
+  while (reader.nextCommand(factory, command, line)) {
+    Instruction instruction;
+
+    if (!command.ok()) {
+      instruction.op      = VmOp::PARSE_ERROR;
+      instruction.operand = static_cast<std::uint32_t>(program.failures.size());
+      program.failures.push_back({command, std::string(line)});
+    } else {
+      instruction.op = static_cast<VmOp>(command.opcode);
+      if (command.opcode == Opcode::PLACE) {
+        instruction.direction = static_cast<std::uint8_t>(command.direction);
+        instruction.x         = command.position.x;
+        instruction.y         = command.position.y;
+      }
+    }
+
+    program.code.push_back(instruction);
+  }
+
+  program.code.emplace_back(); // HALT
+  return program;
+}
+
+void BytecodeVM::logFailure(const Program &program, std::size_t line, const Robot &robot,
+                            const SimulatorGround &ground) const {
+  ParsedCommand command    = program.command(line);
+  std::string   lineNumber = std::to_string(line + 1);
+
+  if (!command.ok()) {
+    ParseException e(CommandFactory::describe(command, program.source(line)));
+    logger.error("Parse error on line " + lineNumber + ": " + e.what());
+    return;
+  }
+
+  // Replay the failing command on a copy to get the exact message of the step-by-step engine
+  Robot           replay = robot;
+  ExecutionResult result = executor.tryExecute(command, replay, ground, line + 1);
+  if (!result.ok()) {
+    InvalidInputException e(CommandExecutor::describe(result, ground));
+    logger.error("Execution error on line " + lineNumber + ": " + e.what());
+  }
+}
+
+// Labels as values are a GNU extension
+#if defined(__GNUC__)
+#define ROBOTSIM_COMPUTED_GOTO 1
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#else
+#define ROBOTSIM_COMPUTED_GOTO 0
+#endif
+
+int BytecodeVM::run(const Program &program, Robot &robot, const SimulatorGround &ground) const {
+  const Instruction *const begin = program.instructions().data();
+  const Instruction       *pc    = begin;
+
+  const auto         cols      = static_cast<std::uint64_t>(ground.getCols());
+  const auto         rows      = static_cast<std::uint64_t>(ground.getRows());
+  const ObstacleMap *obstacles = ground.getObstacles();
+
+  bool       placed    = robot.hasPlaced();
+  Coordinate x         = placed ? robot.getPosition().x : 0;
+  Coordinate y         = placed ? robot.getPosition().y : 0;
+  unsigned   direction = placed ? static_cast<unsigned>(robot.getDirection()) : 0;
+  int        errors    = 0;
+
+  const bool logErrors   = logger.isEnabled(LogLevel::ERROR);
+  const bool logWarnings = logger.isEnabled(LogLevel::WARNING);
+
+  auto snapshot = [&] {
+    Robot state;
+    if (placed) {
+      state.place(Position(x, y), static_cast<Direction>(direction));
+    }
+    return state;
+  };
+
+  // `count` lines of the current instruction failed, starting `skip` lines into it
+  auto failLines = [&](std::uint32_t skip, std::uint32_t count) {
+    errors += static_cast<int>(count);
+    if (logErrors) {
+      std::size_t line  = program.lineOf(static_cast<std::size_t>(pc - begin)) + skip;
+      Robot       state = snapshot();
+      for (std::uint32_t i = 0; i < count; ++i) {
+        logFailure(program, line + i, state, ground);
+      }
+    }
+  };
+
+  auto fail = [&] { failLines(0, 1); };
+
+#if ROBOTSIM_COMPUTED_GOTO
+  // Indexed by VmOp
+  static void *const handlers[] = {&&op_HALT,   &&op_PLACE,       &&op_MOVE,   &&op_LEFT, &&op_RIGHT,
+                                   &&op_REPORT, &&op_PARSE_ERROR, &&op_MOVE_N, &&op_TURN, &&op_FAIL};
+
+#define VM_CASE(op) op_##op:
+#define VM_NEXT() goto *handlers[static_cast<std::uint8_t>((++pc)->op)]
+
+  goto *handlers[static_cast<std::uint8_t>(pc->op)];
+  {
+#else
+#define VM_CASE(op) case VmOp::op:
+#define VM_NEXT()                                                                                                      \
+  ++pc;                                                                                                                \
+  continue
+
+  for (;;) {
+    switch (pc->op) {
+#endif
+
+    VM_CASE(PLACE) {
+      if (static_cast<std::uint64_t>(pc->x) < cols && static_cast<std::uint64_t>(pc->y) < rows &&
+          (obstacles == nullptr || !obstacles->isBlocked(Position(pc->x, pc->y)))) {
+        x         = pc->x;
+        y         = pc->y;
+        direction = pc->direction;
+        placed    = true;
+      } else {
+        fail();
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(MOVE) {
+      Coordinate nextX = x + DELTA_X[direction];
+      Coordinate nextY = y + DELTA_Y[direction];
+      if (placed && static_cast<std::uint64_t>(nextX) < cols && static_cast<std::uint64_t>(nextY) < rows &&
+          (obstacles == nullptr || !obstacles->isBlocked(Position(nextX, nextY)))) {
+        x = nextX;
+        y = nextY;
+      } else {
+        fail();
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(LEFT) {
+      if (placed) {
+        direction = (direction + 3) & 3;
+      } else {
+        fail();
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(RIGHT) {
+      if (placed) {
+        direction = (direction + 1) & 3;
+      } else {
+        fail();
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(REPORT) {
+      if (placed) {
+        output.report(program.lineOf(static_cast<std::size_t>(pc - begin)) + 1, Position(x, y),
+                      static_cast<Direction>(direction));
+      } else if (logWarnings) {
+        logger.warning("REPORT command called but robot has not placed");
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(PARSE_ERROR) {
+      fail();
+      VM_NEXT();
+    }
+
+    VM_CASE(MOVE_N) {
+      // Walk as far as the edge or the first obstacle in one step; every MOVE past it fails in place
+      std::uint32_t steps = 0;
+      if (placed) {
+        steps = static_cast<std::uint32_t>(
+          std::min<std::uint64_t>(pc->operand, stepsToEdge(x, y, direction, cols, rows)));
+        if (obstacles != nullptr) {
+          steps = obstacles->freeSteps(x, y, direction, steps);
+        }
+        x += DELTA_X[direction] * static_cast<Coordinate>(steps);
+        y += DELTA_Y[direction] * static_cast<Coordinate>(steps);
+      }
+      if (steps < pc->operand) {
+        failLines(steps, pc->operand - steps);
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(TURN) {
+      if (placed) {
+        direction = (direction + pc->direction) & 3;
+      } else {
+        failLines(0, pc->operand);
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(FAIL) {
+      errors += static_cast<int>(pc->operand);
+      if (logErrors) {
+        logFailure(program, program.lineOf(static_cast<std::size_t>(pc - begin)), Program::failedState(*pc), ground);
+      }
+      VM_NEXT();
+    }
+
+    VM_CASE(HALT) {
+      robot = snapshot();
+      output.flush();
+      return errors;
+    }
+
+#if !ROBOTSIM_COMPUTED_GOTO
+    }
+#endif
+  }
+
+#undef VM_CASE
+#undef VM_NEXT
+}
+
+#if ROBOTSIM_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+#undef ROBOTSIM_COMPUTED_GOTO
+
+} // namespace simulator
@@ -0,0 +1,74 @@
+#include "CachingCommandFactory.hpp"
+
+#include <cstring>
+
+namespace simulator {
+
+namespace {
+
+// FNV-1a; lines are short, so a byte loop is cheaper than anything fancier
+std::uint64_t hashLine(std::string_view line) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (char c : line) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+  std::size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+} // namespace
+
+CachingCommandFactory::CachingCommandFactory(std::size_t capacity)
+  : entries(roundUpToPowerOfTwo(capacity))
+  , mask(entries.size() - 1) {
+  stats.capacity = entries.size();
+}
+
+ParsedCommand CachingCommandFactory::decode(std::string_view input) const noexcept {
+  if (input.size() > MAX_KEY_LENGTH) {
+    ++stats.uncached;
+    return CommandFactory::decode(input);
+  }
+
+  std::uint64_t hash  = hashLine(input);
+  Entry        &entry = entries[static_cast<std::size_t>(hash) & mask];
+
+  if (entry.used && entry.hash == hash && entry.length == input.size() &&
+      std::memcmp(entry.key, input.data(), input.size()) == 0) {
+    ++stats.hits;
+    return entry.command;
+  }
+
+  ++stats.misses;
+  if (entry.used) {
+    ++stats.evictions;
+  }
+
+  entry.command = CommandFactory::decode(input);
+  entry.hash    = hash;
+  entry.length  = static_cast<std::uint8_t>(input.size());
+  entry.used    = true;
+  std::memcpy(entry.key, input.data(), input.size());
+
+  return entry.command;
+}
+
+ParseCacheStats CachingCommandFactory::getStats() const {
+  return stats;
+}
+
+void CachingCommandFactory::clear() {
+  for (Entry &entry : entries) {
+    entry.used = false;
+  }
+}
+
+} // namespace simulator
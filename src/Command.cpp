@@ -6,8 +6,12 @@ namespace simulator {
 void PlaceCommand::execute(Robot &robot, SimulatorGround &ground) {
   if (!ground.isValidPosition(position)) {
     std::ostringstream oss;
-    oss << "Cannot PLACE robot at " << position << ": position out of bounds (ground is " << ground.getCols() << "x"
-        << ground.getRows() << ")";
+    oss << "Cannot PLACE robot at " << position;
+    if (ground.isInside(position)) {
+      oss << ": position blocked by an obstacle";
+    } else {
+      oss << ": position out of bounds (ground is " << ground.getCols() << "x" << ground.getRows() << ")";
+    }
     throw InvalidInputException(oss.str());
   }
 
@@ -31,7 +35,8 @@ void MoveCommand::execute(Robot &robot, SimulatorGround &ground) {
 
   if (!ground.isValidPosition(nextPosition)) {
     std::ostringstream oss;
-    oss << "Cannot move to " << nextPosition << ": position out of bounds";
+    oss << "Cannot move to " << nextPosition
+        << (ground.isInside(nextPosition) ? ": position blocked by an obstacle" : ": position out of bounds");
     throw InvalidInputException(oss.str());
   }
 
@@ -87,10 +92,8 @@ void ReportCommand::execute(Robot &robot, SimulatorGround &ground) {
     return;
   }
 
-  // Execute REPORT command
-  Position  pos = robot.getPosition();
-  Direction dir = robot.getDirection();
-  std::cout << "Output: " << pos << "," << dir << std::endl;
+  // Execute REPORT command (commands do not know their source line)
+  output.report(0, robot.getPosition(), robot.getDirection());
 }
 
 } // namespace simulator
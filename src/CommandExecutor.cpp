@@ -0,0 +1,90 @@
+#include "CommandExecutor.hpp"
+
+#include <sstream>
+
+namespace simulator {
+
+namespace {
+
+const char *commandName(Opcode opcode) {
+  switch (opcode) {
+  case Opcode::MOVE:
+    return "MOVE";
+  case Opcode::LEFT:
+    return "LEFT";
+  default:
+    return "RIGHT";
+  }
+}
+
+} // namespace
+
+void CommandExecutor::execute(const ParsedCommand &command, Robot &robot, const SimulatorGround &ground) const {
+  ExecutionResult result = tryExecute(command, robot, ground);
+  if (!result.ok()) {
+    throw InvalidInputException(describe(result, ground));
+  }
+}
+
+std::string CommandExecutor::describe(const ExecutionResult &result, Coordinate rows, Coordinate cols) {
+  std::ostringstream oss;
+
+  switch (result.error) {
+  case ExecutionError::NOT_PLACED:
+    oss << "Robot must be placed before " << commandName(result.opcode) << " command";
+    break;
+  case ExecutionError::PLACE_OUT_OF_BOUNDS:
+    oss << "Cannot PLACE robot at " << result.position << ": position out of bounds (ground is " << cols << "x"
+        << rows << ")";
+    break;
+  case ExecutionError::MOVE_OUT_OF_BOUNDS:
+    oss << "Cannot move to " << result.position << ": position out of bounds";
+    break;
+  case ExecutionError::INVALID_COMMAND:
+    oss << "Cannot execute an invalid command";
+    break;
+  case ExecutionError::OCCUPIED:
+    oss << (result.opcode == Opcode::PLACE ? "Cannot PLACE robot at " : "Cannot move to ") << result.position
+        << ": position occupied by another robot";
+    break;
+  case ExecutionError::OBSTACLE:
+    oss << (result.opcode == Opcode::PLACE ? "Cannot PLACE robot at " : "Cannot move to ") << result.position
+        << ": position blocked by an obstacle";
+    break;
+  default:
+    break;
+  }
+
+  return oss.str();
+}
+
+void CommandExecutor::logPlaced(const ParsedCommand &command) const {
+  std::ostringstream oss;
+  oss << "robot placed at " << command.position << " facing " << command.direction;
+  logger.info(oss.str());
+}
+
+void CommandExecutor::logMoved(const Robot &robot) const {
+  std::ostringstream oss;
+  oss << "Robot moved to " << robot.getPosition() << " facing " << robot.getDirection();
+  logger.info(oss.str());
+}
+
+void CommandExecutor::logRotated(Opcode opcode, const Robot &robot) const {
+  std::ostringstream oss;
+  oss << "Robot rotated " << commandName(opcode) << ", now facing " << robot.getDirection();
+  logger.info(oss.str());
+}
+
+void CommandExecutor::report(const Robot &robot, std::size_t line) const {
+  if (!robot.hasPlaced()) {
+    if (logger.isEnabled(LogLevel::WARNING)) {
+      logger.warning("REPORT command called but robot has not placed");
+    }
+    return;
+  }
+
+  output.report(line, robot.getPosition(), robot.getDirection());
+}
+
+} // namespace simulator
@@ -1,77 +1,228 @@
 
 #include "CommandFactory.hpp"
 
+#include <array>
+#include <charconv>
+
 namespace simulator {
 
-std::unique_ptr<Command> CommandFactory::parse(const std::string &input) {
-  std::string inputCommand = trim(input);
+namespace {
 
-  if (inputCommand.empty()) {
-    throw ParseException("Empty command");
+// Same character set as trim()
+bool isTrimmed(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string_view trimView(std::string_view input) {
+  std::size_t start = 0;
+  std::size_t end   = input.size();
+  while (start < end && isTrimmed(input[start])) {
+    ++start;
+  }
+  while (end > start && isTrimmed(input[end - 1])) {
+    --end;
   }
+  return input.substr(start, end - start);
+}
 
-  inputCommand = toUpperCase(inputCommand);
+// ASCII-only equivalent of std::toupper in the default "C" locale, without the locale lookup
+char asciiUpper(char c) {
+  return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
 
-  if (inputCommand.find("PLACE") == 0) {
-    return parsePlaceCommand(inputCommand);
-  } else if (inputCommand == "MOVE") {
-    return std::make_unique<MoveCommand>();
-  } else if (inputCommand == "LEFT") {
-    return std::make_unique<LeftCommand>();
-  } else if (inputCommand == "RIGHT") {
-    return std::make_unique<RightCommand>();
-  } else if (inputCommand == "REPORT") {
-    return std::make_unique<ReportCommand>();
-  } else {
-    throw ParseException("Unknown command: " + inputCommand);
+// `keyword` must be upper case
+bool equalsIgnoreCase(std::string_view input, std::string_view keyword) {
+  if (input.size() != keyword.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    if (asciiUpper(input[i]) != keyword[i]) {
+      return false;
+    }
   }
+  return true;
+}
+
+bool startsWithIgnoreCase(std::string_view input, std::string_view keyword) {
+  return input.size() >= keyword.size() && equalsIgnoreCase(input.substr(0, keyword.size()), keyword);
 }
 
-// Format: PLACE <x>,<y>,<FACE-DIRECTION>
-std::unique_ptr<Command> CommandFactory::parsePlaceCommand(const std::string &input) {
+// Split PLACE parameters on ',' with the same token count as split(): a trailing
+// empty token is dropped. Returns the number of tokens, storing at most three.
+std::size_t splitParameters(std::string_view params, std::array<std::string_view, 3> &tokens) {
+  std::size_t count = 0;
+  std::size_t start = 0;
+
+  while (start < params.size()) {
+    std::size_t comma = params.find(',', start);
+    std::size_t end   = comma == std::string_view::npos ? params.size() : comma;
+
+    if (count < tokens.size()) {
+      tokens[count] = params.substr(start, end - start);
+    }
+    ++count;
+
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+
+  return count;
+}
 
-  size_t spacePos = input.find(' '); // Find space after PLACE
-  if (spacePos == std::string::npos) {
-    throw ParseException("PLACE command requires parameters: PLACE <x>,<y>,<FACE-DIRECTION>");
+// Same acceptance rules as std::stoi: leading spaces, optional sign, at least one digit,
+// trailing characters ignored and out-of-range values rejected
+bool parseCoordinate(std::string_view token, Coordinate &value) {
+  std::size_t i = 0;
+  while (i < token.size() && std::isspace(static_cast<unsigned char>(token[i]))) {
+    ++i;
+  }
+  if (i < token.size() && token[i] == '+') {
+    ++i;
+    if (i < token.size() && token[i] == '-') {
+      return false;
+    }
   }
 
-  std::string params = trim(input.substr(spacePos + 1));
-  // Split by comma
-  std::vector<std::string> tokens = split(params, ',');
+  const char *first  = token.data() + i;
+  const char *last   = token.data() + token.size();
+  auto        result = std::from_chars(first, last, value);
+
+  return result.ec == std::errc();
+}
 
-  if (tokens.size() != 3) {
-    throw ParseException("PLACE command requires exactly 3 parameters: x,y,direction");
+bool parseDirection(std::string_view token, Direction &direction) {
+  if (equalsIgnoreCase(token, "NORTH")) {
+    direction = Direction::NORTH;
+  } else if (equalsIgnoreCase(token, "EAST")) {
+    direction = Direction::EAST;
+  } else if (equalsIgnoreCase(token, "SOUTH")) {
+    direction = Direction::SOUTH;
+  } else if (equalsIgnoreCase(token, "WEST")) {
+    direction = Direction::WEST;
+  } else {
+    return false;
   }
+  return true;
+}
 
-  int x, y;
-  try {
-    // Parse x and y
-    x = std::stoi(trim(tokens[0]));
-    y = std::stoi(trim(tokens[1]));
-  } catch (const std::exception &) {
-    throw ParseException("Invalid coordinates in PLACE command");
+// Parameters of a trimmed PLACE line, i.e. everything after the first space
+std::string_view placeParameters(std::string_view command) {
+  std::size_t spacePos = command.find(' ');
+  if (spacePos == std::string_view::npos) {
+    return {};
   }
+  return trimView(command.substr(spacePos + 1));
+}
+
+ParsedCommand failure(ParseError error) {
+  ParsedCommand command;
+  command.error = error;
+  return command;
+}
+
+} // namespace
+
+std::unique_ptr<Command> CommandFactory::parse(const std::string &input) {
+  ParsedCommand command = decode(input);
 
-  // Parse direction
-  Direction dir = parseDirection(trim(tokens[2]));
+  if (!command.ok()) {
+    throw ParseException(describe(command, input));
+  }
 
-  return std::make_unique<PlaceCommand>(Position(x, y), dir);
+  return create(command);
 }
 
-Direction CommandFactory::parseDirection(const std::string &direction) {
-  std::string upper = toUpperCase(direction);
-
-  if (upper == "NORTH") {
-    return Direction::NORTH;
-  } else if (upper == "EAST") {
-    return Direction::EAST;
-  } else if (upper == "SOUTH") {
-    return Direction::SOUTH;
-  } else if (upper == "WEST") {
-    return Direction::WEST;
+// Format: PLACE <x>,<y>,<FACE-DIRECTION> | MOVE | LEFT | RIGHT | REPORT
+ParsedCommand CommandFactory::decode(std::string_view input) const noexcept {
+  std::string_view inputCommand = trimView(input);
+
+  if (inputCommand.empty()) {
+    return failure(ParseError::EMPTY_COMMAND);
+  }
+
+  ParsedCommand command;
+
+  if (startsWithIgnoreCase(inputCommand, "PLACE")) {
+    if (inputCommand.find(' ') == std::string_view::npos) {
+      return failure(ParseError::PLACE_MISSING_PARAMETERS);
+    }
+
+    std::array<std::string_view, 3> tokens;
+    if (splitParameters(placeParameters(inputCommand), tokens) != tokens.size()) {
+      return failure(ParseError::PLACE_PARAMETER_COUNT);
+    }
+
+    Coordinate x = 0;
+    Coordinate y = 0;
+    if (!parseCoordinate(trimView(tokens[0]), x) || !parseCoordinate(trimView(tokens[1]), y)) {
+      return failure(ParseError::INVALID_COORDINATES);
+    }
+
+    if (!parseDirection(trimView(tokens[2]), command.direction)) {
+      return failure(ParseError::INVALID_DIRECTION);
+    }
+
+    command.opcode   = Opcode::PLACE;
+    command.position = Position(x, y);
+  } else if (equalsIgnoreCase(inputCommand, "MOVE")) {
+    command.opcode = Opcode::MOVE;
+  } else if (equalsIgnoreCase(inputCommand, "LEFT")) {
+    command.opcode = Opcode::LEFT;
+  } else if (equalsIgnoreCase(inputCommand, "RIGHT")) {
+    command.opcode = Opcode::RIGHT;
+  } else if (equalsIgnoreCase(inputCommand, "REPORT")) {
+    command.opcode = Opcode::REPORT;
   } else {
-    throw ParseException("Invalid direction: " + direction + ". Must be NORTH, EAST, SOUTH, or WEST");
+    return failure(ParseError::UNKNOWN_COMMAND);
+  }
+
+  return command;
+}
+
+std::unique_ptr<Command> CommandFactory::create(const ParsedCommand &command) const {
+  switch (command.opcode) {
+  case Opcode::PLACE:
+    return std::make_unique<PlaceCommand>(command.position, command.direction);
+  case Opcode::MOVE:
+    return std::make_unique<MoveCommand>();
+  case Opcode::LEFT:
+    return std::make_unique<LeftCommand>();
+  case Opcode::RIGHT:
+    return std::make_unique<RightCommand>();
+  case Opcode::REPORT:
+    return std::make_unique<ReportCommand>();
+  default:
+    throw InvalidInputException("Cannot create a command from a line that failed to parse");
+  }
+}
+
+std::string CommandFactory::describe(const ParsedCommand &command, std::string_view input) {
+  std::string_view inputCommand = trimView(input);
+
+  switch (command.error) {
+  case ParseError::NONE:
+    return "";
+  case ParseError::EMPTY_COMMAND:
+    return "Empty command";
+  case ParseError::PLACE_MISSING_PARAMETERS:
+    return "PLACE command requires parameters: PLACE <x>,<y>,<FACE-DIRECTION>";
+  case ParseError::PLACE_PARAMETER_COUNT:
+    return "PLACE command requires exactly 3 parameters: x,y,direction";
+  case ParseError::INVALID_COORDINATES:
+    return "Invalid coordinates in PLACE command";
+  case ParseError::INVALID_DIRECTION: {
+    std::array<std::string_view, 3> tokens;
+    splitParameters(placeParameters(inputCommand), tokens);
+    return "Invalid direction: " + toUpperCase(std::string(trimView(tokens[2]))) +
+           ". Must be NORTH, EAST, SOUTH, or WEST";
+  }
+  case ParseError::UNKNOWN_COMMAND:
+    return "Unknown command: " + toUpperCase(std::string(inputCommand));
   }
+
+  return "Unknown parse error";
 }
 
 } // namespace simulator
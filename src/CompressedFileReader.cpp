@@ -0,0 +1,327 @@
+
+#include "CompressedFileReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef ROBOTSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ROBOTSIM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+namespace {
+
+constexpr std::size_t INPUT_CHUNK_SIZE = std::size_t(256) << 10;
+
+// Streaming decoder of one compressed file
+class Decompressor {
+public:
+  virtual ~Decompressor() = default;
+
+  // Fill up to `capacity` bytes of `out`; fewer bytes are returned only at end of stream
+  virtual std::size_t read(char *out, std::size_t capacity) = 0;
+};
+
+#ifdef ROBOTSIM_HAVE_ZLIB
+class GzipDecompressor : public Decompressor {
+public:
+  explicit GzipDecompressor(const std::string &path)
+    : filepath(path)
+    , file(path, std::ios::binary)
+    , input(INPUT_CHUNK_SIZE) {
+
+    if (!file.is_open()) {
+      throw FileException(filepath);
+    }
+    // 15 + 32: maximum window size, auto-detect gzip or zlib headers
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+      throw FileException(filepath, "cannot initialise gzip decoder");
+    }
+  }
+
+  ~GzipDecompressor() override {
+    inflateEnd(&stream);
+  }
+
+  std::size_t read(char *out, std::size_t capacity) override {
+    stream.next_out  = reinterpret_cast<Bytef *>(out);
+    stream.avail_out = static_cast<uInt>(capacity);
+
+    while (stream.avail_out > 0) {
+      if (stream.avail_in == 0) {
+        file.read(input.data(), static_cast<std::streamsize>(input.size()));
+        auto count = static_cast<uInt>(file.gcount());
+        if (count == 0) {
+          if (!memberEnded) {
+            throw FileException(filepath, "truncated gzip stream");
+          }
+          break;
+        }
+        stream.next_in  = reinterpret_cast<Bytef *>(input.data());
+        stream.avail_in = count;
+      }
+
+      // More input after a finished member: concatenated gzip files continue here
+      if (memberEnded) {
+        inflateReset(&stream);
+        memberEnded = false;
+      }
+
+      int result = inflate(&stream, Z_NO_FLUSH);
+      if (result == Z_STREAM_END) {
+        memberEnded = true;
+      } else if (result != Z_OK) {
+        throw FileException(filepath, "corrupt gzip stream");
+      }
+    }
+
+    return capacity - stream.avail_out;
+  }
+
+private:
+  std::string       filepath;
+  std::ifstream     file;
+  std::vector<char> input;
+  z_stream          stream{};
+  bool              memberEnded = false;
+};
+#endif
+
+#ifdef ROBOTSIM_HAVE_ZSTD
+class ZstdDecompressor : public Decompressor {
+public:
+  explicit ZstdDecompressor(const std::string &path)
+    : filepath(path)
+    , file(path, std::ios::binary)
+    , input(ZSTD_DStreamInSize())
+    , stream(ZSTD_createDStream()) {
+
+    if (!file.is_open()) {
+      ZSTD_freeDStream(stream);
+      throw FileException(filepath);
+    }
+    if (stream == nullptr || ZSTD_isError(ZSTD_initDStream(stream))) {
+      ZSTD_freeDStream(stream);
+      throw FileException(filepath, "cannot initialise zstd decoder");
+    }
+  }
+
+  ~ZstdDecompressor() override {
+    ZSTD_freeDStream(stream);
+  }
+
+  std::size_t read(char *out, std::size_t capacity) override {
+    ZSTD_outBuffer output{out, capacity, 0};
+
+    while (output.pos < output.size) {
+      if (buffer.pos == buffer.size) {
+        file.read(input.data(), static_cast<std::streamsize>(input.size()));
+        auto count = static_cast<std::size_t>(file.gcount());
+        if (count == 0) {
+          // A non-zero hint means the last frame is incomplete
+          if (lastResult != 0) {
+            throw FileException(filepath, "truncated zstd stream");
+          }
+          break;
+        }
+        buffer = ZSTD_inBuffer{input.data(), count, 0};
+      }
+
+      std::size_t result = ZSTD_decompressStream(stream, &output, &buffer);
+      if (ZSTD_isError(result)) {
+        throw FileException(filepath, std::string("corrupt zstd stream: ") + ZSTD_getErrorName(result));
+      }
+      lastResult = result;
+    }
+
+    return output.pos;
+  }
+
+private:
+  std::string       filepath;
+  std::ifstream     file;
+  std::vector<char> input;
+  ZSTD_DStream     *stream;
+  ZSTD_inBuffer     buffer{nullptr, 0, 0};
+  std::size_t       lastResult = 0;
+};
+#endif
+
+std::unique_ptr<Decompressor> makeDecompressor(const std::string &path) {
+  switch (CompressedFileReader::detect(path)) {
+#ifdef ROBOTSIM_HAVE_ZLIB
+  case Compression::GZIP:
+    return std::make_unique<GzipDecompressor>(path);
+#endif
+#ifdef ROBOTSIM_HAVE_ZSTD
+  case Compression::ZSTD:
+    return std::make_unique<ZstdDecompressor>(path);
+#endif
+  case Compression::NONE:
+    throw FileException(path, "not a gzip or zstd compressed file");
+  default:
+    throw FileException(path, "compression format not supported by this build");
+  }
+}
+
+} // namespace
+
+CompressedFileReader::CompressedFileReader(const std::string path, std::size_t blockSize)
+  : filepath(path)
+  , blockSize(std::max<std::size_t>(1, blockSize))
+  , blocks(QUEUE_DEPTH) {}
+
+CompressedFileReader::~CompressedFileReader() {
+  stop();
+}
+
+Compression CompressedFileReader::detect(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  unsigned char magic[4] = {};
+  file.read(reinterpret_cast<char *>(magic), sizeof(magic));
+  auto count = file.gcount();
+
+  if (count >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+    return Compression::GZIP;
+  }
+  if (count == 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) {
+    return Compression::ZSTD;
+  }
+  return Compression::NONE;
+}
+
+bool CompressedFileReader::isSupported(Compression format) {
+  switch (format) {
+#ifdef ROBOTSIM_HAVE_ZLIB
+  case Compression::GZIP:
+    return true;
+#endif
+#ifdef ROBOTSIM_HAVE_ZSTD
+  case Compression::ZSTD:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+void CompressedFileReader::start() {
+  started       = true;
+  decoderThread = std::thread(&CompressedFileReader::decodeLoop, this);
+}
+
+void CompressedFileReader::stop() {
+  stopping.store(true, std::memory_order_relaxed);
+  blockFree.notify();
+  if (decoderThread.joinable()) {
+    decoderThread.join();
+  }
+}
+
+void CompressedFileReader::decodeLoop() {
+  try {
+    auto decompressor = makeDecompressor(filepath);
+
+    for (;;) {
+      Block *slot = nullptr;
+      blockFree.wait([&]() {
+        return (slot = blocks.producerSlot()) != nullptr || stopping.load(std::memory_order_relaxed);
+      });
+      if (slot == nullptr) {
+        return;
+      }
+
+      // Buffers are allocated once per slot and reused for the rest of the stream
+      slot->data.resize(blockSize);
+      slot->size = decompressor->read(slot->data.data(), blockSize);
+      if (slot->size == 0) {
+        break;
+      }
+      blocks.push();
+      blockReady.notify();
+    }
+  } catch (...) {
+    decoderError = std::current_exception();
+  }
+
+  decoderDone.store(true, std::memory_order_release);
+  blockReady.notify();
+}
+
+CompressedFileReader::Block *CompressedFileReader::waitForBlock() {
+  Block *block = nullptr;
+  blockReady.wait([&]() {
+    if ((block = blocks.front()) != nullptr) {
+      return true;
+    }
+    if (decoderDone.load(std::memory_order_acquire)) {
+      // Everything pushed before `decoderDone` is visible now
+      block = blocks.front();
+      return true;
+    }
+    return false;
+  });
+  return block;
+}
+
+bool CompressedFileReader::nextLine(std::string_view &line) {
+  if (finished) {
+    return false;
+  }
+
+  if (!started) {
+    start();
+  }
+
+  carry.clear();
+
+  for (;;) {
+    if (current == nullptr) {
+      current  = waitForBlock();
+      position = 0;
+
+      if (current == nullptr) {
+        finished = true;
+        stop();
+        if (decoderError) {
+          std::rethrow_exception(decoderError);
+        }
+
+        // Same as std::getline: a final line without '\n' is still a line
+        line = carry;
+        return !carry.empty();
+      }
+    }
+
+    const char *begin   = current->data.data() + position;
+    const auto *newline = static_cast<const char *>(std::memchr(begin, '\n', current->size - position));
+
+    if (newline != nullptr) {
+      std::size_t length = static_cast<std::size_t>(newline - begin);
+      position += length + 1;
+
+      if (carry.empty()) {
+        line = std::string_view(begin, length);
+      } else {
+        carry.append(begin, length);
+        line = carry;
+      }
+      return true;
+    }
+
+    // No newline left in this block: keep the partial line and hand the block back
+    carry.append(begin, current->size - position);
+    blocks.pop();
+    blockFree.notify();
+    current = nullptr;
+  }
+}
+
+} // namespace simulator
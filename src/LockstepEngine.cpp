@@ -0,0 +1,380 @@
+#include "LockstepEngine.hpp"
+
+#include <algorithm>
+
+#include "SimulatorException.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROBOTSIM_LOCKSTEP_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simulator {
+
+namespace {
+
+// Lanes per AVX2 register; arrays are padded to a multiple of it
+constexpr std::size_t LANE_BLOCK = 8;
+
+struct Lanes {
+  std::int32_t       *x;
+  std::int32_t       *y;
+  std::int32_t       *dir;
+  const std::int32_t *placed;
+  std::size_t         count; // Multiple of LANE_BLOCK
+  std::int32_t        cols;
+  std::int32_t        rows;
+  const ObstacleMap  *obstacles; // nullptr when the ground has none
+};
+
+// -1 if the target of a lane that stays on the ground is free, 0 otherwise
+std::int32_t openMask(const Lanes &lanes, std::int32_t nx, std::int32_t ny, std::int32_t inside) {
+  return inside & -static_cast<std::int32_t>(lanes.obstacles == nullptr || inside == 0 ||
+                                             !lanes.obstacles->isBlocked(Position(nx, ny)));
+}
+
+// Reference kernels, written like the vector ones (masks instead of branches)
+std::uint32_t moveScalar(const Lanes &lanes) {
+  std::uint32_t blocked = 0;
+  for (std::size_t i = 0; i < lanes.count; ++i) {
+    std::int32_t d      = lanes.dir[i];
+    std::int32_t dx     = (d == 1) - (d == 3);
+    std::int32_t dy     = (d == 0) - (d == 2);
+    std::int32_t nx     = lanes.x[i] + dx;
+    std::int32_t ny     = lanes.y[i] + dy;
+    std::int32_t inside = -static_cast<std::int32_t>(nx >= 0 && nx < lanes.cols && ny >= 0 && ny < lanes.rows);
+    std::int32_t open   = openMask(lanes, nx, ny, inside);
+    std::int32_t ok     = open & lanes.placed[i];
+    lanes.x[i] += dx & ok;
+    lanes.y[i] += dy & ok;
+    blocked += static_cast<std::uint32_t>(~open & lanes.placed[i] & 1);
+  }
+  return blocked;
+}
+
+void rotateScalar(const Lanes &lanes, std::int32_t step) {
+  for (std::size_t i = 0; i < lanes.count; ++i) {
+    lanes.dir[i] = (lanes.dir[i] + (step & lanes.placed[i])) & 3;
+  }
+}
+
+#ifdef ROBOTSIM_LOCKSTEP_X86
+
+std::uint32_t sumLanes(__m128i counts) {
+  alignas(16) std::int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), counts);
+  return static_cast<std::uint32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+std::uint32_t moveSse2(const Lanes &lanes) {
+  const __m128i one      = _mm_set1_epi32(1);
+  const __m128i two      = _mm_set1_epi32(2);
+  const __m128i three    = _mm_set1_epi32(3);
+  const __m128i zero     = _mm_setzero_si128();
+  const __m128i minusOne = _mm_set1_epi32(-1);
+  const __m128i cols     = _mm_set1_epi32(lanes.cols);
+  const __m128i rows     = _mm_set1_epi32(lanes.rows);
+  __m128i       blocked  = zero;
+
+  for (std::size_t i = 0; i < lanes.count; i += 4) {
+    __m128i x      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.x + i));
+    __m128i y      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.y + i));
+    __m128i d      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.dir + i));
+    __m128i placed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.placed + i));
+
+    // Compare masks are -1, so EAST - WEST and NORTH - SOUTH give the unit step
+    __m128i dx = _mm_sub_epi32(_mm_cmpeq_epi32(d, three), _mm_cmpeq_epi32(d, one));
+    __m128i dy = _mm_sub_epi32(_mm_cmpeq_epi32(d, two), _mm_cmpeq_epi32(d, zero));
+    __m128i nx = _mm_add_epi32(x, dx);
+    __m128i ny = _mm_add_epi32(y, dy);
+
+    __m128i open = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(nx, minusOne), _mm_cmplt_epi32(nx, cols)),
+                                 _mm_and_si128(_mm_cmpgt_epi32(ny, minusOne), _mm_cmplt_epi32(ny, rows)));
+
+    // SSE2 has no gather: test the obstacle bits lane by lane
+    if (lanes.obstacles != nullptr) {
+      alignas(16) std::int32_t targetX[4];
+      alignas(16) std::int32_t targetY[4];
+      alignas(16) std::int32_t mask[4];
+      _mm_store_si128(reinterpret_cast<__m128i *>(targetX), nx);
+      _mm_store_si128(reinterpret_cast<__m128i *>(targetY), ny);
+      _mm_store_si128(reinterpret_cast<__m128i *>(mask), open);
+      for (int lane = 0; lane < 4; ++lane) {
+        mask[lane] = openMask(lanes, targetX[lane], targetY[lane], mask[lane]);
+      }
+      open = _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+    }
+    __m128i ok = _mm_and_si128(open, placed);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes.x + i), _mm_add_epi32(x, _mm_and_si128(dx, ok)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes.y + i), _mm_add_epi32(y, _mm_and_si128(dy, ok)));
+    blocked = _mm_sub_epi32(blocked, _mm_andnot_si128(open, placed));
+  }
+
+  return sumLanes(blocked);
+}
+
+void rotateSse2(const Lanes &lanes, std::int32_t step) {
+  const __m128i stepV = _mm_set1_epi32(step);
+  const __m128i three = _mm_set1_epi32(3);
+
+  for (std::size_t i = 0; i < lanes.count; i += 4) {
+    __m128i d      = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.dir + i));
+    __m128i placed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.placed + i));
+    d              = _mm_and_si128(_mm_add_epi32(d, _mm_and_si128(stepV, placed)), three);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes.dir + i), d);
+  }
+}
+
+// Compiled for AVX2 regardless of the build flags, only called after bestKernel()/supports() checked the CPU
+__attribute__((target("avx2"))) std::uint32_t moveAvx2(const Lanes &lanes) {
+  const __m256i one      = _mm256_set1_epi32(1);
+  const __m256i two      = _mm256_set1_epi32(2);
+  const __m256i three    = _mm256_set1_epi32(3);
+  const __m256i zero     = _mm256_setzero_si256();
+  const __m256i minusOne = _mm256_set1_epi32(-1);
+  const __m256i cols     = _mm256_set1_epi32(lanes.cols);
+  const __m256i rows     = _mm256_set1_epi32(lanes.rows);
+  const __m256i bitIndex = _mm256_set1_epi32(31);
+  __m256i       blocked  = zero;
+
+  // Obstacle bits of a dense map as 32-bit words for the gather (the 64-bit words are little-endian); a
+  // sparse map is tested lane by lane
+  const int *words = lanes.obstacles != nullptr ? reinterpret_cast<const int *>(lanes.obstacles->data()) : nullptr;
+
+  for (std::size_t i = 0; i < lanes.count; i += 8) {
+    __m256i x      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.x + i));
+    __m256i y      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.y + i));
+    __m256i d      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.dir + i));
+    __m256i placed = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.placed + i));
+
+    __m256i dx = _mm256_sub_epi32(_mm256_cmpeq_epi32(d, three), _mm256_cmpeq_epi32(d, one));
+    __m256i dy = _mm256_sub_epi32(_mm256_cmpeq_epi32(d, two), _mm256_cmpeq_epi32(d, zero));
+    __m256i nx = _mm256_add_epi32(x, dx);
+    __m256i ny = _mm256_add_epi32(y, dy);
+
+    __m256i open =
+      _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(nx, minusOne), _mm256_cmpgt_epi32(cols, nx)),
+                       _mm256_and_si256(_mm256_cmpgt_epi32(ny, minusOne), _mm256_cmpgt_epi32(rows, ny)));
+
+    // Gather the word holding each target's obstacle bit; lanes off the ground load nothing
+    if (words != nullptr) {
+      __m256i cell    = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(ny, cols), nx), open);
+      __m256i word    = _mm256_mask_i32gather_epi32(zero, words, _mm256_srli_epi32(cell, 5), open, 4);
+      __m256i blocker = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(cell, bitIndex)), one);
+      open            = _mm256_andnot_si256(_mm256_cmpeq_epi32(blocker, one), open);
+    } else if (lanes.obstacles != nullptr) {
+      alignas(32) std::int32_t targetX[8];
+      alignas(32) std::int32_t targetY[8];
+      alignas(32) std::int32_t mask[8];
+      _mm256_store_si256(reinterpret_cast<__m256i *>(targetX), nx);
+      _mm256_store_si256(reinterpret_cast<__m256i *>(targetY), ny);
+      _mm256_store_si256(reinterpret_cast<__m256i *>(mask), open);
+      for (int lane = 0; lane < 8; ++lane) {
+        mask[lane] = openMask(lanes, targetX[lane], targetY[lane], mask[lane]);
+      }
+      open = _mm256_load_si256(reinterpret_cast<const __m256i *>(mask));
+    }
+    __m256i ok = _mm256_and_si256(open, placed);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.x + i), _mm256_add_epi32(x, _mm256_and_si256(dx, ok)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.y + i), _mm256_add_epi32(y, _mm256_and_si256(dy, ok)));
+    blocked = _mm256_sub_epi32(blocked, _mm256_andnot_si256(open, placed));
+  }
+
+  return sumLanes(_mm_add_epi32(_mm256_castsi256_si128(blocked), _mm256_extracti128_si256(blocked, 1)));
+}
+
+__attribute__((target("avx2"))) void rotateAvx2(const Lanes &lanes, std::int32_t step) {
+  const __m256i stepV = _mm256_set1_epi32(step);
+  const __m256i three = _mm256_set1_epi32(3);
+
+  for (std::size_t i = 0; i < lanes.count; i += 8) {
+    __m256i d      = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.dir + i));
+    __m256i placed = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.placed + i));
+    d              = _mm256_and_si256(_mm256_add_epi32(d, _mm256_and_si256(stepV, placed)), three);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.dir + i), d);
+  }
+}
+
+#endif // ROBOTSIM_LOCKSTEP_X86
+
+} // namespace
+
+SimdKernel LockstepEngine::bestKernel() {
+  if (supports(SimdKernel::AVX2)) {
+    return SimdKernel::AVX2;
+  }
+  return supports(SimdKernel::SSE2) ? SimdKernel::SSE2 : SimdKernel::SCALAR;
+}
+
+bool LockstepEngine::supports(SimdKernel kernel) {
+  switch (kernel) {
+#ifdef ROBOTSIM_LOCKSTEP_X86
+  case SimdKernel::AVX2:
+    return __builtin_cpu_supports("avx2");
+  case SimdKernel::SSE2:
+    return __builtin_cpu_supports("sse2");
+#endif
+  case SimdKernel::SCALAR:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::vector<Robot> LockstepEngine::readStarts(InputReader &reader, const CommandFactory &factory,
+                                              const SimulatorGround &ground) {
+  std::vector<Robot> starts;
+  std::string_view   line;
+  std::size_t        lineNumber = 0;
+
+  while (reader.nextLine(line)) {
+    ++lineNumber;
+    ParsedCommand command = factory.decode(line);
+    if (!command.ok() || command.opcode != Opcode::PLACE) {
+      throw InvalidInputException("Start " + std::to_string(lineNumber) + " must be a PLACE command, got '" +
+                                  std::string(line) + "'");
+    }
+    if (!ground.isValidPosition(command.position)) {
+      throw InvalidInputException("Start " + std::to_string(lineNumber) + " is not a free cell of the ground: '" +
+                                  std::string(line) + "'");
+    }
+    starts.emplace_back();
+    starts.back().place(command.position, command.direction);
+  }
+
+  return starts;
+}
+
+LockstepEngine::LockstepEngine(const SimulatorGround &simulatorGround, const std::vector<Robot> &starts,
+                               SimdKernel simdKernel)
+  : ground(simulatorGround)
+  , kernel(simdKernel)
+  , robotCount(starts.size())
+  , logger(Logger::getInstance())
+  , output(OutputSink::getInstance()) {
+
+  if (!supports(kernel)) {
+    throw InvalidInputException("Lockstep kernel is not supported on this CPU");
+  }
+  if (ground.getRows() > INT32_MAX || ground.getCols() > INT32_MAX) {
+    throw InvalidInputException("Lockstep runs keep 32-bit lanes and need a ground of at most 2^31 - 1 cells a side");
+  }
+
+  std::size_t padded = (robotCount + LANE_BLOCK - 1) / LANE_BLOCK * LANE_BLOCK;
+  xs.assign(padded, 0);
+  ys.assign(padded, 0);
+  directions.assign(padded, 0);
+  placedMask.assign(padded, 0);
+
+  for (std::size_t i = 0; i < robotCount; ++i) {
+    if (starts[i].hasPlaced()) {
+      xs[i]         = static_cast<std::int32_t>(starts[i].getPosition().x);
+      ys[i]         = static_cast<std::int32_t>(starts[i].getPosition().y);
+      directions[i] = static_cast<std::int32_t>(starts[i].getDirection());
+      placedMask[i] = -1;
+      ++placed;
+    }
+  }
+}
+
+LockstepResult LockstepEngine::execute(const ParsedCommand &command, std::size_t line) {
+  LockstepResult result;
+  result.opcode = command.opcode;
+  result.line   = line;
+
+  Lanes lanes{xs.data(),
+              ys.data(),
+              directions.data(),
+              placedMask.data(),
+              xs.size(),
+              static_cast<std::int32_t>(ground.getCols()),
+              static_cast<std::int32_t>(ground.getRows()),
+              ground.getObstacles()};
+
+  switch (command.opcode) {
+  case Opcode::PLACE:
+    if (!ground.isValidPosition(command.position)) {
+      result.blocked  = static_cast<std::uint32_t>(robotCount);
+      result.position = command.position;
+      break;
+    }
+    std::fill(xs.begin(), xs.begin() + static_cast<std::ptrdiff_t>(robotCount),
+              static_cast<std::int32_t>(command.position.x));
+    std::fill(ys.begin(), ys.begin() + static_cast<std::ptrdiff_t>(robotCount),
+              static_cast<std::int32_t>(command.position.y));
+    std::fill(directions.begin(), directions.begin() + static_cast<std::ptrdiff_t>(robotCount),
+              static_cast<std::int32_t>(command.direction));
+    std::fill(placedMask.begin(), placedMask.begin() + static_cast<std::ptrdiff_t>(robotCount), -1);
+    placed = robotCount;
+    break;
+
+  case Opcode::MOVE:
+    result.notPlaced = static_cast<std::uint32_t>(robotCount - placed);
+#ifdef ROBOTSIM_LOCKSTEP_X86
+    if (kernel == SimdKernel::AVX2) {
+      result.blocked = moveAvx2(lanes);
+      break;
+    }
+    if (kernel == SimdKernel::SSE2) {
+      result.blocked = moveSse2(lanes);
+      break;
+    }
+#endif
+    result.blocked = moveScalar(lanes);
+    break;
+
+  case Opcode::LEFT:
+  case Opcode::RIGHT: {
+    result.notPlaced  = static_cast<std::uint32_t>(robotCount - placed);
+    std::int32_t step = command.opcode == Opcode::LEFT ? 3 : 1;
+#ifdef ROBOTSIM_LOCKSTEP_X86
+    if (kernel == SimdKernel::AVX2) {
+      rotateAvx2(lanes, step);
+      break;
+    }
+    if (kernel == SimdKernel::SSE2) {
+      rotateSse2(lanes, step);
+      break;
+    }
+#endif
+    rotateScalar(lanes, step);
+    break;
+  }
+
+  case Opcode::REPORT:
+    report(line);
+    break;
+
+  default:
+    break;
+  }
+
+  return result;
+}
+
+Robot LockstepEngine::robot(std::size_t id) const {
+  Robot state;
+  if (id < robotCount && placedMask[id] != 0) {
+    state.place(Position(xs[id], ys[id]), static_cast<Direction>(directions[id]));
+  }
+  return state;
+}
+
+void LockstepEngine::report(std::size_t line) const {
+  for (std::size_t i = 0; i < robotCount; ++i) {
+    if (placedMask[i] != 0) {
+      output.report(line, Position(xs[i], ys[i]), static_cast<Direction>(directions[i]),
+                    static_cast<std::uint32_t>(i));
+    }
+  }
+
+  if (placed < robotCount && logger.isEnabled(LogLevel::WARNING)) {
+    logger.warning(robotCount == 1 ? std::string("REPORT command called but robot has not placed")
+                                   : "REPORT command called but " + std::to_string(robotCount - placed) +
+                                         " robots have not placed");
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,60 @@
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+MappedFile::MappedFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw FileException(path);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw FileException(path);
+  }
+
+  length = static_cast<std::size_t>(info.st_size);
+
+  // mmap rejects zero-length mappings; an empty file is simply an empty range
+  if (length > 0) {
+    void *addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw FileException(path);
+    }
+    bytes = static_cast<const char *>(addr);
+    ::madvise(addr, length, MADV_SEQUENTIAL);
+  }
+
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (bytes != nullptr) {
+    ::munmap(const_cast<char *>(bytes), length);
+  }
+}
+
+void MappedFile::releaseBefore(std::size_t offset) {
+  const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t boundary = (offset / pageSize) * pageSize;
+
+  if (bytes == nullptr || boundary <= released) {
+    return;
+  }
+
+  ::madvise(const_cast<char *>(bytes) + released, boundary - released, MADV_DONTNEED);
+  released = boundary;
+}
+
+} // namespace simulator
@@ -0,0 +1,41 @@
+
+#include "MappedFileReader.hpp"
+
+#include <cstring>
+
+namespace simulator {
+
+namespace {
+// Drop consumed pages in windows of this size
+constexpr std::size_t RELEASE_WINDOW = std::size_t(64) << 20;
+} // namespace
+
+bool MappedFileReader::nextLine(std::string_view &line) {
+  // Map lazily so that construction never touches the filesystem
+  if (!file) {
+    file = std::make_unique<MappedFile>(filepath);
+  }
+
+  const std::size_t size = file->size();
+  if (offset >= size) {
+    return false;
+  }
+
+  // The previous line is no longer referenced, so everything before `offset` can go
+  if (offset - releaseMark >= RELEASE_WINDOW) {
+    file->releaseBefore(offset);
+    releaseMark = offset;
+  }
+
+  // Same framing as std::getline: split on '\n', no empty line after a trailing newline
+  const char *begin   = file->data() + offset;
+  const auto *newline = static_cast<const char *>(std::memchr(begin, '\n', size - offset));
+  std::size_t length  = newline ? static_cast<std::size_t>(newline - begin) : size - offset;
+
+  line = std::string_view(begin, length);
+  offset += length + 1;
+
+  return true;
+}
+
+} // namespace simulator
@@ -0,0 +1,348 @@
+#include "ObstacleMap.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <string_view>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+namespace {
+
+// Index of the lowest / highest set bit of a non-zero word
+unsigned lowestBit(std::uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+  unsigned bit = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+unsigned highestBit(std::uint64_t word) {
+#if defined(__GNUC__)
+  return 63U - static_cast<unsigned>(__builtin_clzll(word));
+#else
+  unsigned bit = 0;
+  while (word >>= 1) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+std::size_t popCount(std::uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  std::size_t count = 0;
+  for (; word != 0; word &= word - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// Whole-token integer, surrounding blanks allowed
+bool parseCell(std::string_view token, Coordinate &value) {
+  while (!token.empty() && std::isspace(static_cast<unsigned char>(token.front()))) {
+    token.remove_prefix(1);
+  }
+  while (!token.empty() && std::isspace(static_cast<unsigned char>(token.back()))) {
+    token.remove_suffix(1);
+  }
+  auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+  return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+} // namespace
+
+ObstacleMap::ObstacleMap(Coordinate mapRows, Coordinate mapCols) : rows(mapRows), cols(mapCols), dense(false) {
+  if (rows <= 0 || cols <= 0) {
+    throw InvalidInputException("Obstacle map dimensions must be positive");
+  }
+  if (rows > MAX_GROUND_SIDE || cols > MAX_GROUND_SIDE) {
+    throw InvalidInputException("Obstacle map sides must be at most 2^40 cells");
+  }
+
+  dense = static_cast<double>(rows) * static_cast<double>(cols) <= static_cast<double>(DENSE_CELLS);
+  if (dense) {
+    bits.assign((static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols) + 63) / 64, 0);
+  }
+}
+
+std::shared_ptr<const ObstacleMap> ObstacleMap::load(const std::string &path, Coordinate groundRows,
+                                                     Coordinate groundCols) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw FileException(path);
+  }
+
+  std::vector<std::string> lines;
+  std::string              line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    lines.push_back(line);
+  }
+  if (file.bad()) {
+    throw FileException(path, "read error");
+  }
+
+  // Trailing blank lines are not rows
+  while (!lines.empty() && lines.back().empty()) {
+    lines.pop_back();
+  }
+
+  // A grid starts with '#' or '.', a cell list with a digit
+  if (!lines.empty() && !lines.front().empty() && std::isdigit(static_cast<unsigned char>(lines.front().front()))) {
+    return std::make_shared<const ObstacleMap>(fromCells(lines, groundRows, groundCols));
+  }
+  return std::make_shared<const ObstacleMap>(fromRows(lines));
+}
+
+ObstacleMap ObstacleMap::fromRows(const std::vector<std::string> &lines) {
+  if (lines.empty() || lines.front().empty()) {
+    throw InvalidInputException("Obstacle map has no cells");
+  }
+
+  ObstacleMap map(static_cast<Coordinate>(lines.size()), static_cast<Coordinate>(lines.front().size()));
+  for (std::size_t row = 0; row < lines.size(); ++row) {
+    const std::string &text = lines[row];
+    if (text.size() != lines.front().size()) {
+      throw ParseException("obstacle map row has " + std::to_string(text.size()) + " cells, expected " +
+                             std::to_string(lines.front().size()),
+                           row + 1);
+    }
+
+    Coordinate y = map.rows - 1 - static_cast<Coordinate>(row);
+    for (std::size_t x = 0; x < text.size(); ++x) {
+      if (text[x] == '#') {
+        map.block(Position(static_cast<Coordinate>(x), y));
+      } else if (text[x] != '.') {
+        throw ParseException(std::string("unexpected character '") + text[x] +
+                               "' in obstacle map (use '#' for blocked and '.' for free cells)",
+                             row + 1);
+      }
+    }
+  }
+  return map;
+}
+
+ObstacleMap ObstacleMap::fromCells(const std::vector<std::string> &lines, Coordinate groundRows,
+                                   Coordinate groundCols) {
+  if (groundRows <= 0 || groundCols <= 0) {
+    throw InvalidInputException("An obstacle cell list needs the size of the ground");
+  }
+
+  ObstacleMap map(groundRows, groundCols);
+  for (std::size_t line = 0; line < lines.size(); ++line) {
+    const std::string &text = lines[line];
+    if (text.empty()) {
+      continue;
+    }
+
+    Coordinate  x     = 0;
+    Coordinate  y     = 0;
+    std::size_t comma = text.find(',');
+    if (comma == std::string::npos || !parseCell(std::string_view(text).substr(0, comma), x) ||
+        !parseCell(std::string_view(text).substr(comma + 1), y)) {
+      throw ParseException("expected a blocked cell as x,y in obstacle map, got '" + text + "'", line + 1);
+    }
+    if (x < 0 || x >= groundCols || y < 0 || y >= groundRows) {
+      throw ParseException("obstacle cell " + std::to_string(x) + "," + std::to_string(y) + " is not on the " +
+                             std::to_string(groundCols) + "x" + std::to_string(groundRows) + " ground",
+                           line + 1);
+    }
+    map.block(Position(x, y));
+  }
+  return map;
+}
+
+void ObstacleMap::block(const Position &pos) {
+  if (!dense) {
+    tiles[Position(pos.x >> TILE_SHIFT, pos.y >> TILE_SHIFT)] |= std::uint64_t{1} << tileBit(pos.x, pos.y);
+    return;
+  }
+  std::size_t index = cell(pos.x, pos.y);
+  bits[index >> 6] |= std::uint64_t{1} << (index & 63);
+}
+
+std::uint32_t ObstacleMap::freeSteps(Coordinate x, Coordinate y, unsigned direction, std::uint32_t limit) const {
+  if (!dense) {
+    // The `limit` cells ahead as a one-cell-wide rectangle
+    const bool       forward = direction == 0 || direction == 1; // NORTH / EAST
+    const Coordinate reach   = limit;
+    const Coordinate lowX    = direction == 1 ? x + 1 : direction == 3 ? x - reach : x;
+    const Coordinate highX   = direction == 1 ? x + reach : direction == 3 ? x - 1 : x;
+    const Coordinate lowY    = direction == 0 ? y + 1 : direction == 2 ? y - reach : y;
+    const Coordinate highY   = direction == 0 ? y + reach : direction == 2 ? y - 1 : y;
+
+    Position found;
+    if (limit == 0 || !nearestTileCell(lowX, lowY, highX, highY, !forward, found)) {
+      return limit;
+    }
+    const Coordinate distance = (found.x - x) + (found.y - y);
+    return static_cast<std::uint32_t>((distance < 0 ? -distance : distance) - 1);
+  }
+
+  const std::size_t from = cell(x, y);
+
+  switch (direction) {
+  case 1: // EAST: the cells ahead are consecutive bits
+    return static_cast<std::uint32_t>(firstBlocked(from + 1, from + 1 + limit) - (from + 1));
+  case 3: // WEST
+    return static_cast<std::uint32_t>(freeBelow(from - limit, from));
+  default: {
+    // NORTH / SOUTH: one bit per row
+    const Coordinate dy = direction == 0 ? 1 : -1;
+    for (std::uint32_t step = 1; step <= limit; ++step) {
+      if (isBlocked(Position(x, y + dy * step))) {
+        return step - 1;
+      }
+    }
+    return limit;
+  }
+  }
+}
+
+bool ObstacleMap::isClear(std::int64_t lowX, std::int64_t lowY, std::int64_t highX, std::int64_t highY) const {
+  if (!dense) {
+    Position found;
+    return !nearestTileCell(lowX, lowY, highX, highY, false, found);
+  }
+
+  for (std::int64_t y = lowY; y <= highY; ++y) {
+    const std::size_t end = cell(highX, y) + 1;
+    if (firstBlocked(cell(lowX, y), end) != end) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t ObstacleMap::blockedCount() const {
+  std::size_t count = 0;
+  for (std::uint64_t word : bits) {
+    count += popCount(word);
+  }
+  for (const auto &tile : tiles) {
+    count += popCount(tile.second);
+  }
+  return count;
+}
+
+std::size_t ObstacleMap::firstBlocked(std::size_t begin, std::size_t end) const {
+  if (begin >= end) {
+    return end;
+  }
+
+  std::size_t   word = begin >> 6;
+  std::uint64_t mask = bits[word] & (~std::uint64_t{0} << (begin & 63));
+  for (;;) {
+    if (mask != 0) {
+      return std::min(word * 64 + lowestBit(mask), end);
+    }
+    if (++word * 64 >= end) {
+      return end;
+    }
+    mask = bits[word];
+  }
+}
+
+std::size_t ObstacleMap::freeBelow(std::size_t begin, std::size_t end) const {
+  if (begin >= end) {
+    return 0;
+  }
+
+  const std::size_t last = end - 1;
+  std::size_t       word = last >> 6;
+  std::uint64_t     mask = bits[word] & (~std::uint64_t{0} >> (63 - (last & 63)));
+  for (;;) {
+    if (mask != 0) {
+      std::size_t found = word * 64 + highestBit(mask);
+      return found >= begin ? last - found : end - begin;
+    }
+    if (word * 64 <= begin) {
+      return end - begin;
+    }
+    mask = bits[--word];
+  }
+}
+
+bool ObstacleMap::nearestTileCell(Coordinate lowX, Coordinate lowY, Coordinate highX, Coordinate highY,
+                                  bool fromHigh, Position &found) const {
+  const Coordinate tileLowX  = lowX >> TILE_SHIFT;
+  const Coordinate tileLowY  = lowY >> TILE_SHIFT;
+  const Coordinate tileHighX = highX >> TILE_SHIFT;
+  const Coordinate tileHighY = highY >> TILE_SHIFT;
+
+  // Blocked cells of a tile that lie in the rectangle
+  auto inside = [&](const Position &tile, std::uint64_t word) {
+    const Coordinate    baseX = tile.x << TILE_SHIFT;
+    const Coordinate    baseY = tile.y << TILE_SHIFT;
+    const auto          fromX = static_cast<unsigned>(std::max<Coordinate>(lowX - baseX, 0));
+    const auto          toX   = static_cast<unsigned>(std::min<Coordinate>(highX - baseX, 7));
+    const auto          fromY = static_cast<unsigned>(std::max<Coordinate>(lowY - baseY, 0));
+    const auto          toY   = static_cast<unsigned>(std::min<Coordinate>(highY - baseY, 7));
+    const std::uint64_t row   = (std::uint64_t{0xFF} >> (7 - toX)) & (std::uint64_t{0xFF} << fromX);
+
+    std::uint64_t mask = 0;
+    for (unsigned y = fromY; y <= toY; ++y) {
+      mask |= row << (y << TILE_SHIFT);
+    }
+    return word & mask;
+  };
+  // Lowest (or highest) cell of a tile's mask in row-major order
+  auto cellOf = [&](const Position &tile, std::uint64_t mask) {
+    const unsigned bit = fromHigh ? highestBit(mask) : lowestBit(mask);
+    return Position((tile.x << TILE_SHIFT) + (bit & 7), (tile.y << TILE_SHIFT) + (bit >> TILE_SHIFT));
+  };
+
+  const double crossed =
+    (static_cast<double>(tileHighX - tileLowX) + 1.0) * (static_cast<double>(tileHighY - tileLowY) + 1.0);
+  if (crossed <= static_cast<double>(tiles.size())) {
+    // Look up the tiles the rectangle covers, nearest first
+    for (Coordinate i = 0; i <= tileHighY - tileLowY; ++i) {
+      for (Coordinate j = 0; j <= tileHighX - tileLowX; ++j) {
+        const Position tile(fromHigh ? tileHighX - j : tileLowX + j, fromHigh ? tileHighY - i : tileLowY + i);
+        auto           entry = tiles.find(tile);
+        if (entry == tiles.end()) {
+          continue;
+        }
+        if (std::uint64_t mask = inside(tile, entry->second)) {
+          found = cellOf(tile, mask);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Fewer stored tiles than covered ones: check every stored tile
+  bool any = false;
+  for (const auto &[tile, word] : tiles) {
+    if (tile.x < tileLowX || tile.x > tileHighX || tile.y < tileLowY || tile.y > tileHighY) {
+      continue;
+    }
+    if (std::uint64_t mask = inside(tile, word)) {
+      const Position candidate = cellOf(tile, mask);
+      const bool     lower     = candidate.y < found.y || (candidate.y == found.y && candidate.x < found.x);
+      if (!any || lower != fromHigh) {
+        found = candidate;
+        any   = true;
+      }
+    }
+  }
+  return any;
+}
+
+} // namespace simulator
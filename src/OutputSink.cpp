@@ -0,0 +1,233 @@
+#include "OutputSink.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+namespace {
+
+constexpr std::string_view PREFIX           = "Output: ";
+constexpr std::string_view CSV_HEADER       = "line,x,y,direction\n";
+constexpr std::string_view CSV_ROBOT_HEADER = "line,robot,x,y,direction\n";
+
+// Longest result: a JSONL record with a 20-digit line, a 10-digit robot, two 20-character 64-bit
+// coordinates and "NORTH" takes 119 bytes
+constexpr std::size_t MAX_REPORT_LENGTH = 128;
+
+std::string_view directionName(Direction direction) {
+  switch (direction) {
+  case Direction::NORTH:
+    return "NORTH";
+  case Direction::EAST:
+    return "EAST";
+  case Direction::SOUTH:
+    return "SOUTH";
+  case Direction::WEST:
+    return "WEST";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+char *append(char *out, std::string_view text) {
+  std::memcpy(out, text.data(), text.size());
+  return out + text.size();
+}
+
+char *putLittleEndian(char *out, std::uint64_t value, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+  return out + bytes;
+}
+
+thread_local std::string *captureTarget = nullptr;
+
+} // namespace
+
+OutputSink::Capture::Capture(std::string &target) : previous(captureTarget) {
+  captureTarget = &target;
+}
+
+OutputSink::Capture::~Capture() {
+  captureTarget = previous;
+}
+
+std::string *OutputSink::captured() {
+  return captureTarget;
+}
+
+void OutputSink::openFile(const std::string &path) {
+  flush();
+  file.close();
+  file.clear();
+
+  // Unbuffered: the sink already hands over large blocks
+  file.rdbuf()->pubsetbuf(nullptr, 0);
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw FileException(path, "cannot create output file");
+  }
+  filePath = path;
+}
+
+void OutputSink::useConsole() {
+  flush();
+  file.close();
+  filePath.clear();
+}
+
+void OutputSink::setFormat(OutputFormat outputFormat) {
+  flush();
+  format = outputFormat;
+
+  char *out = buffer.data();
+  if (format == OutputFormat::CSV) {
+    out = append(out, robotIds ? CSV_ROBOT_HEADER : CSV_HEADER);
+  } else if (format == OutputFormat::BINARY) {
+    out = append(out, std::string_view(rbr::MAGIC, sizeof(rbr::MAGIC)));
+    out = putLittleEndian(out, rbr::VERSION, 2);
+    out = putLittleEndian(out, rbr::HEADER_SIZE, 2);
+    out = putLittleEndian(out, rbr::RECORD_SIZE, 2);
+    out = putLittleEndian(out, 0, 6);
+  }
+  used = static_cast<std::size_t>(out - buffer.data());
+}
+
+void OutputSink::report(std::size_t line, const Position &position, Direction direction, std::uint32_t robot) {
+  if (std::string *capture = captured()) {
+    char  record[MAX_REPORT_LENGTH];
+    char *out = formatReport(record, record + sizeof(record), line, position, direction, robot);
+    capture->append(record, static_cast<std::size_t>(out - record));
+    return;
+  }
+
+  if (buffer.size() - used < MAX_REPORT_LENGTH) {
+    flush();
+  }
+
+  char *out = formatReport(buffer.data() + used, buffer.data() + buffer.size(), line, position, direction, robot);
+  used      = static_cast<std::size_t>(out - buffer.data());
+
+  if (interactive) {
+    flush();
+  }
+}
+
+void OutputSink::print(std::string_view text) {
+  if (std::string *capture = captured()) {
+    capture->append(text);
+    return;
+  }
+
+  flushConsole();
+  std::cout << text;
+}
+
+void OutputSink::write(std::string_view text) {
+  while (!text.empty()) {
+    if (used == buffer.size()) {
+      flush();
+    }
+    std::size_t count = std::min(text.size(), buffer.size() - used);
+    std::memcpy(buffer.data() + used, text.data(), count);
+    used += count;
+    text.remove_prefix(count);
+  }
+
+  if (interactive) {
+    flush();
+  }
+}
+
+char *OutputSink::formatReport(char *out, char *end, std::size_t line, const Position &position,
+                               Direction direction, std::uint32_t robot) const {
+  switch (format) {
+  case OutputFormat::TEXT:
+    if (robotIds) {
+      out = std::to_chars(out, end, robot).ptr;
+      out = append(out, ": ");
+    }
+    out    = append(out, PREFIX);
+    out    = std::to_chars(out, end, position.x).ptr;
+    *out++ = ',';
+    out    = std::to_chars(out, end, position.y).ptr;
+    *out++ = ',';
+    out    = append(out, directionName(direction));
+    *out++ = '\n';
+    break;
+  case OutputFormat::JSONL:
+    out = append(out, "{\"line\":");
+    out = std::to_chars(out, end, line).ptr;
+    if (robotIds) {
+      out = append(out, ",\"robot\":");
+      out = std::to_chars(out, end, robot).ptr;
+    }
+    out = append(out, ",\"x\":");
+    out = std::to_chars(out, end, position.x).ptr;
+    out = append(out, ",\"y\":");
+    out = std::to_chars(out, end, position.y).ptr;
+    out = append(out, ",\"direction\":\"");
+    out = append(out, directionName(direction));
+    out = append(out, "\"}\n");
+    break;
+  case OutputFormat::CSV:
+    out    = std::to_chars(out, end, line).ptr;
+    *out++ = ',';
+    if (robotIds) {
+      out    = std::to_chars(out, end, robot).ptr;
+      *out++ = ',';
+    }
+    out    = std::to_chars(out, end, position.x).ptr;
+    *out++ = ',';
+    out    = std::to_chars(out, end, position.y).ptr;
+    *out++ = ',';
+    out    = append(out, directionName(direction));
+    *out++ = '\n';
+    break;
+  case OutputFormat::BINARY:
+    out = putLittleEndian(out, line, 8);
+    out = putLittleEndian(out, static_cast<std::uint64_t>(position.x), 8);
+    out = putLittleEndian(out, static_cast<std::uint64_t>(position.y), 8);
+    out = putLittleEndian(out, static_cast<std::uint64_t>(direction), 4);
+    out = putLittleEndian(out, robot, 4);
+    break;
+  }
+
+  return out;
+}
+
+void OutputSink::flush() {
+  if (captured() != nullptr || used == 0) {
+    return;
+  }
+
+  auto size = static_cast<std::streamsize>(used);
+  used      = 0;
+
+  if (writesToConsole()) {
+    std::cout.write(buffer.data(), size);
+    std::cout.flush();
+    return;
+  }
+
+  if (!file.write(buffer.data(), size)) {
+    throw FileException(filePath, "cannot write results");
+  }
+}
+
+OutputSink::~OutputSink() {
+  try {
+    flush();
+  } catch (const FileException &) {
+    // Nothing left to report to at exit
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,167 @@
+
+#include "ParallelParseReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace simulator {
+
+namespace {
+// Drop consumed pages in windows of this size
+constexpr std::size_t RELEASE_WINDOW = std::size_t(64) << 20;
+} // namespace
+
+ParallelParseReader::ParallelParseReader(const std::string path, unsigned threads, std::size_t chunkSize)
+  : filepath(path)
+  , threadCount(threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency()))
+  , chunkSize(std::max<std::size_t>(1, chunkSize)) {}
+
+ParallelParseReader::~ParallelParseReader() {
+  stop();
+}
+
+void ParallelParseReader::start() {
+  file       = std::make_unique<MappedFile>(filepath);
+  chunkCount = (file->size() + chunkSize - 1) / chunkSize;
+
+  // Two chunks per worker keeps every thread busy while the consumer catches up
+  window.resize(std::size_t(threadCount) * 2);
+  for (unsigned i = 0; i < threadCount; ++i) {
+    workers.emplace_back(&ParallelParseReader::worker, this);
+  }
+}
+
+void ParallelParseReader::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  slotFree.notify_all();
+
+  for (auto &thread : workers) {
+    thread.join();
+  }
+  workers.clear();
+}
+
+// Chunk k starts right after the first '\n' at or after byte k * chunkSize - 1, so
+// every worker can find its own boundaries without scanning earlier chunks
+std::size_t ParallelParseReader::chunkBegin(std::size_t index) const {
+  if (index == 0) {
+    return 0;
+  }
+
+  const std::size_t size = file->size();
+  const std::size_t from = std::min(index * chunkSize - 1, size);
+  const auto *newline = static_cast<const char *>(std::memchr(file->data() + from, '\n', size - from));
+
+  return newline ? static_cast<std::size_t>(newline - file->data()) + 1 : size;
+}
+
+void ParallelParseReader::parseChunk(std::size_t index, Chunk &chunk) const {
+  const char *data  = file->data();
+  std::size_t begin = chunkBegin(index);
+  std::size_t end   = chunkBegin(index + 1);
+
+  chunk.commands.clear();
+  chunk.lines.clear();
+
+  // Same framing as std::getline: split on '\n', no empty line after a trailing newline
+  while (begin < end) {
+    const auto *newline = static_cast<const char *>(std::memchr(data + begin, '\n', end - begin));
+    std::size_t length  = newline ? static_cast<std::size_t>(newline - (data + begin)) : end - begin;
+
+    std::string_view line(data + begin, length);
+    chunk.lines.push_back(line);
+    chunk.commands.push_back(decoder.decode(line));
+
+    begin += length + 1;
+  }
+}
+
+void ParallelParseReader::worker() {
+  for (;;) {
+    std::size_t index;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      slotFree.wait(lock, [this]() {
+        return stopping || nextToParse >= chunkCount || nextToParse < current + window.size();
+      });
+      if (stopping || nextToParse >= chunkCount) {
+        return;
+      }
+      index = nextToParse++;
+    }
+
+    // The slot is owned by this worker until it is marked ready
+    Chunk &chunk = window[index % window.size()];
+    parseChunk(index, chunk);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      chunk.ready = true;
+    }
+    chunkReady.notify_all();
+  }
+}
+
+bool ParallelParseReader::advance() {
+  if (!file) {
+    start();
+  }
+
+  for (;;) {
+    if (current >= chunkCount) {
+      return false;
+    }
+
+    if (!holding) {
+      std::unique_lock<std::mutex> lock(mutex);
+      chunkReady.wait(lock, [this]() { return window[current % window.size()].ready; });
+      holding  = true;
+      position = 0;
+    }
+
+    if (position < window[current % window.size()].commands.size()) {
+      return true;
+    }
+
+    // Current chunk is exhausted: hand its slot back to the workers
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      window[current % window.size()].ready = false;
+      ++current;
+      holding = false;
+    }
+    slotFree.notify_all();
+
+    // Nothing before the new chunk is referenced any more
+    std::size_t consumed = chunkBegin(current);
+    if (consumed - releaseMark >= RELEASE_WINDOW) {
+      file->releaseBefore(consumed);
+      releaseMark = consumed;
+    }
+  }
+}
+
+bool ParallelParseReader::nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) {
+  UNUSED(factory); // Workers decode with their own stateless factory
+
+  if (!advance()) {
+    return false;
+  }
+
+  const Chunk &chunk = window[current % window.size()];
+  command            = chunk.commands[position];
+  line               = chunk.lines[position];
+  ++position;
+
+  return true;
+}
+
+bool ParallelParseReader::nextLine(std::string_view &line) {
+  ParsedCommand command;
+  return nextCommand(decoder, command, line);
+}
+
+} // namespace simulator
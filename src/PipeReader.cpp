@@ -0,0 +1,70 @@
+
+#include "PipeReader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#include "SimulatorException.hpp"
+
+namespace simulator {
+
+PipeReader::PipeReader(int fd, std::size_t bufferSize) : fd(fd), buffer(std::max<std::size_t>(bufferSize, 2)) {}
+
+bool PipeReader::fill() {
+  // Move the partial line to the front, or grow if a single line fills the buffer
+  if (begin > 0) {
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+  } else if (end == buffer.size()) {
+    buffer.resize(buffer.size() * 2);
+  }
+
+  for (;;) {
+    ssize_t count = ::read(fd, buffer.data() + end, buffer.size() - end);
+    if (count > 0) {
+      end += static_cast<std::size_t>(count);
+      return true;
+    }
+    if (count == 0) {
+      return false;
+    }
+    if (errno != EINTR) {
+      throw FileException("<stdin>", std::strerror(errno));
+    }
+  }
+}
+
+bool PipeReader::nextLine(std::string_view &line) {
+  for (;;) {
+    const char *from    = buffer.data() + begin + scan;
+    const char *newline = static_cast<const char *>(std::memchr(from, '\n', end - begin - scan));
+
+    if (newline != nullptr) {
+      std::size_t length = static_cast<std::size_t>(newline - (buffer.data() + begin));
+      line               = std::string_view(buffer.data() + begin, length);
+      begin += length + 1;
+      scan = 0;
+      return true;
+    }
+
+    scan = end - begin;
+
+    if (eof || !fill()) {
+      eof = true;
+
+      // Same as std::getline: a final line without '\n' is still a line
+      if (begin == end) {
+        return false;
+      }
+      line  = std::string_view(buffer.data() + begin, end - begin);
+      begin = end;
+      scan  = 0;
+      return true;
+    }
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,260 @@
+
+#include "PipelinedReader.hpp"
+
+#include "Logger.hpp"
+
+namespace simulator {
+
+namespace {
+
+// Only one thread ever writes a given maximum, so a plain load/store is enough
+void recordDepth(std::atomic<std::size_t> &maximum, std::size_t depth) {
+  if (depth > maximum.load(std::memory_order_relaxed)) {
+    maximum.store(depth, std::memory_order_relaxed);
+  }
+}
+
+void increment(std::atomic<std::uint64_t> &counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+PipelinedReader::PipelinedReader(std::unique_ptr<InputReader> source, std::size_t queueDepth)
+  : source(std::move(source))
+  , lineQueue(queueDepth)
+  , commandQueue(queueDepth) {
+
+  if (!this->source) {
+    throw InvalidInputException("PipelinedReader requires a source reader");
+  }
+}
+
+PipelinedReader::~PipelinedReader() {
+  stop();
+}
+
+void PipelinedReader::start() {
+  started = true;
+  if (source->decodesCommands()) {
+    readerThread = std::thread(&PipelinedReader::commandReaderLoop, this);
+    return;
+  }
+  readerThread = std::thread(&PipelinedReader::readerLoop, this);
+  parserThread = std::thread(&PipelinedReader::parserLoop, this);
+}
+
+// Note: a reader thread blocked inside the wrapped reader (e.g. waiting on a
+// terminal) can only be joined once that read returns
+void PipelinedReader::stop() {
+  stopping.store(true, std::memory_order_relaxed);
+  lineReady.notify();
+  lineFree.notify();
+  commandFree.notify();
+
+  if (readerThread.joinable()) {
+    readerThread.join();
+  }
+  if (parserThread.joinable()) {
+    parserThread.join();
+  }
+}
+
+void PipelinedReader::readerLoop() {
+  try {
+    std::string_view line;
+    while (!stopping.load(std::memory_order_relaxed) && source->nextLine(line)) {
+      std::string *slot = lineQueue.producerSlot();
+      if (slot == nullptr) {
+        increment(readerStalls);
+        lineFree.wait([&]() {
+          return (slot = lineQueue.producerSlot()) != nullptr || stopping.load(std::memory_order_relaxed);
+        });
+        if (slot == nullptr) {
+          return;
+        }
+      }
+
+      // Slots keep their capacity, so this only allocates while the queue warms up
+      slot->assign(line.data(), line.size());
+      lineQueue.push();
+      lineReady.notify();
+      recordDepth(maxLineQueueDepth, lineQueue.size());
+    }
+  } catch (...) {
+    readerError = std::current_exception();
+  }
+
+  readerDone.store(true, std::memory_order_release);
+  lineReady.notify();
+}
+
+void PipelinedReader::commandReaderLoop() {
+  try {
+    ParsedCommand    command;
+    std::string_view line;
+    while (!stopping.load(std::memory_order_relaxed) && source->nextCommand(decoder, command, line)) {
+      DecodedLine *slot = commandQueue.producerSlot();
+      if (slot == nullptr) {
+        increment(readerStalls);
+        commandFree.wait([&]() {
+          return (slot = commandQueue.producerSlot()) != nullptr || stopping.load(std::memory_order_relaxed);
+        });
+        if (slot == nullptr) {
+          return;
+        }
+      }
+
+      slot->command = command;
+      slot->text.assign(line.data(), line.size());
+      commandQueue.push();
+      commandReady.notify();
+      recordDepth(maxCommandQueueDepth, commandQueue.size());
+    }
+  } catch (...) {
+    readerError = std::current_exception();
+  }
+
+  // Stands in for the parser stage, so the executor stops once this is set
+  parserDone.store(true, std::memory_order_release);
+  commandReady.notify();
+}
+
+void PipelinedReader::parserLoop() {
+  for (;;) {
+    std::string *line = lineQueue.front();
+    if (line == nullptr) {
+      increment(parserStarved);
+      bool sourceDone = false;
+      lineReady.wait([&]() {
+        if ((line = lineQueue.front()) != nullptr) {
+          return true;
+        }
+        if (readerDone.load(std::memory_order_acquire)) {
+          // Everything pushed before `readerDone` is visible now
+          line       = lineQueue.front();
+          sourceDone = true;
+          return true;
+        }
+        return stopping.load(std::memory_order_relaxed);
+      });
+      if (line == nullptr) {
+        if (!sourceDone) {
+          return;
+        }
+        break;
+      }
+    }
+
+    DecodedLine *slot = commandQueue.producerSlot();
+    if (slot == nullptr) {
+      increment(parserStalls);
+      commandFree.wait([&]() {
+        return (slot = commandQueue.producerSlot()) != nullptr || stopping.load(std::memory_order_relaxed);
+      });
+      if (slot == nullptr) {
+        return;
+      }
+    }
+
+    slot->command = decoder.decode(*line);
+    // Swap instead of copying: string buffers circulate between the two queues
+    slot->text.swap(*line);
+
+    lineQueue.pop();
+    lineFree.notify();
+    commandQueue.push();
+    commandReady.notify();
+    recordDepth(maxCommandQueueDepth, commandQueue.size());
+  }
+
+  parserDone.store(true, std::memory_order_release);
+  commandReady.notify();
+}
+
+bool PipelinedReader::nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) {
+  UNUSED(factory); // Commands are decoded on the parser thread
+
+  if (finished) {
+    return false;
+  }
+
+  if (!started) {
+    start();
+  }
+
+  // The previous command's text is no longer referenced, its slot can be reused
+  if (holding) {
+    commandQueue.pop();
+    commandFree.notify();
+    holding = false;
+  }
+
+  DecodedLine *item = commandQueue.front();
+  if (item == nullptr) {
+    increment(executorStarved);
+    commandReady.wait([&]() {
+      if ((item = commandQueue.front()) != nullptr) {
+        return true;
+      }
+      if (parserDone.load(std::memory_order_acquire)) {
+        item = commandQueue.front();
+        return true;
+      }
+      return false;
+    });
+  }
+
+  if (item == nullptr) {
+    finished = true;
+    stop();
+    logStats();
+
+    if (readerError) {
+      std::exception_ptr error = readerError;
+      readerError              = nullptr;
+      std::rethrow_exception(error);
+    }
+    return false;
+  }
+
+  command = item->command;
+  line    = item->text;
+  holding = true;
+
+  return true;
+}
+
+bool PipelinedReader::nextLine(std::string_view &line) {
+  ParsedCommand command;
+  return nextCommand(decoder, command, line);
+}
+
+PipelineStats PipelinedReader::getStats() const {
+  PipelineStats stats;
+  stats.queueCapacity        = lineQueue.capacity();
+  stats.maxLineQueueDepth    = maxLineQueueDepth.load(std::memory_order_relaxed);
+  stats.maxCommandQueueDepth = maxCommandQueueDepth.load(std::memory_order_relaxed);
+  stats.readerStalls         = readerStalls.load(std::memory_order_relaxed);
+  stats.parserStarved        = parserStarved.load(std::memory_order_relaxed);
+  stats.parserStalls         = parserStalls.load(std::memory_order_relaxed);
+  stats.executorStarved      = executorStarved.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void PipelinedReader::logStats() const {
+  Logger &logger = Logger::getInstance();
+  if (!logger.isEnabled(LogLevel::INFO)) {
+    return;
+  }
+
+  PipelineStats stats = getStats();
+  logger.info("Pipeline queues: capacity " + std::to_string(stats.queueCapacity) + ", max depth " +
+              std::to_string(stats.maxLineQueueDepth) + " lines / " + std::to_string(stats.maxCommandQueueDepth) +
+              " commands");
+  logger.info("Pipeline stalls: reader " + std::to_string(stats.readerStalls) + ", parser starved " +
+              std::to_string(stats.parserStarved) + ", parser stalled " + std::to_string(stats.parserStalls) +
+              ", executor starved " + std::to_string(stats.executorStarved));
+}
+
+} // namespace simulator
@@ -0,0 +1,216 @@
+#include "RobotFleet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+#include "PackedRobot.hpp"
+
+namespace simulator {
+
+namespace {
+
+std::size_t skipSpaces(std::string_view text, std::size_t pos) {
+  while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+    ++pos;
+  }
+  return pos;
+}
+
+const char *commandName(Opcode opcode) {
+  switch (opcode) {
+  case Opcode::PLACE:
+    return "PLACE";
+  case Opcode::MOVE:
+    return "MOVE";
+  case Opcode::LEFT:
+    return "LEFT";
+  default:
+    return "RIGHT";
+  }
+}
+
+} // namespace
+
+RobotFleet::RobotFleet(SimulatorGround &simulatorGround)
+  : ground(simulatorGround)
+  , logger(Logger::getInstance())
+  , output(OutputSink::getInstance()) {
+  ground.trackOccupancy();
+}
+
+RobotFleet::~RobotFleet() {
+  ground.clearOccupancy();
+}
+
+RobotFleet::Address RobotFleet::parseAddress(std::string_view line, std::uint32_t &robot,
+                                             std::string_view &command) noexcept {
+  robot   = 0;
+  command = line;
+
+  std::size_t pos = skipSpaces(line, 0);
+  if (pos == line.size()) {
+    return Address::OK;
+  }
+
+  std::uint64_t id        = 0;
+  bool          broadcast = line[pos] == '*';
+  std::size_t   idEnd     = pos;
+
+  if (broadcast) {
+    idEnd = pos + 1;
+  } else {
+    while (idEnd < line.size() && std::isdigit(static_cast<unsigned char>(line[idEnd]))) {
+      // Saturate: anything past the limit is rejected below
+      id = std::min<std::uint64_t>(id * 10 + static_cast<std::uint64_t>(line[idEnd] - '0'), MAX_ROBOTS);
+      ++idEnd;
+    }
+    if (idEnd == pos) {
+      return Address::OK; // no prefix
+    }
+  }
+
+  std::size_t colon = skipSpaces(line, idEnd);
+  if (colon == line.size() || line[colon] != ':') {
+    return Address::OK; // not an address, the whole line is the command
+  }
+
+  if (!broadcast && id >= MAX_ROBOTS) {
+    return Address::INVALID_ID;
+  }
+
+  robot   = broadcast ? ALL_ROBOTS : static_cast<std::uint32_t>(id);
+  command = line.substr(colon + 1);
+  return Address::OK;
+}
+
+ExecutionResult RobotFleet::tryExecute(std::uint32_t robot, const ParsedCommand &command, std::size_t line) {
+  ExecutionResult result;
+  result.opcode = command.opcode;
+  result.robot  = robot;
+  result.line   = line;
+
+  if (robot >= placedFlags.size()) {
+    grow(robot);
+  }
+
+  switch (command.opcode) {
+  case Opcode::PLACE: {
+    const Position &target = command.position;
+    if (!ground.isValidPosition(target)) {
+      result.error    = ground.isInside(target) ? ExecutionError::OBSTACLE : ExecutionError::PLACE_OUT_OF_BOUNDS;
+      result.position = target;
+      break;
+    }
+    bool stays = placedFlags[robot] != 0 && xs[robot] == target.x && ys[robot] == target.y;
+    if (!stays) {
+      if (ground.isOccupied(target)) {
+        result.error    = ExecutionError::OCCUPIED;
+        result.position = target;
+        break;
+      }
+      if (placedFlags[robot] != 0) {
+        ground.vacate(Position(xs[robot], ys[robot]));
+      }
+      ground.occupy(target);
+    }
+    xs[robot]          = target.x;
+    ys[robot]          = target.y;
+    directions[robot]  = static_cast<std::uint8_t>(command.direction);
+    placedFlags[robot] = 1;
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logChanged(robot, command.opcode);
+    }
+    break;
+  }
+
+  case Opcode::MOVE: {
+    if (placedFlags[robot] == 0) {
+      result.error = ExecutionError::NOT_PLACED;
+      break;
+    }
+    Position next(xs[robot] + DELTA_X[directions[robot]], ys[robot] + DELTA_Y[directions[robot]]);
+    if (!ground.isValidPosition(next)) {
+      result.error    = ground.isInside(next) ? ExecutionError::OBSTACLE : ExecutionError::MOVE_OUT_OF_BOUNDS;
+      result.position = next;
+      break;
+    }
+    if (ground.isOccupied(next)) {
+      result.error    = ExecutionError::OCCUPIED;
+      result.position = next;
+      break;
+    }
+    ground.vacate(Position(xs[robot], ys[robot]));
+    ground.occupy(next);
+    xs[robot] = next.x;
+    ys[robot] = next.y;
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logChanged(robot, command.opcode);
+    }
+    break;
+  }
+
+  case Opcode::LEFT:
+  case Opcode::RIGHT:
+    if (placedFlags[robot] == 0) {
+      result.error = ExecutionError::NOT_PLACED;
+      break;
+    }
+    directions[robot] = static_cast<std::uint8_t>(command.opcode == Opcode::LEFT ? ROTATE_LEFT[directions[robot]]
+                                                                                  : ROTATE_RIGHT[directions[robot]]);
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logChanged(robot, command.opcode);
+    }
+    break;
+
+  case Opcode::REPORT:
+    report(robot, line);
+    break;
+
+  default:
+    result.error = ExecutionError::INVALID_COMMAND;
+    break;
+  }
+
+  return result;
+}
+
+std::size_t RobotFleet::placedCount() const {
+  return static_cast<std::size_t>(std::count(placedFlags.begin(), placedFlags.end(), std::uint8_t{1}));
+}
+
+Robot RobotFleet::robot(std::uint32_t id) const {
+  Robot state;
+  if (id < placedFlags.size() && placedFlags[id] != 0) {
+    state.place(Position(xs[id], ys[id]), static_cast<Direction>(directions[id]));
+  }
+  return state;
+}
+
+void RobotFleet::grow(std::uint32_t robot) {
+  std::size_t count = static_cast<std::size_t>(robot) + 1;
+  xs.resize(count, 0);
+  ys.resize(count, 0);
+  directions.resize(count, 0);
+  placedFlags.resize(count, 0);
+}
+
+void RobotFleet::report(std::uint32_t robot, std::size_t line) const {
+  if (placedFlags[robot] == 0) {
+    if (logger.isEnabled(LogLevel::WARNING)) {
+      logger.warning("REPORT command called but robot " + std::to_string(robot) + " has not placed");
+    }
+    return;
+  }
+
+  output.report(line, Position(xs[robot], ys[robot]), static_cast<Direction>(directions[robot]), robot);
+}
+
+void RobotFleet::logChanged(std::uint32_t robot, Opcode opcode) const {
+  std::ostringstream oss;
+  oss << "Robot " << robot << " " << commandName(opcode) << ": now at " << xs[robot] << "," << ys[robot]
+      << " facing " << static_cast<Direction>(directions[robot]);
+  logger.info(oss.str());
+}
+
+} // namespace simulator
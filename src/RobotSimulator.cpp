@@ -6,38 +6,290 @@ namespace simulator {
 void RobotSimulator::run() {
   logger.info("Starting Robot simulator");
 
-  // Read input lines
-  std::vector<std::string> lines = reader->readInput();
+  std::size_t lineNumber  = 0;
+  int         errorNumber = 0;
 
-  if (lines.empty()) {
-    std::cout << "No input lines to process";
+  if (engine == Engine::STEP) {
+    runStepwise(lineNumber, errorNumber);
+  } else if (engine == Engine::TABLE) {
+    runTable(lineNumber, errorNumber);
+  } else if (engine == Engine::FLEET) {
+    runFleet(lineNumber, errorNumber);
+  } else if (engine == Engine::LOCKSTEP) {
+    runLockstep(lineNumber, errorNumber);
+  } else {
+    runCompiled(lineNumber, errorNumber);
+  }
+
+  OutputSink::getInstance().flush();
+
+  if (lineNumber == 0) {
+    OutputSink::getInstance().print("No input lines to process");
     return;
   }
 
-  logger.info("Successfully read " + std::to_string(lines.size()) + " lines");
+  logger.info("Successfully read " + std::to_string(lineNumber) + " lines");
+  logger.info("Simulation completed with " + std::to_string(errorNumber) + " Errors.");
+}
 
-  int errorNumber = 0;
+void RobotSimulator::runStepwise(std::size_t &lineNumber, int &errorNumber) {
+  // Common sizes run an executor specialized for compile-time bounds (static grounds have no obstacles)
+  bool specialized = !ground->hasObstacles() &&
+                     withStaticGround(ground->getRows(), ground->getCols(),
+                                      [&](const auto &bounds) { stepLoop(bounds, lineNumber, errorNumber); });
 
-  for (std::size_t i = 0; i < lines.size(); ++i) {
-    try {
-      logger.debug("Parsing command: " + lines[i]);
+  if (!specialized) {
+    stepLoop(*ground, lineNumber, errorNumber);
+  }
+}
 
-      // Parse command
-      auto command = parser->parse(lines[i]);
+template <typename Ground>
+void RobotSimulator::stepLoop(const Ground &bounds, std::size_t &lineNumber, int &errorNumber) {
+  // Run on the packed 32-bit state when the ground fits in its coordinate fields (its MOVE is bounds only)
+  if (PackedRobot::fits(bounds.getRows(), bounds.getCols()) && !bounds.hasObstacles()) {
+    PackedRobot packed = PackedRobot::fromRobot(robot);
+    stepLoop(bounds, packed, lineNumber, errorNumber);
+    robot = packed.toRobot();
+  } else {
+    stepLoop(bounds, robot, lineNumber, errorNumber);
+  }
+}
 
-      // Execute command
-      command->execute(robot, *ground);
+template <typename Ground, typename State>
+void RobotSimulator::stepLoop(const Ground &bounds, State &state, std::size_t &lineNumber, int &errorNumber) {
+  std::string_view line;
+  ParsedCommand    decoded;
 
-    } catch (const ParseException &e) {
-      logger.error("Parse error on line " + std::to_string(i + 1) + ": " + e.what());
-      errorNumber++;
-    } catch (const InvalidInputException &e) {
-      logger.error("Execution error on line " + std::to_string(i + 1) + ": " + e.what());
+  // Pull one command at a time: memory stays constant and each command runs as soon as it is read.
+  // Text readers decode without allocating; pre-compiled readers skip parsing altogether.
+  while (reader->nextCommand(*parser, decoded, line)) {
+    executeLine(bounds, state, ++lineNumber, decoded, line, errorNumber);
+  }
+}
+
+void RobotSimulator::runTable(std::size_t &lineNumber, int &errorNumber) {
+  // Per-command info messages come from CommandExecutor, so there is nothing to gain from the table
+  if (logger.isEnabled(LogLevel::INFO)) {
+    runStepwise(lineNumber, errorNumber);
+    return;
+  }
+
+  if (!TableExecutor::fits(*ground)) {
+    logger.warning("Ground is too large for transition tables, running step by step");
+    runStepwise(lineNumber, errorNumber);
+    return;
+  }
+
+  TableExecutor    table(*ground);
+  RobotState       state = table.encode(robot);
+  std::string_view line;
+  ParsedCommand    decoded;
+
+  while (reader->nextCommand(*parser, decoded, line)) {
+    ++lineNumber;
+    if (checkDecoded(lineNumber, decoded, line, errorNumber)) {
+      checkResult(table.tryExecute(decoded, state, lineNumber), *ground, errorNumber);
+    }
+  }
+
+  robot = table.decode(state);
+}
+
+void RobotSimulator::runFleet(std::size_t &lineNumber, int &errorNumber) {
+  RobotFleet       fleet(*ground);
+  std::string_view line;
+  std::string_view text;
+  std::uint32_t    target = 0;
+
+  auto onFailure = [&](const ExecutionResult &result) { checkFleetResult(result, errorNumber); };
+
+  while (reader->nextLine(line)) {
+    ++lineNumber;
+    if (RobotFleet::parseAddress(line, target, text) != RobotFleet::Address::OK) {
+      if (logger.isEnabled(LogLevel::ERROR)) {
+        logger.error("Parse error on line " + std::to_string(lineNumber) + ": Invalid robot id in '" +
+                     std::string(line) + "' (ids are 0 to " + std::to_string(RobotFleet::MAX_ROBOTS - 1) + ")");
+      }
       errorNumber++;
+      continue;
+    }
+
+    ParsedCommand decoded = parser->decode(text);
+    if (!checkDecoded(lineNumber, decoded, text, errorNumber)) {
+      continue;
+    }
+
+    if (target == RobotFleet::ALL_ROBOTS) {
+      fleet.tick(decoded, lineNumber, onFailure);
+    } else {
+      onFailure(fleet.tryExecute(target, decoded, lineNumber));
     }
   }
 
-  logger.info("Simulation completed with " + std::to_string(errorNumber) + " Errors.");
+  if (logger.isEnabled(LogLevel::INFO)) {
+    logger.info("Fleet of " + std::to_string(fleet.size()) + " robots, " + std::to_string(fleet.placedCount()) +
+                " placed");
+  }
+}
+
+void RobotSimulator::runLockstep(std::size_t &lineNumber, int &errorNumber) {
+  // Without starts the stream drives a single robot, like the step engine
+  LockstepEngine   lockstep(*ground, starts.empty() ? std::vector<Robot>{robot} : starts);
+  std::string_view line;
+  ParsedCommand    decoded;
+
+  if (logger.isEnabled(LogLevel::INFO)) {
+    logger.info("Lockstep run of " + std::to_string(lockstep.size()) + " robots with " +
+                toString(lockstep.getKernel()) + " kernels");
+  }
+
+  while (reader->nextCommand(*parser, decoded, line)) {
+    ++lineNumber;
+    if (checkDecoded(lineNumber, decoded, line, errorNumber)) {
+      checkLockstepResult(lockstep.execute(decoded, lineNumber), decoded, lockstep, errorNumber);
+    }
+  }
+
+  if (starts.empty()) {
+    robot = lockstep.robot(0);
+  }
+}
+
+void RobotSimulator::runCompiled(std::size_t &lineNumber, int &errorNumber) {
+  Program program = compileProgram(*reader, *parser);
+  lineNumber      = program.lineCount();
+
+  if (optimizations.eliminateDeadCode) {
+    EliminationStats stats = program.eliminateDeadCommands(*ground, logger.isEnabled(LogLevel::ERROR));
+    if (logger.isEnabled(LogLevel::INFO)) {
+      logger.info("Dead-command elimination removed " + std::to_string(stats.removed) + " of " +
+                  std::to_string(stats.commands) + " commands (" + std::to_string(stats.failures) +
+                  " errors counted without executing)");
+    }
+  }
+
+  // Per-command info messages come from CommandExecutor, so step through the program instead
+  if (logger.isEnabled(LogLevel::INFO)) {
+    const std::vector<Instruction> &code = program.instructions();
+    for (std::size_t pc = 0; pc + 1 < code.size(); ++pc) {
+      std::size_t line = program.lineOf(pc);
+      if (code[pc].op == VmOp::FAIL) {
+        vm.logFailure(program, line, Program::failedState(code[pc]), *ground);
+        errorNumber += static_cast<int>(code[pc].operand);
+      } else {
+        executeLine(*ground, robot, line + 1, program.command(line), program.source(line), errorNumber);
+      }
+    }
+    return;
+  }
+
+  // The segment engine works on fused legs
+  if (optimizations.fuseRuns || engine == Engine::SEGMENT) {
+    program.fuseRuns();
+  }
+
+  if (engine == Engine::SEGMENT) {
+    SegmentEngine segmentEngine(program);
+    errorNumber += segmentEngine.run(robot, *ground);
+    return;
+  }
+
+  errorNumber += vm.run(program, robot, *ground);
+}
+
+template <typename Ground, typename State>
+void RobotSimulator::executeLine(const Ground &bounds, State &state, std::size_t lineNumber,
+                                 const ParsedCommand &decoded, std::string_view line, int &errorNumber) {
+  if (!checkDecoded(lineNumber, decoded, line, errorNumber)) {
+    return;
+  }
+
+  // Execute command by value: no Command object allocation, no virtual call, no throw
+  checkResult(executor.tryExecute(decoded, state, bounds, lineNumber), bounds, errorNumber);
+}
+
+bool RobotSimulator::checkDecoded(std::size_t lineNumber, const ParsedCommand &decoded, std::string_view line,
+                                  int &errorNumber) {
+  if (logger.isEnabled(LogLevel::DEBUG)) {
+    logger.debug("Parsing command: " + (line.empty() && decoded.ok() ? toString(decoded) : std::string(line)));
+  }
+
+  // The error text is only built when it gets logged
+  if (!decoded.ok()) {
+    if (logger.isEnabled(LogLevel::ERROR)) {
+      ParseException e(CommandFactory::describe(decoded, line));
+      logger.error("Parse error on line " + std::to_string(lineNumber) + ": " + e.what());
+    }
+    errorNumber++;
+    return false;
+  }
+  return true;
+}
+
+template <typename Ground>
+void RobotSimulator::checkResult(const ExecutionResult &result, const Ground &bounds, int &errorNumber) {
+  if (!result.ok()) {
+    if (logger.isEnabled(LogLevel::ERROR)) {
+      InvalidInputException e(CommandExecutor::describe(result, bounds));
+      logger.error("Execution error on line " + std::to_string(result.line) + ": " + e.what());
+    }
+    errorNumber++;
+  }
+}
+
+void RobotSimulator::checkLockstepResult(const LockstepResult &result, const ParsedCommand &command,
+                                         const LockstepEngine &lockstep, int &errorNumber) {
+  if (result.failures() == 0) {
+    return;
+  }
+
+  // A lone robot is left unchanged by its failed command: replay it on the reference path, which logs it like
+  // the step engine does
+  if (lockstep.size() == 1) {
+    Robot replay = lockstep.robot(0);
+    checkResult(executor.tryExecute(command, replay, *ground, result.line), *ground, errorNumber);
+    return;
+  }
+
+  errorNumber += static_cast<int>(result.failures());
+  if (!logger.isEnabled(LogLevel::ERROR)) {
+    return;
+  }
+
+  std::size_t robots = lockstep.size();
+
+  auto logFailure = [&](const std::string &message, std::uint32_t count) {
+    logger.error("Execution error on line " + std::to_string(result.line) + ": " + message + " (" +
+                 std::to_string(count) + " of " + std::to_string(robots) + " robots)");
+  };
+
+  ExecutionResult single;
+  single.opcode   = result.opcode;
+  single.position = result.position;
+
+  if (result.notPlaced > 0) {
+    single.error = ExecutionError::NOT_PLACED;
+    logFailure(CommandExecutor::describe(single, *ground), result.notPlaced);
+  }
+  if (result.blocked > 0 && result.opcode == Opcode::PLACE) {
+    single.error = ground->isInside(result.position) ? ExecutionError::OBSTACLE : ExecutionError::PLACE_OUT_OF_BOUNDS;
+    logFailure(CommandExecutor::describe(single, *ground), result.blocked);
+  } else if (result.blocked > 0) {
+    logFailure(ground->hasObstacles() ? "Cannot move: position out of bounds or blocked by an obstacle"
+                                      : "Cannot move: position out of bounds",
+               result.blocked);
+  }
+}
+
+void RobotSimulator::checkFleetResult(const ExecutionResult &result, int &errorNumber) {
+  if (!result.ok()) {
+    if (logger.isEnabled(LogLevel::ERROR)) {
+      InvalidInputException e(CommandExecutor::describe(result, *ground));
+      logger.error("Execution error on line " + std::to_string(result.line) + " (robot " +
+                   std::to_string(result.robot) + "): " + e.what());
+    }
+    errorNumber++;
+  }
 }
 
 } // namespace simulator
@@ -0,0 +1,223 @@
+#include "SegmentEngine.hpp"
+
+#include <algorithm>
+
+namespace simulator {
+
+namespace {
+
+bool isMovement(VmOp op) {
+  return op == VmOp::MOVE || op == VmOp::MOVE_N || op == VmOp::LEFT || op == VmOp::RIGHT || op == VmOp::TURN;
+}
+
+// Lines covered by one movement instruction
+std::uint32_t lineSpan(const Instruction &instruction) {
+  return instruction.op == VmOp::MOVE_N || instruction.op == VmOp::TURN ? instruction.operand : 1;
+}
+
+// Quarter turns to the right applied by a rotation instruction
+unsigned turnsOf(const Instruction &instruction) {
+  switch (instruction.op) {
+  case VmOp::LEFT:
+    return 3;
+  case VmOp::RIGHT:
+    return 1;
+  case VmOp::TURN:
+    return instruction.direction;
+  default:
+    return 0;
+  }
+}
+
+Robot toRobot(bool placed, Coordinate x, Coordinate y, unsigned direction) {
+  Robot robot;
+  if (placed) {
+    robot.place(Position(x, y), static_cast<Direction>(direction));
+  }
+  return robot;
+}
+
+} // namespace
+
+SegmentEngine::SegmentEngine(const Program &program)
+  : program(program)
+  , logger(Logger::getInstance())
+  , output(OutputSink::getInstance()) {
+  const std::vector<Instruction> &code = program.instructions();
+
+  for (std::size_t pc = 0; pc < code.size();) {
+    if (!isMovement(code[pc].op)) {
+      ++pc;
+      continue;
+    }
+
+    // In the entry frame, facing `turns` quarter turns to the right moves a step of
+    // (DELTA_Y[turns], DELTA_X[turns]) cells (ahead, right)
+    Segment  segment;
+    unsigned turns = 0;
+    segment.begin  = pc;
+    for (; pc < code.size() && isMovement(code[pc].op); ++pc) {
+      const Instruction &instruction = code[pc];
+      segment.lines += lineSpan(instruction);
+
+      if (instruction.op == VmOp::MOVE || instruction.op == VmOp::MOVE_N) {
+        std::int64_t steps = lineSpan(instruction);
+        segment.netForward += DELTA_Y[turns] * steps;
+        segment.netRight += DELTA_X[turns] * steps;
+        segment.minForward = std::min(segment.minForward, segment.netForward);
+        segment.maxForward = std::max(segment.maxForward, segment.netForward);
+        segment.minRight   = std::min(segment.minRight, segment.netRight);
+        segment.maxRight   = std::max(segment.maxRight, segment.netRight);
+      } else {
+        turns = (turns + turnsOf(instruction)) & 3;
+      }
+    }
+    segment.end      = pc;
+    segment.netTurns = turns;
+    segments.push_back(segment);
+  }
+}
+
+int SegmentEngine::run(Robot &robot, const SimulatorGround &ground) const {
+  const std::vector<Instruction> &code = program.instructions();
+
+  State state;
+  state.placed = robot.hasPlaced();
+  if (state.placed) {
+    state.x         = robot.getPosition().x;
+    state.y         = robot.getPosition().y;
+    state.direction = static_cast<unsigned>(robot.getDirection());
+  }
+
+  int         errors      = 0;
+  std::size_t nextSegment = 0;
+
+  for (std::size_t pc = 0;;) {
+    if (nextSegment < segments.size() && segments[nextSegment].begin == pc) {
+      runSegment(segments[nextSegment], state, ground, errors);
+      pc = segments[nextSegment++].end;
+      continue;
+    }
+
+    const Instruction &instruction = code[pc];
+    switch (instruction.op) {
+    case VmOp::PLACE:
+      if (ground.isValidPosition(Position(instruction.x, instruction.y))) {
+        state = State{true, instruction.x, instruction.y, instruction.direction};
+      } else {
+        fail(program.lineOf(pc), 1, state, ground, errors);
+      }
+      break;
+    case VmOp::REPORT:
+      if (state.placed) {
+        output.report(program.lineOf(pc) + 1, Position(state.x, state.y), static_cast<Direction>(state.direction));
+      } else if (logger.isEnabled(LogLevel::WARNING)) {
+        logger.warning("REPORT command called but robot has not placed");
+      }
+      break;
+    case VmOp::PARSE_ERROR:
+      fail(program.lineOf(pc), 1, state, ground, errors);
+      break;
+    case VmOp::FAIL:
+      errors += static_cast<int>(instruction.operand);
+      if (logger.isEnabled(LogLevel::ERROR)) {
+        vm.logFailure(program, program.lineOf(pc), Program::failedState(instruction), ground);
+      }
+      break;
+    case VmOp::HALT:
+      robot = toRobot(state.placed, state.x, state.y, state.direction);
+      output.flush();
+      return errors;
+    default: // Movement instructions always belong to a segment
+      break;
+    }
+    ++pc;
+  }
+}
+
+void SegmentEngine::runSegment(const Segment &segment, State &state, const SimulatorGround &ground,
+                               int &errors) const {
+  if (!state.placed) {
+    // Every line of the segment fails the same way
+    if (!logger.isEnabled(LogLevel::ERROR)) {
+      errors += static_cast<int>(segment.lines);
+      return;
+    }
+    for (std::size_t pc = segment.begin; pc < segment.end; ++pc) {
+      fail(program.lineOf(pc), lineSpan(program.instructions()[pc]), state, ground, errors);
+    }
+    return;
+  }
+
+  // Ahead and right unit vectors of the entry direction
+  const std::int64_t aheadX = DELTA_X[state.direction];
+  const std::int64_t aheadY = DELTA_Y[state.direction];
+  const std::int64_t rightX = DELTA_X[(state.direction + 1) & 3];
+  const std::int64_t rightY = DELTA_Y[(state.direction + 1) & 3];
+
+  const std::int64_t lowX = state.x + std::min(aheadX * segment.minForward, aheadX * segment.maxForward) +
+                            std::min(rightX * segment.minRight, rightX * segment.maxRight);
+  const std::int64_t highX = state.x + std::max(aheadX * segment.minForward, aheadX * segment.maxForward) +
+                             std::max(rightX * segment.minRight, rightX * segment.maxRight);
+  const std::int64_t lowY = state.y + std::min(aheadY * segment.minForward, aheadY * segment.maxForward) +
+                            std::min(rightY * segment.minRight, rightY * segment.maxRight);
+  const std::int64_t highY = state.y + std::max(aheadY * segment.minForward, aheadY * segment.maxForward) +
+                             std::max(rightY * segment.minRight, rightY * segment.maxRight);
+
+  // The whole path stays on the ground and its bounding box is free of obstacles: no move can fail
+  const ObstacleMap *obstacles = ground.getObstacles();
+  if (lowX >= 0 && highX < ground.getCols() && lowY >= 0 && highY < ground.getRows() &&
+      (obstacles == nullptr || obstacles->isClear(lowX, lowY, highX, highY))) {
+    state.x += aheadX * segment.netForward + rightX * segment.netRight;
+    state.y += aheadY * segment.netForward + rightY * segment.netRight;
+    state.direction = (state.direction + segment.netTurns) & 3;
+    return;
+  }
+
+  walkSegment(segment, state, ground, errors);
+}
+
+void SegmentEngine::walkSegment(const Segment &segment, State &state, const SimulatorGround &ground,
+                                int &errors) const {
+  const std::vector<Instruction> &code      = program.instructions();
+  const auto                      cols      = static_cast<std::uint64_t>(ground.getCols());
+  const auto                      rows      = static_cast<std::uint64_t>(ground.getRows());
+  const ObstacleMap              *obstacles = ground.getObstacles();
+
+  for (std::size_t pc = segment.begin; pc < segment.end; ++pc) {
+    const Instruction &instruction = code[pc];
+
+    if (instruction.op != VmOp::MOVE && instruction.op != VmOp::MOVE_N) {
+      state.direction = (state.direction + turnsOf(instruction)) & 3;
+      continue;
+    }
+
+    // Clamp the leg at the edge or the first obstacle; the remaining moves fail in place
+    std::uint32_t moves = lineSpan(instruction);
+    auto          steps = static_cast<std::uint32_t>(
+      std::min<std::uint64_t>(moves, stepsToEdge(state.x, state.y, state.direction, cols, rows)));
+    if (obstacles != nullptr) {
+      steps = obstacles->freeSteps(state.x, state.y, state.direction, steps);
+    }
+    state.x += DELTA_X[state.direction] * static_cast<Coordinate>(steps);
+    state.y += DELTA_Y[state.direction] * static_cast<Coordinate>(steps);
+    if (steps < moves) {
+      fail(program.lineOf(pc) + steps, moves - steps, state, ground, errors);
+    }
+  }
+}
+
+void SegmentEngine::fail(std::size_t line, std::uint64_t count, const State &state, const SimulatorGround &ground,
+                         int &errors) const {
+  errors += static_cast<int>(count);
+  if (!logger.isEnabled(LogLevel::ERROR)) {
+    return;
+  }
+
+  Robot robot = toRobot(state.placed, state.x, state.y, state.direction);
+  for (std::uint64_t i = 0; i < count; ++i) {
+    vm.logFailure(program, line + i, robot, ground);
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,87 @@
+#include "TableExecutor.hpp"
+
+#include <string>
+
+namespace simulator {
+
+TableExecutor::TableExecutor(const SimulatorGround &simulatorGround, std::size_t maxCells)
+  : ground(simulatorGround)
+  , unplacedState(0)
+  , logger(Logger::getInstance()) {
+
+  if (!fits(ground, maxCells)) {
+    throw InvalidInputException("Ground of " + std::to_string(ground.getCols()) + "x" +
+                                std::to_string(ground.getRows()) + " exceeds the transition table limit of " +
+                                std::to_string(maxCells) + " cells");
+  }
+
+  unplacedState = static_cast<RobotState>(ground.getRows() * ground.getCols() * 4);
+  transitions.resize(stateCount() * OPCODES);
+
+  for (RobotState state = 0; state < stateCount(); ++state) {
+    Transition *row = &transitions[state * OPCODES];
+
+    for (std::size_t opcode = 0; opcode < OPCODES; ++opcode) {
+      row[opcode].next = state;
+    }
+    row[static_cast<std::size_t>(Opcode::INVALID)].error = ExecutionError::INVALID_COMMAND;
+
+    if (state == unplacedState) {
+      row[static_cast<std::size_t>(Opcode::MOVE)].error  = ExecutionError::NOT_PLACED;
+      row[static_cast<std::size_t>(Opcode::LEFT)].error  = ExecutionError::NOT_PLACED;
+      row[static_cast<std::size_t>(Opcode::RIGHT)].error = ExecutionError::NOT_PLACED;
+      continue;
+    }
+
+    Robot robot = decode(state);
+
+    Position next = robot.calculateNextPosition();
+    if (ground.isValidPosition(next)) {
+      Robot moved = robot;
+      moved.move();
+      row[static_cast<std::size_t>(Opcode::MOVE)].next = encode(moved);
+    } else {
+      row[static_cast<std::size_t>(Opcode::MOVE)].error =
+        ground.isInside(next) ? ExecutionError::OBSTACLE : ExecutionError::MOVE_OUT_OF_BOUNDS;
+    }
+
+    Robot left = robot;
+    left.rotateLeft();
+    row[static_cast<std::size_t>(Opcode::LEFT)].next = encode(left);
+
+    Robot right = robot;
+    right.rotateRight();
+    row[static_cast<std::size_t>(Opcode::RIGHT)].next = encode(right);
+  }
+}
+
+RobotState TableExecutor::encode(const Robot &robot) const {
+  if (!robot.hasPlaced()) {
+    return unplacedState;
+  }
+
+  Position position = robot.getPosition();
+  auto     cell     = static_cast<RobotState>(position.y * ground.getCols() + position.x);
+  return cell * 4 + static_cast<RobotState>(robot.getDirection());
+}
+
+Robot TableExecutor::decode(RobotState state) const {
+  Robot robot;
+  if (state != unplacedState) {
+    auto cols = static_cast<RobotState>(ground.getCols());
+    auto cell = state / 4;
+    robot.place(Position(static_cast<Coordinate>(cell % cols), static_cast<Coordinate>(cell / cols)),
+                static_cast<Direction>(state % 4));
+  }
+  return robot;
+}
+
+ExecutionResult TableExecutor::executeSlow(const ParsedCommand &command, RobotState &state,
+                                           std::size_t line) const {
+  Robot           robot  = decode(state);
+  ExecutionResult result = executor.tryExecute(command, robot, ground, line);
+  state                  = encode(robot);
+  return result;
+}
+
+} // namespace simulator
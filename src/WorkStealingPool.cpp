@@ -0,0 +1,94 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace simulator {
+
+WorkStealingPool::WorkStealingPool(unsigned threads)
+  : threadCount(threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency())) {
+  blocks.reserve(threadCount);
+  for (unsigned i = 0; i < threadCount; ++i) {
+    blocks.push_back(std::make_unique<Block>());
+  }
+}
+
+void WorkStealingPool::run(std::size_t count, const std::function<void(std::size_t)> &job) {
+  failed.store(false);
+  steals.store(0);
+  error = nullptr;
+
+  for (unsigned i = 0; i < threadCount; ++i) {
+    blocks[i]->begin = count * i / threadCount;
+    blocks[i]->end   = count * (i + 1) / threadCount;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount - 1);
+  for (unsigned i = 1; i < threadCount; ++i) {
+    workers.emplace_back(&WorkStealingPool::worker, this, i, std::cref(job));
+  }
+
+  worker(0, job);
+
+  for (auto &thread : workers) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void WorkStealingPool::worker(unsigned self, const std::function<void(std::size_t)> &job) {
+  std::size_t index = 0;
+
+  // Stolen ranges move between blocks under both locks, so an empty scan means no job is left to start
+  while (!failed.load(std::memory_order_relaxed) && (take(self, index) || steal(self, index))) {
+    try {
+      job(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      failed.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
+bool WorkStealingPool::take(unsigned self, std::size_t &index) {
+  Block                      &own = *blocks[self];
+  std::lock_guard<std::mutex> lock(own.mutex);
+  if (own.begin == own.end) {
+    return false;
+  }
+  index = own.begin++;
+  return true;
+}
+
+bool WorkStealingPool::steal(unsigned self, std::size_t &index) {
+  Block &own = *blocks[self];
+
+  for (unsigned i = 1; i < threadCount; ++i) {
+    Block           &victim = *blocks[(self + i) % threadCount];
+    std::scoped_lock lock(victim.mutex, own.mutex);
+
+    std::size_t remaining = victim.end - victim.begin;
+    if (remaining == 0) {
+      continue;
+    }
+
+    // Take the back half, so the victim keeps the jobs it is about to run
+    own.end    = victim.end;
+    own.begin  = victim.end - (remaining + 1) / 2;
+    victim.end = own.begin;
+    index      = own.begin++;
+    steals.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  return false;
+}
+
+} // namespace simulator
@@ -2,14 +2,59 @@
 #include <memory>
 
 #include "ArgParser.hpp"
+#include "BatchRunner.hpp"
+#include "BinaryScript.hpp"
+#include "CachingCommandFactory.hpp"
 #include "CommandFactory.hpp"
+#include "CompressedFileReader.hpp"
 #include "ConsoleReader.hpp"
 #include "FileReader.hpp"
 #include "InputReader.hpp"
+#include "LockstepEngine.hpp"
 #include "Logger.hpp"
+#include "MappedFileReader.hpp"
+#include "ObstacleMap.hpp"
+#include "OutputSink.hpp"
+#include "ParallelParseReader.hpp"
+#include "PipeReader.hpp"
+#include "PipelinedReader.hpp"
 #include "RobotSimulator.hpp"
 #include "SimulatorException.hpp"
 
+namespace {
+
+// Reader for a text script, honouring the --io mode
+std::unique_ptr<simulator::InputReader> makeTextReader(const std::string &filepath, simulator::IoMode mode) {
+  if (mode == simulator::IoMode::MMAP) {
+    return std::make_unique<simulator::MappedFileReader>(filepath);
+  }
+  return std::make_unique<simulator::FileReader>(filepath);
+}
+
+// --batch: run every script of a directory or manifest on a thread pool
+void runBatch(const simulator::ArgParser &argParser, const simulator::SimulatorGround &ground,
+              std::shared_ptr<const simulator::ObstacleMap> obstacles) {
+  simulator::Logger &logger = simulator::Logger::getInstance();
+
+  if (argParser.hasInputFile() || argParser.isPipeInput()) {
+    throw simulator::InvalidInputException("--batch cannot be combined with --file or --pipe");
+  }
+  if (argParser.getParseCacheSize() > 0) {
+    throw simulator::InvalidInputException("--parse-cache cannot be combined with --batch");
+  }
+
+  std::vector<std::string> scripts = simulator::BatchRunner::collectScripts(argParser.getBatchPath());
+  simulator::BatchRunner   runner(argParser.getEngine(), argParser.getOptimizations(), argParser.getIoMode(),
+                                  argParser.getThreads(), ground.getRows(), ground.getCols());
+  runner.setObstacles(std::move(obstacles));
+  simulator::BatchStats stats = runner.run(scripts);
+
+  logger.info("Batch of " + std::to_string(stats.scripts) + " scripts finished on " + std::to_string(stats.threads) +
+              " threads (" + std::to_string(stats.steals) + " steals), " + std::to_string(stats.failed) + " failed");
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
   try {
     simulator::ArgParser argParser(argc, argv);
@@ -27,27 +72,136 @@ int main(int argc, char *argv[]) {
     logger.info("Simulator started");
     logger.debug("Log level set to: " + logger.getLogLevelAsString());
 
+    // Compile mode: translate a text script to .rbc and exit
+    if (argParser.isCompileMode()) {
+      if (!argParser.hasOutputFile()) {
+        throw simulator::InvalidInputException("--compile requires an output file: -o <filename>");
+      }
+
+      auto                      source = makeTextReader(argParser.getCompileFile(), argParser.getIoMode());
+      simulator::CommandFactory factory;
+      auto                      records = simulator::compileScript(*source, factory, argParser.getOutputFile());
+
+      std::cout << "Compiled " << records << " lines to " << argParser.getOutputFile() << '\n';
+      return 0;
+    }
+
+    simulator::Engine engine   = argParser.getEngine();
+    bool              compiled = engine == simulator::Engine::VM || engine == simulator::Engine::SEGMENT;
+    if (argParser.getOptimizations().any() && !compiled) {
+      throw simulator::InvalidInputException("--optimize requires a compiled engine: --engine=vm or --engine=segment");
+    }
+
+    // REPORT results are buffered; interactive mode writes each one as soon as it is produced
+    simulator::OutputSink &output = simulator::OutputSink::getInstance();
+    if (argParser.getOutputFormat() == simulator::OutputFormat::BINARY && !argParser.hasOutputFile()) {
+      throw simulator::InvalidInputException("--output-format=binary requires --output <file>");
+    }
+    if (argParser.hasOutputFile()) {
+      output.openFile(argParser.getOutputFile());
+    }
+    if (argParser.hasStartsFile() && engine != simulator::Engine::LOCKSTEP) {
+      throw simulator::InvalidInputException("--starts requires --engine=lockstep");
+    }
+    // The cache is the factory the simulator decodes with; these readers decode on their own threads
+    if (argParser.getParseCacheSize() > 0 && (argParser.getParseThreads() > 0 || argParser.getPipelineDepth() > 0)) {
+      throw simulator::InvalidInputException("--parse-cache cannot be combined with --parse-threads or --pipeline");
+    }
+    output.setRobotIds(engine == simulator::Engine::FLEET || argParser.hasStartsFile());
+    output.setFormat(argParser.getOutputFormat());
+    output.setInteractive(argParser.isInteractive() ||
+                          (!argParser.hasInputFile() && !argParser.isPipeInput() && !argParser.isBatchMode()));
+
+    // Loaded once; every ground of the run shares it read-only
+    std::shared_ptr<const simulator::ObstacleMap> obstacles;
+    if (argParser.hasMapFile()) {
+      obstacles = simulator::ObstacleMap::load(argParser.getMapFile(), argParser.getGroundRows(),
+                                               argParser.getGroundCols());
+      logger.info("Loaded " + std::to_string(obstacles->getCols()) + "x" + std::to_string(obstacles->getRows()) +
+                  (obstacles->isDense() ? "" : " sparse") + " obstacle map with " +
+                  std::to_string(obstacles->blockedCount()) + " blocked cells");
+    }
+
+    // Ground size: --ground, else the size of a grid map, else 5x5
+    simulator::Coordinate rows = 5;
+    simulator::Coordinate cols = 5;
+    if (argParser.hasGroundSize()) {
+      rows = argParser.getGroundRows();
+      cols = argParser.getGroundCols();
+    } else if (obstacles != nullptr) {
+      rows = obstacles->getRows();
+      cols = obstacles->getCols();
+    }
+    auto ground = std::make_unique<simulator::SimulatorGround>(rows, cols);
+    ground->setObstacles(obstacles);
+
+    if (argParser.isBatchMode()) {
+      runBatch(argParser, *ground, std::move(obstacles));
+      return 0;
+    }
+
     // Create reader based on input arguments
     std::unique_ptr<simulator::InputReader> reader;
 
     if (argParser.hasInputFile()) {
       std::string filepath = argParser.getInputFile();
       logger.info("Reading from file: " + filepath);
-      reader = std::make_unique<simulator::FileReader>(filepath);
+      if (simulator::BinaryScriptReader::isBinaryScript(filepath)) {
+        if (argParser.getParseCacheSize() > 0) {
+          throw simulator::InvalidInputException("--parse-cache does not apply to compiled .rbc scripts");
+        }
+        reader = std::make_unique<simulator::BinaryScriptReader>(filepath);
+      } else if (simulator::CompressedFileReader::detect(filepath) != simulator::Compression::NONE) {
+        reader = std::make_unique<simulator::CompressedFileReader>(filepath);
+      } else if (argParser.getParseThreads() > 0) {
+        reader = std::make_unique<simulator::ParallelParseReader>(filepath, argParser.getParseThreads());
+      } else {
+        reader = makeTextReader(filepath, argParser.getIoMode());
+      }
+    } else if (argParser.isPipeInput()) {
+      logger.info("Reading piped standard input until end of stream");
+      reader = std::make_unique<simulator::PipeReader>();
     } else {
       std::cout << "Enter lines (empty line to finish):\n";
       reader = std::make_unique<simulator::ConsoleReader>();
     }
 
-    auto commandFactory = std::make_unique<simulator::CommandFactory>();
-    auto ground         = std::make_unique<simulator::SimulatorGround>(5, 5);
+    // Overlap reading and parsing with execution on separate threads
+    if (argParser.getPipelineDepth() > 0) {
+      reader = std::make_unique<simulator::PipelinedReader>(std::move(reader), argParser.getPipelineDepth());
+    }
+
+    std::unique_ptr<simulator::CommandFactory> commandFactory;
+    simulator::CachingCommandFactory          *parseCache = nullptr;
+
+    if (argParser.getParseCacheSize() > 0) {
+      auto caching   = std::make_unique<simulator::CachingCommandFactory>(argParser.getParseCacheSize());
+      parseCache     = caching.get();
+      commandFactory = std::move(caching);
+    } else {
+      commandFactory = std::make_unique<simulator::CommandFactory>();
+    }
+
+    std::vector<simulator::Robot> starts;
+    if (argParser.hasStartsFile()) {
+      simulator::FileReader startsReader(argParser.getStartsFile());
+      starts = simulator::LockstepEngine::readStarts(startsReader, *commandFactory, *ground);
+    }
 
     // Create Robot simulator and pass reader ownership
-    simulator::RobotSimulator robotSimulator(std::move(reader), std::move(commandFactory), std::move(ground));
+    simulator::RobotSimulator robotSimulator(std::move(reader), std::move(commandFactory), std::move(ground),
+                                             argParser.getEngine(), argParser.getOptimizations(), std::move(starts));
 
     // Run the simulation
     robotSimulator.run();
 
+    if (parseCache != nullptr && logger.isEnabled(simulator::LogLevel::INFO)) {
+      simulator::ParseCacheStats stats = parseCache->getStats();
+      logger.info("Parse cache: " + std::to_string(stats.hits) + " hits, " + std::to_string(stats.misses) +
+                  " misses, " + std::to_string(stats.evictions) + " evictions, " + std::to_string(stats.uncached) +
+                  " uncached (" + std::to_string(stats.capacity) + " slots)");
+    }
+
   } catch (const simulator::InvalidInputException &e) {
     std::cerr << "Error: " << e.what() << '\n';
     return 1;
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "InputReader.hpp"
+
+namespace simulator {
+
+// In-memory InputReader over a fixed list of lines, shared by the engine tests
+class LineReader : public InputReader {
+public:
+  explicit LineReader(std::vector<std::string> lines) : lines(std::move(lines)) {}
+
+  bool nextLine(std::string_view &line) override {
+    if (next >= lines.size()) {
+      return false;
+    }
+    line = lines[next++];
+    return true;
+  }
+
+private:
+  std::vector<std::string> lines;
+  std::size_t              next = 0;
+};
+
+} // namespace simulator
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "Command.hpp"
+#include "OutputSink.hpp"
 #include "Robot.hpp"
 #include "SimulatorException.hpp"
 #include "SimulatorGround.hpp"
@@ -24,10 +25,13 @@ protected:
 
   void TearDown() override {
     // Restore std::cout
+    OutputSink::getInstance().flush();
     std::cout.rdbuf(oldCout);
   }
 
+  // REPORT results are buffered until flushed
   std::string getCapturedOutput() {
+    OutputSink::getInstance().flush();
     return capturedCout.str();
   }
 
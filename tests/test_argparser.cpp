@@ -134,6 +134,298 @@ TEST_F(ArgParserTest, ValidAllArgs) {
   EXPECT_EQ(parser.getLogLevel(), LogLevel::ERROR);
 }
 
+TEST_F(ArgParserTest, DefaultIoModeIsStream) {
+  const char *argv[] = {"simulator", "--file", "input.txt"};
+  ArgParser   parser(3, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_EQ(parser.getIoMode(), IoMode::STREAM);
+}
+
+TEST_F(ArgParserTest, ValidMmapIoModeArg) {
+  const char *argv[] = {"simulator", "--io=MMap"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_EQ(parser.getIoMode(), IoMode::MMAP);
+}
+
+TEST_F(ArgParserTest, MissingIoModeArg) {
+  const char *argv[] = {"simulator", "--io"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, EmptyIoModeArg) {
+  const char *argv[] = {"simulator", "--io="};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, InvalidIoModeArg) {
+  const char *argv[] = {"simulator", "--io=INVALID"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidCompileArgs) {
+  const char *argv[] = {"simulator", "--compile", "input.txt", "-o", "input.rbc"};
+  ArgParser   parser(5, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_TRUE(parser.isCompileMode());
+  EXPECT_EQ(parser.getCompileFile(), "input.txt");
+  EXPECT_TRUE(parser.hasOutputFile());
+  EXPECT_EQ(parser.getOutputFile(), "input.rbc");
+}
+
+TEST_F(ArgParserTest, MissingCompileArgValue) {
+  const char *argv[] = {"simulator", "--compile"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, MissingOutputArgValue) {
+  const char *argv[] = {"simulator", "--compile", "input.txt", "-o"};
+  ArgParser   parser(4, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidResultOutputArgs) {
+  const char *argv1[] = {"simulator", "--file", "input.txt", "--output", "results.txt"};
+  const char *argv2[] = {"simulator", "--pipe", "--interactive"};
+  ArgParser   parser1(5, const_cast<char **>(argv1));
+  ArgParser   parser2(3, const_cast<char **>(argv2));
+
+  parser1.parse();
+  parser2.parse();
+
+  EXPECT_EQ(parser1.getOutputFile(), "results.txt");
+  EXPECT_FALSE(parser1.isInteractive());
+  EXPECT_FALSE(parser2.hasOutputFile());
+  EXPECT_TRUE(parser2.isInteractive());
+}
+
+TEST_F(ArgParserTest, ValidOutputFormatArg) {
+  const char *argv1[] = {"simulator", "--output-format=jsonl"};
+  const char *argv2[] = {"simulator", "--output-format=CSV"};
+  const char *argv3[] = {"simulator", "--output-format=binary"};
+  const char *argv4[] = {"simulator"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+  ArgParser   parser3(2, const_cast<char **>(argv3));
+  ArgParser   parser4(1, const_cast<char **>(argv4));
+
+  parser1.parse();
+  parser2.parse();
+  parser3.parse();
+  parser4.parse();
+
+  EXPECT_EQ(parser1.getOutputFormat(), OutputFormat::JSONL);
+  EXPECT_EQ(parser2.getOutputFormat(), OutputFormat::CSV);
+  EXPECT_EQ(parser3.getOutputFormat(), OutputFormat::BINARY);
+  EXPECT_EQ(parser4.getOutputFormat(), OutputFormat::TEXT);
+}
+
+TEST_F(ArgParserTest, InvalidOutputFormatArg) {
+  const char *argv1[] = {"simulator", "--output-format=xml"};
+  const char *argv2[] = {"simulator", "--output-format"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, MissingResultOutputArgValue) {
+  const char *argv[] = {"simulator", "--file", "input.txt", "--output"};
+  ArgParser   parser(4, const_cast<char **>(argv));
+
+  EXPECT_THROW(parser.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidParseThreadsArg) {
+  const char *argv[] = {"simulator", "--parse-threads=8"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_EQ(parser.getParseThreads(), 8U);
+}
+
+TEST_F(ArgParserTest, InvalidParseThreadsArg) {
+  const char *argv1[] = {"simulator", "--parse-threads=abc"};
+  const char *argv2[] = {"simulator", "--parse-threads=-1"};
+  const char *argv3[] = {"simulator", "--parse-threads=4x"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+  ArgParser   parser3(2, const_cast<char **>(argv3));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+  EXPECT_THROW(parser3.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidPipelineArg) {
+  const char *argv[] = {"simulator", "--pipeline=1024"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_EQ(parser.getPipelineDepth(), 1024U);
+}
+
+TEST_F(ArgParserTest, InvalidPipelineArg) {
+  const char *argv1[] = {"simulator", "--pipeline=1000"};
+  const char *argv2[] = {"simulator", "--pipeline=0"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidParseCacheArg) {
+  const char *argv[] = {"simulator", "--parse-cache=4096"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_EQ(parser.getParseCacheSize(), 4096U);
+}
+
+TEST_F(ArgParserTest, InvalidParseCacheArg) {
+  const char *argv1[] = {"simulator", "--parse-cache"};
+  const char *argv2[] = {"simulator", "--parse-cache=many"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidEngineArg) {
+  const char *argv1[] = {"simulator", "--engine=vm"};
+  const char *argv2[] = {"simulator", "--engine=STEP"};
+  const char *argv3[] = {"simulator"};
+  const char *argv4[] = {"simulator", "--engine=segment"};
+  const char *argv5[] = {"simulator", "--engine=Table"};
+  const char *argv6[] = {"simulator", "--engine=fleet"};
+  const char *argv7[] = {"simulator", "--engine=LockStep", "--starts", "starts.txt"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+  ArgParser   parser3(1, const_cast<char **>(argv3));
+  ArgParser   parser4(2, const_cast<char **>(argv4));
+  ArgParser   parser5(2, const_cast<char **>(argv5));
+  ArgParser   parser6(2, const_cast<char **>(argv6));
+  ArgParser   parser7(4, const_cast<char **>(argv7));
+
+  parser1.parse();
+  parser2.parse();
+  parser3.parse();
+  parser4.parse();
+  parser5.parse();
+  parser6.parse();
+  parser7.parse();
+
+  EXPECT_EQ(parser1.getEngine(), Engine::VM);
+  EXPECT_EQ(parser2.getEngine(), Engine::STEP);
+  EXPECT_EQ(parser3.getEngine(), Engine::STEP);
+  EXPECT_EQ(parser4.getEngine(), Engine::SEGMENT);
+  EXPECT_EQ(parser5.getEngine(), Engine::TABLE);
+  EXPECT_EQ(parser6.getEngine(), Engine::FLEET);
+  EXPECT_EQ(parser7.getEngine(), Engine::LOCKSTEP);
+  EXPECT_TRUE(parser7.hasStartsFile());
+  EXPECT_EQ(parser7.getStartsFile(), "starts.txt");
+  EXPECT_FALSE(parser1.hasStartsFile());
+}
+
+TEST_F(ArgParserTest, InvalidEngineArg) {
+  const char *argv1[] = {"simulator", "--engine=jit"};
+  const char *argv2[] = {"simulator", "--engine"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidOptimizeArg) {
+  const char *argv1[] = {"simulator", "--optimize=fuse"};
+  const char *argv2[] = {"simulator"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(1, const_cast<char **>(argv2));
+
+  parser1.parse();
+  parser2.parse();
+
+  EXPECT_TRUE(parser1.getOptimizations().fuseRuns);
+  EXPECT_FALSE(parser2.getOptimizations().any());
+}
+
+TEST_F(ArgParserTest, InvalidOptimizeArg) {
+  const char *argv1[] = {"simulator", "--optimize=inline"};
+  const char *argv2[] = {"simulator", "--optimize"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  EXPECT_THROW(parser1.parse(), InvalidInputException);
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, ValidPipeArg) {
+  const char *argv[] = {"simulator", "--pipe"};
+  ArgParser   parser(2, const_cast<char **>(argv));
+
+  parser.parse();
+
+  EXPECT_TRUE(parser.isPipeInput());
+  EXPECT_FALSE(parser.hasInputFile());
+}
+
+TEST_F(ArgParserTest, MapArg) {
+  const char *argv1[] = {"simulator", "--map", "floor.txt"};
+  const char *argv2[] = {"simulator", "--map"};
+  ArgParser   parser1(3, const_cast<char **>(argv1));
+  ArgParser   parser2(2, const_cast<char **>(argv2));
+
+  parser1.parse();
+
+  EXPECT_TRUE(parser1.hasMapFile());
+  EXPECT_EQ(parser1.getMapFile(), "floor.txt");
+  EXPECT_THROW(parser2.parse(), InvalidInputException);
+}
+
+TEST_F(ArgParserTest, GroundArg) {
+  const char *argv1[] = {"simulator", "--ground=1099511627776x20"};
+  const char *argv2[] = {"simulator"};
+  ArgParser   parser1(2, const_cast<char **>(argv1));
+  ArgParser   parser2(1, const_cast<char **>(argv2));
+
+  parser1.parse();
+  parser2.parse();
+
+  EXPECT_TRUE(parser1.hasGroundSize());
+  EXPECT_EQ(parser1.getGroundCols(), 1099511627776);
+  EXPECT_EQ(parser1.getGroundRows(), 20);
+  EXPECT_FALSE(parser2.hasGroundSize());
+
+  for (const char *value : {"--ground", "--ground=", "--ground=10", "--ground=0x5", "--ground=5x-5", "--ground=5x+5",
+                            "--ground=1099511627777x5", "--ground=5x5x5", "--ground=ax5"}) {
+    const char *argv[] = {"simulator", value};
+    ArgParser   parser(2, const_cast<char **>(argv));
+    EXPECT_THROW(parser.parse(), InvalidInputException) << value;
+  }
+}
+
 TEST_F(ArgParserTest, UnknownArg) {
   const char *argv[] = {"simulator", "--unknown"};
   ArgParser   parser(2, const_cast<char **>(argv));
@@ -0,0 +1,153 @@
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BatchRunner.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class BatchRunnerTest : public ::testing::Test {
+protected:
+  std::string test_dir = "/tmp/batchRunnerTest_" + std::to_string(std::rand());
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir + "/scripts";
+    system(cmd.c_str());
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    OutputSink::getInstance().flush();
+    OutputSink::getInstance().setFormat(OutputFormat::TEXT);
+    std::cout.rdbuf(oldCout);
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath, std::ios::binary);
+    file << content;
+    return filepath;
+  }
+
+  // Script i ends at a position derived from i, so misordered output shows up
+  std::vector<std::string> createScripts(int count) {
+    std::vector<std::string> scripts;
+    for (int i = 0; i < count; ++i) {
+      std::string name = "scripts/s" + std::to_string(1000 + i) + ".txt";
+      scripts.push_back(createTestFile(name, "PLACE " + std::to_string(i % 5) + "," + std::to_string(i / 5 % 5) +
+                                                 ",NORTH\nMOVE\nRIGHT\nREPORT\n"));
+    }
+    return scripts;
+  }
+
+  std::string expectedOutput(const std::vector<std::string> &scripts) {
+    std::string expected;
+    for (std::size_t i = 0; i < scripts.size(); ++i) {
+      int y = static_cast<int>(i / 5 % 5);
+      expected += "== " + scripts[i] + " ==\n";
+      if (y == 4) {
+        expected += "Output: " + std::to_string(i % 5) + ",4,EAST\n";
+      } else {
+        expected += "Output: " + std::to_string(i % 5) + "," + std::to_string(y + 1) + ",EAST\n";
+      }
+    }
+    return expected;
+  }
+};
+
+TEST_F(BatchRunnerTest, CollectScriptsFromDirectoryIsSorted) {
+  createTestFile("scripts/b.txt", "REPORT\n");
+  createTestFile("scripts/a.txt", "REPORT\n");
+  system(("mkdir -p " + test_dir + "/scripts/nested").c_str());
+
+  std::vector<std::string> scripts = BatchRunner::collectScripts(test_dir + "/scripts");
+  ASSERT_EQ(scripts.size(), 2U);
+  EXPECT_EQ(scripts[0], test_dir + "/scripts/a.txt");
+  EXPECT_EQ(scripts[1], test_dir + "/scripts/b.txt");
+}
+
+TEST_F(BatchRunnerTest, CollectScriptsFromManifest) {
+  std::string manifest = createTestFile("manifest.txt", "# regression set\nscripts/x.txt\n\n  /abs/y.txt  \n");
+
+  std::vector<std::string> scripts = BatchRunner::collectScripts(manifest);
+  ASSERT_EQ(scripts.size(), 2U);
+  EXPECT_EQ(scripts[0], test_dir + "/scripts/x.txt");
+  EXPECT_EQ(scripts[1], "/abs/y.txt");
+
+  EXPECT_THROW(BatchRunner::collectScripts(test_dir + "/missing"), FileException);
+}
+
+TEST_F(BatchRunnerTest, OutputIsInScriptOrderOnAnyThreadCount) {
+  std::vector<std::string> scripts  = createScripts(200);
+  std::string              expected = expectedOutput(scripts);
+
+  for (unsigned threads : {1U, 3U, 8U}) {
+    capturedCout.str("");
+    BatchRunner runner(Engine::STEP, Optimizations(), IoMode::STREAM, threads);
+    BatchStats  stats = runner.run(scripts);
+
+    EXPECT_EQ(stats.scripts, 200U);
+    EXPECT_EQ(stats.failed, 0U);
+    EXPECT_EQ(stats.threads, threads);
+    EXPECT_EQ(capturedCout.str(), expected) << threads << " threads";
+  }
+}
+
+TEST_F(BatchRunnerTest, EnginesAgree) {
+  std::vector<std::string> scripts  = createScripts(20);
+  std::string              expected = expectedOutput(scripts);
+
+  for (Engine engine : {Engine::TABLE, Engine::FLEET, Engine::VM, Engine::SEGMENT}) {
+    capturedCout.str("");
+    BatchRunner runner(engine, Optimizations(), IoMode::MMAP, 4);
+    runner.run(scripts);
+    EXPECT_EQ(capturedCout.str(), expected);
+  }
+}
+
+TEST_F(BatchRunnerTest, LogLinesStayWithTheirScript) {
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+  std::string bad  = createTestFile("scripts/a.txt", "MOVE\nREPORT\n");
+  std::string good = createTestFile("scripts/b.txt", "PLACE 1,1,WEST\nREPORT\n");
+  std::string gone = test_dir + "/scripts/c.txt";
+
+  BatchRunner runner(Engine::STEP, Optimizations(), IoMode::STREAM, 3);
+  BatchStats  stats = runner.run({bad, good, gone});
+  EXPECT_EQ(stats.failed, 1U);
+
+  std::string out = std::regex_replace(capturedCout.str(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  std::size_t badError  = out.find("Execution error on line 1");
+  std::size_t goodStart = out.find("== " + good + " ==");
+  std::size_t goneError = out.find("Cannot run script " + gone);
+  ASSERT_NE(badError, std::string::npos);
+  ASSERT_NE(goodStart, std::string::npos);
+  ASSERT_NE(goneError, std::string::npos);
+  EXPECT_LT(out.find("== " + bad + " =="), badError);
+  EXPECT_LT(badError, goodStart);
+  EXPECT_LT(out.find("Output: 1,1,WEST"), goneError);
+}
+
+TEST_F(BatchRunnerTest, MachineFormatsHaveNoScriptHeaders) {
+  std::vector<std::string> scripts = createScripts(3);
+  OutputSink::getInstance().setFormat(OutputFormat::JSONL);
+
+  BatchRunner runner(Engine::STEP, Optimizations(), IoMode::STREAM, 2);
+  runner.run(scripts);
+
+  EXPECT_EQ(capturedCout.str(), "{\"line\":4,\"x\":0,\"y\":1,\"direction\":\"EAST\"}\n"
+                                "{\"line\":4,\"x\":1,\"y\":1,\"direction\":\"EAST\"}\n"
+                                "{\"line\":4,\"x\":2,\"y\":1,\"direction\":\"EAST\"}\n");
+}
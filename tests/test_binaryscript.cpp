@@ -0,0 +1,238 @@
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "BinaryScript.hpp"
+#include "CommandFactory.hpp"
+#include "FileReader.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class BinaryScriptTest : public ::testing::Test {
+protected:
+  std::string    test_dir = "/tmp/binaryScriptTest_" + std::to_string(std::rand());
+  CommandFactory factory;
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir;
+    system(cmd.c_str());
+  }
+
+  void TearDown() override {
+    // Clean up test directory using system call
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath, std::ios::binary);
+    if (file.is_open()) {
+      file << content;
+      file.close();
+    }
+    return filepath;
+  }
+
+  std::string compile(const std::string &content) {
+    std::string source = createTestFile("input.txt", content);
+    std::string target = test_dir + "/input.rbc";
+    FileReader  reader(source);
+
+    compileScript(reader, factory, target);
+    return target;
+  }
+
+  std::string readBytes(const std::string &filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  // Rewrite the payload size and checksum so an edited payload gets past open() to record decoding
+  static std::string reseal(std::string bytes) {
+    std::uint64_t size = bytes.size() - rbc::HEADER_SIZE;
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = rbc::HEADER_SIZE; i < bytes.size(); ++i) {
+      hash ^= static_cast<unsigned char>(bytes[i]);
+      hash *= 1099511628211ULL;
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+      bytes[16 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+      bytes[24 + i] = static_cast<char>((hash >> (8 * i)) & 0xFF);
+    }
+    return bytes;
+  }
+
+  // Decode the first record of `bytes` and return the FileException message, or "" when it decodes
+  std::string firstRecordError(const std::string &bytes) {
+    BinaryScriptReader reader(createTestFile("corrupt.rbc", bytes));
+    std::string_view   line;
+    try {
+      reader.nextLine(line);
+    } catch (const FileException &e) {
+      return e.what();
+    }
+    return "";
+  }
+};
+
+TEST_F(BinaryScriptTest, CompiledCommandsMatchTextDecode) {
+  std::vector<std::string> lines{"PLACE 1,2,NORTH", "move",   "LEFT", "RIGHT", "REPORT", "PLACE -3,40000,west",
+                                 "PLACE 1099511627775,-1099511627776,EAST"};
+  std::string              content;
+  for (const auto &line : lines) {
+    content += line + "\n";
+  }
+
+  BinaryScriptReader reader(compile(content));
+  ParsedCommand      command;
+  std::string_view   text;
+
+  for (const auto &line : lines) {
+    ASSERT_TRUE(reader.nextCommand(factory, command, text));
+    ParsedCommand expected = factory.decode(line);
+    EXPECT_EQ(command.opcode, expected.opcode);
+    EXPECT_EQ(command.position, expected.position);
+    EXPECT_EQ(command.direction, expected.direction);
+  }
+  EXPECT_FALSE(reader.nextCommand(factory, command, text));
+}
+
+TEST_F(BinaryScriptTest, EncodingIsCompact) {
+  std::string compiled = compile("PLACE 1,2,NORTH\nMOVE\nLEFT\nRIGHT\nREPORT\n");
+
+  // 3 bytes for PLACE, one byte for each of the other four commands
+  EXPECT_EQ(readBytes(compiled).size(), rbc::HEADER_SIZE + 3 + 4);
+}
+
+TEST_F(BinaryScriptTest, ParseErrorsKeepTheirText) {
+  BinaryScriptReader reader(compile("MOVE\n\njump high\n"));
+  ParsedCommand      command;
+  std::string_view   text;
+
+  ASSERT_TRUE(reader.nextCommand(factory, command, text));
+  EXPECT_TRUE(command.ok());
+
+  ASSERT_TRUE(reader.nextCommand(factory, command, text));
+  EXPECT_EQ(command.error, ParseError::EMPTY_COMMAND);
+
+  ASSERT_TRUE(reader.nextCommand(factory, command, text));
+  EXPECT_EQ(command.error, ParseError::UNKNOWN_COMMAND);
+  EXPECT_EQ(CommandFactory::describe(command, text), "Unknown command: JUMP HIGH");
+}
+
+TEST_F(BinaryScriptTest, NextLineRendersCanonicalText) {
+  BinaryScriptReader reader(compile("place 1 , 2 , north\nmove\nbogus\n"));
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], "PLACE 1,2,NORTH");
+  EXPECT_EQ(lines[1], "MOVE");
+  EXPECT_EQ(lines[2], "bogus");
+}
+
+TEST_F(BinaryScriptTest, DetectsBinaryScripts) {
+  std::string compiled = compile("MOVE\n");
+  std::string text     = createTestFile("plain.txt", "MOVE\n");
+
+  EXPECT_TRUE(BinaryScriptReader::isBinaryScript(compiled));
+  EXPECT_FALSE(BinaryScriptReader::isBinaryScript(text));
+  EXPECT_FALSE(BinaryScriptReader::isBinaryScript(test_dir + "/missing.rbc"));
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForCorruptPayload) {
+  std::string bytes = readBytes(compile("PLACE 1,2,NORTH\nMOVE\nREPORT\n"));
+  bytes.back()      = static_cast<char>(Opcode::LEFT);
+
+  BinaryScriptReader reader(createTestFile("corrupt.rbc", bytes));
+  std::string_view   line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForInvalidParseErrorByte) {
+  std::string bytes = readBytes(compile("JUMP\n"));
+  ASSERT_EQ(bytes[rbc::HEADER_SIZE], static_cast<char>(Opcode::INVALID));
+  EXPECT_EQ(firstRecordError(reseal(bytes)), "");
+
+  for (int error : {static_cast<int>(ParseError::NONE), static_cast<int>(ParseError::UNKNOWN_COMMAND) + 1, 0xFF}) {
+    bytes[rbc::HEADER_SIZE + 1] = static_cast<char>(error);
+    EXPECT_NE(firstRecordError(reseal(bytes)).find("corrupt record"), std::string::npos) << "error byte " << error;
+  }
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForNonCanonicalTag) {
+  for (const char *source : {"MOVE\n", "LEFT\n", "RIGHT\n", "REPORT\n", "JUMP\n"}) {
+    std::string bytes = readBytes(compile(source));
+    EXPECT_EQ(firstRecordError(reseal(bytes)), "") << source;
+
+    bytes[rbc::HEADER_SIZE] = static_cast<char>(bytes[rbc::HEADER_SIZE] | 0x50);
+    EXPECT_NE(firstRecordError(reseal(bytes)).find("corrupt record"), std::string::npos) << source;
+  }
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForVarintPast64Bits) {
+  std::string header = readBytes(compile("PLACE 1,2,NORTH\n")).substr(0, rbc::HEADER_SIZE + 1);
+
+  // Ten bytes carrying 64 bits decode; a 10th byte with higher bits or a continuation does not
+  std::string fits = header + std::string(9, '\xFF') + '\x01' + '\x00';
+  EXPECT_EQ(firstRecordError(reseal(fits)), "");
+
+  std::string overflow = header + std::string(9, '\xFF') + '\x02' + '\x00';
+  EXPECT_NE(firstRecordError(reseal(overflow)).find("corrupt record"), std::string::npos);
+
+  std::string tooLong = header + std::string(10, '\xFF') + '\x00' + '\x00';
+  EXPECT_NE(firstRecordError(reseal(tooLong)).find("corrupt record"), std::string::npos);
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForStaleVersion) {
+  std::string bytes = readBytes(compile("MOVE\n"));
+  bytes[4]          = static_cast<char>(rbc::VERSION + 1);
+
+  BinaryScriptReader reader(createTestFile("stale.rbc", bytes));
+  std::string_view   line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForTruncatedFile) {
+  std::string bytes = readBytes(compile("PLACE 1,2,NORTH\nMOVE\n"));
+  bytes.pop_back();
+
+  BinaryScriptReader reader(createTestFile("truncated.rbc", bytes));
+  std::string_view   line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+TEST_F(BinaryScriptTest, ThrowByReaderForTextFile) {
+  BinaryScriptReader reader(createTestFile("plain.txt", "PLACE 1,2,NORTH\nMOVE\nREPORT\nREPORT\nREPORT\nREPORT\n"));
+  std::string_view   line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+TEST_F(BinaryScriptTest, SimulatorRunsCompiledScript) {
+  std::string compiled = compile("PLACE 0,0,NORTH\nMOVE\nJUMP\nREPORT\n");
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  Logger::getInstance().setLogLevel(LogLevel::INFO);
+
+  RobotSimulator sim(std::make_unique<BinaryScriptReader>(compiled), std::make_unique<CommandFactory>(),
+                     std::make_unique<SimulatorGround>(5, 5));
+  sim.run();
+
+  std::cout.rdbuf(oldCout);
+  std::string output = capturedCout.str();
+  EXPECT_NE(output.find("Output: 0,1,NORTH"), std::string::npos);
+  EXPECT_NE(output.find("Parse error on line 3: Parse error: Unknown command: JUMP"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 1 Errors."), std::string::npos);
+}
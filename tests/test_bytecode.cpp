@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bytecode.hpp"
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorGround.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+class BytecodeTest : public ::testing::Test {
+protected:
+  CommandFactory factory;
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    std::cout.rdbuf(oldCout);
+  }
+
+  Program compile(const std::vector<std::string> &lines) {
+    LineReader reader(lines);
+    return compileProgram(reader, factory);
+  }
+
+  // Console output of a whole simulation, with log timestamps removed
+  std::string simulate(const std::vector<std::string> &lines, Engine engine,
+                       Optimizations optimizations = Optimizations()) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(3, 4), engine, optimizations);
+    sim.run();
+    return std::regex_replace(capturedCout.str(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  }
+};
+
+TEST_F(BytecodeTest, CompileOneInstructionPerLine) {
+  Program program = compile({"PLACE 1,2,EAST", "MOVE", "left", "RIGHT", "REPORT", "JUMP"});
+
+  ASSERT_EQ(program.lineCount(), 6U);
+  ASSERT_EQ(program.instructions().size(), 7U);
+  EXPECT_EQ(program.instructions()[0].op, VmOp::PLACE);
+  EXPECT_EQ(program.instructions()[0].x, 1);
+  EXPECT_EQ(program.instructions()[0].y, 2);
+  EXPECT_EQ(program.instructions()[2].op, VmOp::LEFT);
+  EXPECT_EQ(program.instructions()[5].op, VmOp::PARSE_ERROR);
+  EXPECT_EQ(program.instructions()[6].op, VmOp::HALT);
+}
+
+TEST_F(BytecodeTest, CompileEmptyInput) {
+  Program program = compile({});
+
+  EXPECT_EQ(program.lineCount(), 0U);
+  EXPECT_EQ(program.instructions().size(), 1U);
+}
+
+TEST_F(BytecodeTest, SourceKeptOnlyForParseErrors) {
+  Program program = compile({"PLACE 1,2,EAST", "PLACE 1,2,UP"});
+
+  EXPECT_EQ(program.source(0), "");
+  EXPECT_EQ(program.source(1), "PLACE 1,2,UP");
+  EXPECT_EQ(program.command(0).opcode, Opcode::PLACE);
+  EXPECT_EQ(program.command(0).direction, Direction::EAST);
+  EXPECT_EQ(program.command(0).position, Position(1, 2));
+  EXPECT_EQ(program.command(1).error, ParseError::INVALID_DIRECTION);
+  EXPECT_EQ(CommandFactory::describe(program.command(1), program.source(1)),
+            "Invalid direction: UP. Must be NORTH, EAST, SOUTH, or WEST");
+}
+
+TEST_F(BytecodeTest, RunUpdatesRobotAndCountsErrors) {
+  Program         program = compile({"MOVE", "PLACE 0,0,NORTH", "MOVE", "MOVE", "RIGHT", "MOVE", "REPORT", "JUMP"});
+  Robot           robot;
+  SimulatorGround ground(2, 2);
+  BytecodeVM      vm;
+
+  EXPECT_EQ(vm.run(program, robot, ground), 3);
+  EXPECT_EQ(robot.getPosition(), Position(1, 1));
+  EXPECT_EQ(robot.getDirection(), Direction::EAST);
+  EXPECT_EQ(capturedCout.str(), "Output: 1,1,EAST\n");
+}
+
+TEST_F(BytecodeTest, RunWithoutPlaceLeavesRobotUnplaced) {
+  Program         program = compile({"MOVE", "LEFT", "REPORT", "PLACE 9,9,NORTH"});
+  Robot           robot;
+  SimulatorGround ground(5, 5);
+  BytecodeVM      vm;
+
+  EXPECT_EQ(vm.run(program, robot, ground), 3);
+  EXPECT_FALSE(robot.hasPlaced());
+  EXPECT_EQ(capturedCout.str(), "");
+}
+
+// Output, error messages and error counts must match the step-by-step engine
+TEST_F(BytecodeTest, VmMatchesStepEngine) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 2,3,WEST", "PLACE 3,0,EAST", "PLACE 1,1", "MOVE", "MOVE",
+                        "MOVE",            "LEFT",           "RIGHT",          "REPORT",    "JUMP", ""};
+
+  std::mt19937                               random(7);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+
+  for (LogLevel level : {LogLevel::NONE, LogLevel::ERROR, LogLevel::INFO}) {
+    Logger::getInstance().setLogLevel(level);
+
+    for (int script = 0; script < 20; ++script) {
+      std::vector<std::string> lines;
+      for (int i = 0; i < 200; ++i) {
+        lines.emplace_back(pool[pick(random)]);
+      }
+
+      std::string expected = simulate(lines, Engine::STEP);
+      std::string actual   = simulate(lines, Engine::VM);
+      ASSERT_EQ(actual, expected) << "log level " << level;
+    }
+  }
+}
+
+TEST_F(BytecodeTest, FuseRunsMergesMovesAndTurns) {
+  Program program = compile({"PLACE 0,0,NORTH", "MOVE", "MOVE", "MOVE", "LEFT", "RIGHT", "RIGHT", "RIGHT", "MOVE",
+                             "REPORT", "LEFT", "LEFT", "LEFT", "LEFT"});
+
+  EXPECT_EQ(program.fuseRuns(), 8U);
+
+  const std::vector<Instruction> &code = program.instructions();
+  ASSERT_EQ(code.size(), 7U);
+  EXPECT_EQ(code[1].op, VmOp::MOVE_N);
+  EXPECT_EQ(code[1].operand, 3U);
+  EXPECT_EQ(code[2].op, VmOp::TURN);
+  EXPECT_EQ(code[2].operand, 4U);
+  EXPECT_EQ(code[2].direction, 2U); // One left and three rights: half a turn
+  EXPECT_EQ(code[3].op, VmOp::MOVE);
+  EXPECT_EQ(code[5].op, VmOp::TURN);
+  EXPECT_EQ(code[5].direction, 0U);
+  EXPECT_EQ(code[6].op, VmOp::HALT);
+
+  EXPECT_EQ(program.lineOf(2), 4U);
+  EXPECT_EQ(program.lineOf(3), 8U);
+  EXPECT_EQ(program.lineOf(6), 14U);
+  EXPECT_EQ(program.lineCount(), 14U);
+}
+
+TEST_F(BytecodeTest, FusedMoveFailsOnlyPastTheEdge) {
+  Program         program = compile({"PLACE 0,0,EAST", "MOVE", "MOVE", "MOVE", "MOVE", "MOVE", "MOVE", "REPORT"});
+  Robot           robot;
+  SimulatorGround ground(3, 3);
+  BytecodeVM      vm;
+
+  program.fuseRuns();
+
+  EXPECT_EQ(vm.run(program, robot, ground), 4);
+  EXPECT_EQ(robot.getPosition(), Position(2, 0));
+  EXPECT_EQ(capturedCout.str(), "Output: 2,0,EAST\n");
+}
+
+TEST_F(BytecodeTest, FusedRunsBeforePlaceFailEveryLine) {
+  Program         program = compile({"MOVE", "MOVE", "LEFT", "RIGHT", "LEFT"});
+  Robot           robot;
+  SimulatorGround ground(5, 5);
+  BytecodeVM      vm;
+
+  program.fuseRuns();
+
+  EXPECT_EQ(vm.run(program, robot, ground), 5);
+  EXPECT_FALSE(robot.hasPlaced());
+}
+
+// Merged runs must keep per-line error messages and line numbers
+TEST_F(BytecodeTest, FusedVmMatchesStepEngine) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 2,3,WEST", "PLACE 1,1", "MOVE", "LEFT", "RIGHT", "REPORT", "JUMP"};
+
+  std::mt19937                               random(11);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+  std::uniform_int_distribution<int>         runLength(1, 8);
+
+  Optimizations fuse;
+  fuse.fuseRuns = true;
+
+  for (LogLevel level : {LogLevel::NONE, LogLevel::ERROR}) {
+    Logger::getInstance().setLogLevel(level);
+
+    for (int script = 0; script < 20; ++script) {
+      std::vector<std::string> lines;
+      while (lines.size() < 300) {
+        const char *line = pool[pick(random)];
+        for (int i = runLength(random); i > 0; --i) {
+          lines.emplace_back(line);
+        }
+      }
+
+      std::string expected = simulate(lines, Engine::STEP);
+      std::string actual   = simulate(lines, Engine::VM, fuse);
+      ASSERT_EQ(actual, expected) << "log level " << level;
+    }
+  }
+}
+
+TEST_F(BytecodeTest, EliminateDeadCommands) {
+  Program program = compile({"MOVE", "LEFT", "REPORT", "PLACE 0,0,NORTH", "MOVE", "PLACE 1,1,EAST", "LEFT", "RIGHT",
+                             "MOVE", "REPORT", "MOVE", "JUMP"});
+
+  EliminationStats stats = program.eliminateDeadCommands(SimulatorGround(5, 5), true);
+
+  EXPECT_EQ(stats.commands, 12U);
+  EXPECT_EQ(stats.removed, 8U);
+  EXPECT_EQ(stats.failures, 3U);
+
+  const std::vector<Instruction> &code = program.instructions();
+  ASSERT_EQ(code.size(), 8U);
+  const VmOp        ops[]   = {VmOp::FAIL, VmOp::FAIL,   VmOp::REPORT, VmOp::PLACE,
+                               VmOp::MOVE, VmOp::REPORT, VmOp::FAIL,   VmOp::HALT};
+  const std::size_t lines[] = {0, 1, 2, 5, 8, 9, 11, 12};
+  for (std::size_t pc = 0; pc < code.size(); ++pc) {
+    EXPECT_EQ(code[pc].op, ops[pc]) << pc;
+    EXPECT_EQ(program.lineOf(pc), lines[pc]) << pc;
+  }
+  EXPECT_EQ(code[0].direction, Instruction::UNPLACED);
+}
+
+TEST_F(BytecodeTest, EliminateDeadCommandsMergesFailuresWithoutMessages) {
+  Program program = compile({"MOVE", "LEFT", "JUMP", "PLACE 9,9,NORTH", "PLACE 0,0,SOUTH", "MOVE", "REPORT"});
+
+  EliminationStats stats = program.eliminateDeadCommands(SimulatorGround(5, 5), false);
+
+  // The MOVE off the south edge fails too, but a live PLACE separates it from the others
+  EXPECT_EQ(stats.failures, 5U);
+  ASSERT_EQ(program.instructions().size(), 5U);
+  EXPECT_EQ(program.instructions()[0].op, VmOp::FAIL);
+  EXPECT_EQ(program.instructions()[0].operand, 4U);
+  EXPECT_EQ(program.instructions()[1].op, VmOp::PLACE);
+  EXPECT_EQ(program.instructions()[2].op, VmOp::FAIL);
+  EXPECT_EQ(program.instructions()[2].operand, 1U);
+
+  Robot      robot;
+  BytecodeVM vm;
+  EXPECT_EQ(vm.run(program, robot, SimulatorGround(5, 5)), 5);
+  EXPECT_EQ(capturedCout.str(), "Output: 0,0,SOUTH\n");
+}
+
+TEST_F(BytecodeTest, EliminateCancellingRotations) {
+  Program program = compile({"PLACE 2,2,NORTH", "LEFT", "RIGHT", "LEFT", "LEFT", "LEFT", "LEFT", "REPORT"});
+
+  EliminationStats stats = program.eliminateDeadCommands(SimulatorGround(5, 5), true);
+
+  EXPECT_EQ(stats.removed, 6U);
+  EXPECT_EQ(stats.failures, 0U);
+  ASSERT_EQ(program.instructions().size(), 3U);
+}
+
+TEST_F(BytecodeTest, FailedStateRoundTrip) {
+  Instruction fail;
+  fail.op        = VmOp::FAIL;
+  fail.direction = static_cast<std::uint8_t>(Direction::WEST);
+  fail.x         = 3;
+  fail.y         = 1;
+
+  Robot robot = Program::failedState(fail);
+  ASSERT_TRUE(robot.hasPlaced());
+  EXPECT_EQ(robot.getPosition(), Position(3, 1));
+  EXPECT_EQ(robot.getDirection(), Direction::WEST);
+
+  fail.direction = Instruction::UNPLACED;
+  EXPECT_FALSE(Program::failedState(fail).hasPlaced());
+}
+
+// REPORT output, error messages and error counts must survive elimination (alone and with fusion)
+TEST_F(BytecodeTest, DeadCodeEliminatedVmMatchesStepEngine) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 2,3,WEST", "PLACE 3,0,EAST", "PLACE 1,1", "MOVE", "LEFT",
+                        "RIGHT",           "REPORT",         "JUMP"};
+
+  std::mt19937                               random(13);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+  std::uniform_int_distribution<int>         runLength(1, 5);
+
+  Optimizations dce;
+  dce.eliminateDeadCode = true;
+  Optimizations dceAndFuse;
+  dceAndFuse.eliminateDeadCode = true;
+  dceAndFuse.fuseRuns          = true;
+
+  for (LogLevel level : {LogLevel::NONE, LogLevel::ERROR, LogLevel::WARNING}) {
+    Logger::getInstance().setLogLevel(level);
+
+    for (int script = 0; script < 20; ++script) {
+      std::vector<std::string> lines;
+      while (lines.size() < 300) {
+        const char *line = pool[pick(random)];
+        for (int i = runLength(random); i > 0; --i) {
+          lines.emplace_back(line);
+        }
+      }
+
+      std::string expected = simulate(lines, Engine::STEP);
+      ASSERT_EQ(simulate(lines, Engine::VM, dce), expected) << "log level " << level;
+      ASSERT_EQ(simulate(lines, Engine::VM, dceAndFuse), expected) << "log level " << level;
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "CachingCommandFactory.hpp"
+
+using namespace simulator;
+
+class CachingCommandFactoryTest : public ::testing::Test {
+protected:
+  CachingCommandFactory cache{8};
+  CommandFactory        reference;
+
+  void expectSameAsReference(const std::string &line) {
+    ParsedCommand expected = reference.decode(line);
+    ParsedCommand actual   = cache.decode(line);
+
+    EXPECT_EQ(actual.opcode, expected.opcode) << line;
+    EXPECT_EQ(actual.error, expected.error) << line;
+    EXPECT_EQ(actual.direction, expected.direction) << line;
+    EXPECT_EQ(actual.position, expected.position) << line;
+  }
+};
+
+TEST_F(CachingCommandFactoryTest, CapacityRoundedUpToPowerOfTwo) {
+  CachingCommandFactory odd(100);
+
+  EXPECT_EQ(odd.getStats().capacity, 128U);
+  EXPECT_EQ(cache.getStats().capacity, 8U);
+}
+
+TEST_F(CachingCommandFactoryTest, RepeatedLinesHitTheCache) {
+  cache.decode("MOVE");
+  cache.decode("MOVE");
+  cache.decode("MOVE");
+
+  ParseCacheStats stats = cache.getStats();
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.hits, 2U);
+}
+
+TEST_F(CachingCommandFactoryTest, CachedResultsMatchDecode) {
+  const std::string lines[] = {"PLACE 1,2,NORTH", "place 3 , 0 , east", "MOVE", "left", " RIGHT ", "REPORT", "",
+                               "PLACE", "PLACE 1,2", "PLACE a,b,NORTH", "PLACE 1,2,UP", "JUMP"};
+
+  // Second pass is served from the cache and must be identical
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const std::string &line : lines) {
+      expectSameAsReference(line);
+    }
+  }
+}
+
+TEST_F(CachingCommandFactoryTest, KeyIsRawBytes) {
+  cache.decode("MOVE");
+  cache.decode("move");
+  cache.decode("MOVE ");
+
+  EXPECT_EQ(cache.getStats().hits, 0U);
+  EXPECT_EQ(cache.getStats().misses, 3U);
+}
+
+TEST_F(CachingCommandFactoryTest, BoundedSizeEvictsOnCollision) {
+  CachingCommandFactory tiny(1);
+
+  EXPECT_EQ(tiny.decode("MOVE").opcode, Opcode::MOVE);
+  EXPECT_EQ(tiny.decode("LEFT").opcode, Opcode::LEFT);
+  EXPECT_EQ(tiny.decode("MOVE").opcode, Opcode::MOVE);
+
+  ParseCacheStats stats = tiny.getStats();
+  EXPECT_EQ(stats.capacity, 1U);
+  EXPECT_EQ(stats.misses, 3U);
+  EXPECT_EQ(stats.evictions, 2U);
+}
+
+TEST_F(CachingCommandFactoryTest, LongLinesAreNotCached) {
+  std::string line = "PLACE 1,2,NORTH" + std::string(CachingCommandFactory::MAX_KEY_LENGTH, ' ');
+
+  expectSameAsReference(line);
+  expectSameAsReference(line);
+
+  ParseCacheStats stats = cache.getStats();
+  EXPECT_EQ(stats.uncached, 2U);
+  EXPECT_EQ(stats.hits + stats.misses, 0U);
+}
+
+TEST_F(CachingCommandFactoryTest, ClearForgetsCachedLines) {
+  cache.decode("REPORT");
+  cache.clear();
+  cache.decode("REPORT");
+
+  EXPECT_EQ(cache.getStats().misses, 2U);
+  EXPECT_EQ(cache.getStats().hits, 0U);
+}
+
+TEST_F(CachingCommandFactoryTest, ParseGoesThroughCache) {
+  EXPECT_NE(cache.parse("MOVE"), nullptr);
+  EXPECT_NE(cache.parse("MOVE"), nullptr);
+  EXPECT_THROW(cache.parse("JUMP"), ParseException);
+
+  EXPECT_EQ(cache.getStats().hits, 1U);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "CommandExecutor.hpp"
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "Robot.hpp"
+#include "SimulatorException.hpp"
+#include "SimulatorGround.hpp"
+
+using namespace simulator;
+
+class CommandExecutorTest : public ::testing::Test {
+protected:
+  Robot           robot  = Robot();
+  SimulatorGround ground = SimulatorGround(5, 5);
+  CommandExecutor executor;
+  CommandFactory  factory;
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    OutputSink::getInstance().flush();
+    std::cout.rdbuf(oldCout);
+  }
+
+  // REPORT results are buffered until flushed
+  std::string output() {
+    OutputSink::getInstance().flush();
+    return capturedCout.str();
+  }
+
+  void run(const std::string &line) {
+    executor.execute(factory.decode(line), robot, ground);
+  }
+
+  // Message of the exception thrown by `fn`, empty if it did not throw
+  template <typename Fn>
+  static std::string errorOf(Fn &&fn) {
+    try {
+      fn();
+    } catch (const InvalidInputException &e) {
+      return e.what();
+    }
+    return "";
+  }
+};
+
+TEST_F(CommandExecutorTest, PlaceMoveRotateReport) {
+  run("PLACE 1,2,EAST");
+  run("MOVE");
+  run("MOVE");
+  run("LEFT");
+  run("MOVE");
+  run("REPORT");
+
+  EXPECT_EQ(robot.getPosition(), Position(3, 3));
+  EXPECT_EQ(robot.getDirection(), Direction::NORTH);
+  EXPECT_EQ(output(), "Output: 3,3,NORTH\n");
+}
+
+TEST_F(CommandExecutorTest, ThrowByCommandsBeforePlace) {
+  EXPECT_THROW(run("MOVE"), InvalidInputException);
+  EXPECT_THROW(run("LEFT"), InvalidInputException);
+  EXPECT_THROW(run("RIGHT"), InvalidInputException);
+  EXPECT_NO_THROW(run("REPORT"));
+
+  EXPECT_FALSE(robot.hasPlaced());
+  EXPECT_EQ(output(), "");
+}
+
+TEST_F(CommandExecutorTest, ThrowByPlaceOutOfBounds) {
+  EXPECT_THROW(run("PLACE 5,0,NORTH"), InvalidInputException);
+  EXPECT_FALSE(robot.hasPlaced());
+}
+
+TEST_F(CommandExecutorTest, ThrowByMoveOffTheEdgeKeepsPosition) {
+  run("PLACE 0,4,NORTH");
+
+  EXPECT_THROW(run("MOVE"), InvalidInputException);
+  EXPECT_EQ(robot.getPosition(), Position(0, 4));
+}
+
+TEST_F(CommandExecutorTest, ThrowByInvalidCommand) {
+  ParsedCommand invalid;
+
+  EXPECT_THROW(executor.execute(invalid, robot, ground), InvalidInputException);
+}
+
+// The executor must be indistinguishable from the Command classes
+TEST_F(CommandExecutorTest, MatchesCommandClasses) {
+  const char *lines[] = {"PLACE 0,0,NORTH", "PLACE 4,4,WEST", "PLACE 5,1,EAST", "PLACE 2,-1,SOUTH",
+                         "MOVE",            "MOVE",           "LEFT",           "RIGHT",
+                         "REPORT"};
+
+  std::mt19937                               random(42);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(lines) / sizeof(lines[0]) - 1);
+
+  Robot reference;
+
+  for (int i = 0; i < 5000; ++i) {
+    const char   *line    = lines[pick(random)];
+    ParsedCommand decoded = factory.decode(line);
+
+    capturedCout.str("");
+    std::string expectedError = errorOf([&] { factory.create(decoded)->execute(reference, ground); });
+    std::string expectedOut   = output();
+
+    capturedCout.str("");
+    std::string actualError = errorOf([&] { executor.execute(decoded, robot, ground); });
+
+    ASSERT_EQ(actualError, expectedError) << line;
+    ASSERT_EQ(output(), expectedOut) << line;
+    ASSERT_EQ(robot.hasPlaced(), reference.hasPlaced());
+    if (robot.hasPlaced()) {
+      ASSERT_EQ(robot.getPosition(), reference.getPosition());
+      ASSERT_EQ(robot.getDirection(), reference.getDirection());
+    }
+  }
+}
+
+TEST_F(CommandExecutorTest, TryExecuteReportsErrorKindAndLine) {
+  ExecutionResult result = executor.tryExecute(factory.decode("MOVE"), robot, ground, 7);
+  EXPECT_EQ(result.error, ExecutionError::NOT_PLACED);
+  EXPECT_EQ(result.opcode, Opcode::MOVE);
+  EXPECT_EQ(result.line, 7u);
+
+  result = executor.tryExecute(factory.decode("PLACE 5,0,NORTH"), robot, ground, 8);
+  EXPECT_EQ(result.error, ExecutionError::PLACE_OUT_OF_BOUNDS);
+  EXPECT_EQ(result.position, Position(5, 0));
+  EXPECT_FALSE(robot.hasPlaced());
+
+  result = executor.tryExecute(factory.decode("PLACE 0,4,NORTH"), robot, ground, 9);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.line, 9u);
+
+  result = executor.tryExecute(factory.decode("MOVE"), robot, ground, 10);
+  EXPECT_EQ(result.error, ExecutionError::MOVE_OUT_OF_BOUNDS);
+  EXPECT_EQ(result.position, Position(0, 5));
+  EXPECT_EQ(robot.getPosition(), Position(0, 4));
+
+  result = executor.tryExecute(ParsedCommand(), robot, ground, 11);
+  EXPECT_EQ(result.error, ExecutionError::INVALID_COMMAND);
+}
+
+// describe() must rebuild exactly the message the throwing API reports
+TEST_F(CommandExecutorTest, DescribeMatchesExceptionMessages) {
+  const char *lines[] = {"MOVE", "LEFT", "RIGHT", "PLACE 5,1,EAST", "PLACE 0,0,SOUTH", "MOVE", "LEFT", "MOVE"};
+
+  Robot reference;
+
+  for (const char *line : lines) {
+    ParsedCommand   decoded       = factory.decode(line);
+    std::string     expectedError = errorOf([&] { executor.execute(decoded, reference, ground); });
+    ExecutionResult result        = executor.tryExecute(decoded, robot, ground);
+
+    EXPECT_EQ(result.ok(), expectedError.empty()) << line;
+    if (!result.ok()) {
+      EXPECT_EQ(InvalidInputException(CommandExecutor::describe(result, ground)).what(), expectedError) << line;
+    }
+  }
+  EXPECT_EQ(robot.getPosition(), reference.getPosition());
+}
+
+TEST_F(CommandExecutorTest, ObstaclesFailPlaceAndMove) {
+  auto map = std::make_shared<ObstacleMap>(5, 5);
+  map->block(Position(1, 1));
+  ground.setObstacles(map);
+
+  ExecutionResult result = executor.tryExecute(factory.decode("PLACE 1,1,NORTH"), robot, ground);
+  EXPECT_EQ(result.error, ExecutionError::OBSTACLE);
+  EXPECT_EQ(result.position, Position(1, 1));
+  EXPECT_EQ(CommandExecutor::describe(result, ground), "Cannot PLACE robot at 1,1: position blocked by an obstacle");
+
+  run("PLACE 1,0,NORTH");
+  result = executor.tryExecute(factory.decode("MOVE"), robot, ground);
+  EXPECT_EQ(result.error, ExecutionError::OBSTACLE);
+  EXPECT_EQ(robot.getPosition(), Position(1, 0));
+  EXPECT_EQ(CommandExecutor::describe(result, ground), "Cannot move to 1,1: position blocked by an obstacle");
+
+  // The original Command classes give the same messages
+  Robot       reference;
+  std::string expected = "Invalid input: Cannot move to 1,1: position blocked by an obstacle";
+  factory.parse("PLACE 1,0,NORTH")->execute(reference, ground);
+  EXPECT_EQ(errorOf([&] { factory.parse("MOVE")->execute(reference, ground); }), expected);
+  EXPECT_EQ(errorOf([&] { factory.parse("PLACE 1,1,EAST")->execute(reference, ground); }),
+            "Invalid input: Cannot PLACE robot at 1,1: position blocked by an obstacle");
+}
+
+// The packed-state overload must agree with the Robot one on every result and output
+TEST_F(CommandExecutorTest, PackedStateMatchesRobot) {
+  const char *lines[] = {"PLACE 0,0,NORTH", "PLACE 4,4,WEST", "PLACE 5,1,EAST", "MOVE", "MOVE",
+                         "MOVE",            "LEFT",           "RIGHT",          "REPORT"};
+
+  std::mt19937                               random(7);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(lines) / sizeof(lines[0]) - 1);
+
+  PackedRobot packed;
+
+  for (int i = 0; i < 5000; ++i) {
+    const char   *line    = lines[pick(random)];
+    ParsedCommand decoded = factory.decode(line);
+
+    capturedCout.str("");
+    ExecutionResult expected       = executor.tryExecute(decoded, robot, ground, 3);
+    std::string     expectedOutput = output();
+
+    capturedCout.str("");
+    ExecutionResult actual = executor.tryExecute(decoded, packed, ground, 3);
+
+    ASSERT_EQ(actual.error, expected.error) << line;
+    ASSERT_EQ(actual.position, expected.position) << line;
+    ASSERT_EQ(actual.line, expected.line);
+    ASSERT_EQ(output(), expectedOutput) << line;
+    ASSERT_EQ(packed, PackedRobot::fromRobot(robot)) << line;
+  }
+}
@@ -147,3 +147,74 @@ TEST_F(CommandFactoryTest, ThrowByParseEmptyString) {
 TEST_F(CommandFactoryTest, ThrowByParseOnlySpaces) {
   EXPECT_THROW(factory.parse("   "), ParseException);
 }
+
+TEST_F(CommandFactoryTest, DecodePlaceCommand) {
+  ParsedCommand cmd = factory.decode("  place 1 , 2 , south ");
+
+  ASSERT_TRUE(cmd.ok());
+  EXPECT_EQ(cmd.opcode, Opcode::PLACE);
+  EXPECT_EQ(cmd.position, Position(1, 2));
+  EXPECT_EQ(cmd.direction, Direction::SOUTH);
+}
+
+TEST_F(CommandFactoryTest, DecodeSimpleCommands) {
+  EXPECT_EQ(factory.decode("MOVE").opcode, Opcode::MOVE);
+  EXPECT_EQ(factory.decode("left").opcode, Opcode::LEFT);
+  EXPECT_EQ(factory.decode("\tRight\r").opcode, Opcode::RIGHT);
+  EXPECT_EQ(factory.decode(" Report ").opcode, Opcode::REPORT);
+}
+
+TEST_F(CommandFactoryTest, DecodeCoordinatesLikeStoll) {
+  EXPECT_EQ(factory.decode("PLACE +3,-0,EAST").position, Position(3, 0));
+  EXPECT_EQ(factory.decode("PLACE 2abc,4,EAST").position, Position(2, 4));
+  EXPECT_EQ(factory.decode("PLACE -1,-2,EAST").position, Position(-1, -2));
+  EXPECT_EQ(factory.decode("PLACE +-1,2,EAST").error, ParseError::INVALID_COORDINATES);
+  EXPECT_EQ(factory.decode("PLACE 99999999999,2,EAST").position, Position(99999999999, 2));
+  EXPECT_EQ(factory.decode("PLACE 1099511627775,-1099511627776,EAST").position,
+            Position(1099511627775, -1099511627776));
+  EXPECT_EQ(factory.decode("PLACE 99999999999999999999,2,EAST").error, ParseError::INVALID_COORDINATES);
+  EXPECT_EQ(factory.decode("PLACE -,2,EAST").error, ParseError::INVALID_COORDINATES);
+}
+
+TEST_F(CommandFactoryTest, DecodeReportsErrorKinds) {
+  EXPECT_EQ(factory.decode("").error, ParseError::EMPTY_COMMAND);
+  EXPECT_EQ(factory.decode(" \t ").error, ParseError::EMPTY_COMMAND);
+  EXPECT_EQ(factory.decode("PLACE").error, ParseError::PLACE_MISSING_PARAMETERS);
+  EXPECT_EQ(factory.decode("PLACE 1,2").error, ParseError::PLACE_PARAMETER_COUNT);
+  EXPECT_EQ(factory.decode("PLACE 1,2,NORTH,WOW").error, ParseError::PLACE_PARAMETER_COUNT);
+  EXPECT_EQ(factory.decode("PLACE abc,2,NORTH").error, ParseError::INVALID_COORDINATES);
+  EXPECT_EQ(factory.decode("PLACE 1,2,UP").error, ParseError::INVALID_DIRECTION);
+  EXPECT_EQ(factory.decode("PLACE 1,2,").error, ParseError::PLACE_PARAMETER_COUNT);
+  EXPECT_EQ(factory.decode("PLACE 1,2,,").error, ParseError::INVALID_DIRECTION);
+  EXPECT_EQ(factory.decode("JUMP").error, ParseError::UNKNOWN_COMMAND);
+}
+
+TEST_F(CommandFactoryTest, DecodeKeepsTrailingCommaTokenCount) {
+  // split() drops a single trailing empty token, so this is still three parameters
+  ParsedCommand cmd = factory.decode("PLACE 1,2,NORTH,");
+
+  ASSERT_TRUE(cmd.ok());
+  EXPECT_EQ(cmd.direction, Direction::NORTH);
+}
+
+TEST_F(CommandFactoryTest, DescribeMatchesParseExceptionMessages) {
+  ParsedCommand unknown = factory.decode("jump high");
+  EXPECT_EQ(CommandFactory::describe(unknown, "jump high"), "Unknown command: JUMP HIGH");
+
+  ParsedCommand direction = factory.decode("place 1,2, up ");
+  EXPECT_EQ(CommandFactory::describe(direction, "place 1,2, up "),
+            "Invalid direction: UP. Must be NORTH, EAST, SOUTH, or WEST");
+
+  try {
+    factory.parse("jump high");
+    FAIL() << "Expected ParseException";
+  } catch (const ParseException &e) {
+    EXPECT_STREQ(e.what(), "Parse error: Unknown command: JUMP HIGH");
+  }
+}
+
+TEST_F(CommandFactoryTest, ThrowByCreateForFailedDecode) {
+  ParsedCommand cmd = factory.decode("JUMP");
+
+  EXPECT_THROW(factory.create(cmd), InvalidInputException);
+}
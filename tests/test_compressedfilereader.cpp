@@ -0,0 +1,142 @@
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#ifdef ROBOTSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ROBOTSIM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "CompressedFileReader.hpp"
+#include "FileReader.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class CompressedFileReaderTest : public ::testing::Test {
+protected:
+  std::string test_dir = "/tmp/compressedFileReaderTest_" + std::to_string(std::rand());
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir;
+    system(cmd.c_str());
+  }
+
+  void TearDown() override {
+    // Clean up test directory using system call
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath, std::ios::binary);
+    if (file.is_open()) {
+      file << content;
+      file.close();
+    }
+    return filepath;
+  }
+
+  std::string generateScript(std::size_t lines) {
+    const char *samples[] = {"PLACE 1,2,NORTH", "MOVE", "", "LEFT", "RIGHT", "REPORT"};
+    std::string content;
+    for (std::size_t i = 0; i < lines; ++i) {
+      content += samples[i % 6];
+      content += '\n';
+    }
+    return content;
+  }
+
+#ifdef ROBOTSIM_HAVE_ZLIB
+  std::string createGzipFile(const std::string &filename, const std::string &content, const char *mode = "wb") {
+    std::string filepath = test_dir + "/" + filename;
+    gzFile      file     = gzopen(filepath.c_str(), mode);
+    gzwrite(file, content.data(), static_cast<unsigned>(content.size()));
+    gzclose(file);
+    return filepath;
+  }
+#endif
+};
+
+TEST_F(CompressedFileReaderTest, DetectsPlainText) {
+  std::string filepath = createTestFile("input.txt", "MOVE\n");
+
+  EXPECT_EQ(CompressedFileReader::detect(filepath), Compression::NONE);
+  EXPECT_EQ(CompressedFileReader::detect(test_dir + "/missing.gz"), Compression::NONE);
+  EXPECT_FALSE(CompressedFileReader::isSupported(Compression::NONE));
+}
+
+TEST_F(CompressedFileReaderTest, DetectsZstdMagic) {
+  std::string filepath = createTestFile("input.zst", std::string("\x28\xB5\x2F\xFD", 4) + "payload");
+
+  EXPECT_EQ(CompressedFileReader::detect(filepath), Compression::ZSTD);
+}
+
+TEST_F(CompressedFileReaderTest, ThrowByReaderForPlainText) {
+  CompressedFileReader reader(createTestFile("input.txt", "MOVE\n"));
+  std::string_view     line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+#ifdef ROBOTSIM_HAVE_ZLIB
+TEST_F(CompressedFileReaderTest, ReadsGzipLikePlainFile) {
+  std::string content  = generateScript(5000) + "MOVE";
+  std::string gzipFile = createGzipFile("input.txt.gz", content);
+  auto        expected = FileReader(createTestFile("input.txt", content)).readInput();
+
+  EXPECT_EQ(CompressedFileReader::detect(gzipFile), Compression::GZIP);
+  EXPECT_EQ(expected.size(), 5001);
+
+  // Small blocks force lines to span block boundaries
+  for (std::size_t blockSize : std::vector<std::size_t>{1, 7, 4096, CompressedFileReader::DEFAULT_BLOCK_SIZE}) {
+    CompressedFileReader reader(gzipFile, blockSize);
+    EXPECT_EQ(reader.readInput(), expected);
+  }
+}
+
+TEST_F(CompressedFileReaderTest, ReadsConcatenatedGzipMembers) {
+  std::string first  = createGzipFile("a.gz", "PLACE 0,0,NORTH\nMOVE\n");
+  std::string second = createGzipFile("b.gz", "REPORT\n");
+  std::string both   = test_dir + "/both.gz";
+  std::string cmd    = "cat " + first + " " + second + " > " + both;
+  system(cmd.c_str());
+
+  CompressedFileReader reader(both);
+  auto                 lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[2], "REPORT");
+}
+
+TEST_F(CompressedFileReaderTest, ThrowByReaderForTruncatedGzip) {
+  std::string   gzipFile = createGzipFile("input.gz", generateScript(2000));
+  std::ifstream in(gzipFile, std::ios::binary);
+  std::string   bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  CompressedFileReader reader(createTestFile("truncated.gz", bytes.substr(0, bytes.size() / 2)));
+
+  EXPECT_THROW(reader.readInput(), FileException);
+}
+
+TEST_F(CompressedFileReaderTest, ThrowByReaderForCorruptGzip) {
+  CompressedFileReader reader(createTestFile("corrupt.gz", std::string("\x1F\x8B\x08\x00garbagegarbage", 18)));
+
+  EXPECT_THROW(reader.readInput(), FileException);
+}
+#endif
+
+#ifdef ROBOTSIM_HAVE_ZSTD
+TEST_F(CompressedFileReaderTest, ReadsZstdLikePlainFile) {
+  std::string content = generateScript(3000);
+  std::string compressed(ZSTD_compressBound(content.size()), '\0');
+  compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), content.data(), content.size(), 3));
+
+  CompressedFileReader reader(createTestFile("input.zst", compressed), 64);
+
+  EXPECT_EQ(reader.readInput(), FileReader(createTestFile("input.txt", content)).readInput());
+}
+#endif
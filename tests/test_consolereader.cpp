@@ -60,3 +60,24 @@ TEST_F(ConsoleReaderTest, StopAtEmptyLine) {
   EXPECT_EQ(lines[0], "PLACE 0,0,NORTH");
   EXPECT_EQ(lines[1], "MOVE");
 }
+
+TEST_F(ConsoleReaderTest, NextLineStreamsUntilEmptyLine) {
+  sendStdCinInput("PLACE 0,0,NORTH\nREPORT\n\nMOVE\n");
+
+  std::string_view line;
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "PLACE 0,0,NORTH");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "REPORT");
+  EXPECT_FALSE(reader.nextLine(line));
+  EXPECT_FALSE(reader.nextLine(line));
+}
+
+TEST_F(ConsoleReaderTest, NextLineStopsAtEndOfStream) {
+  sendStdCinInput("MOVE");
+
+  std::string_view line;
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "MOVE");
+  EXPECT_FALSE(reader.nextLine(line));
+}
@@ -80,3 +80,36 @@ TEST_F(FileReaderTest, NonExistentFile) {
 
   EXPECT_THROW(reader.readInput(), FileException);
 }
+
+TEST_F(FileReaderTest, NextLineStreamsOneLineAtATime) {
+  std::string filepath = createTestFile("input.txt", "PLACE 0,0,NORTH\nMOVE\nREPORT\n");
+  FileReader  reader(filepath);
+
+  std::string_view line;
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "PLACE 0,0,NORTH");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "MOVE");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "REPORT");
+  EXPECT_FALSE(reader.nextLine(line));
+  EXPECT_FALSE(reader.nextLine(line));
+}
+
+TEST_F(FileReaderTest, NextLineKeepsEmptyLines) {
+  std::string filepath = createTestFile("input.txt", "MOVE\n\nLEFT");
+  FileReader  reader(filepath);
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[1], "");
+  EXPECT_EQ(lines[2], "LEFT");
+}
+
+TEST_F(FileReaderTest, NextLineThrowsForNonExistentFile) {
+  FileReader       reader("/somewhere/unknown/path/file.txt");
+  std::string_view line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
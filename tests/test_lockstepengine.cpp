@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CommandExecutor.hpp"
+#include "CommandFactory.hpp"
+#include "LockstepEngine.hpp"
+#include "Logger.hpp"
+#include "ObstacleMap.hpp"
+#include "OutputSink.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+namespace {
+
+std::vector<SimdKernel> supportedKernels() {
+  std::vector<SimdKernel> kernels;
+  for (SimdKernel kernel : {SimdKernel::SCALAR, SimdKernel::SSE2, SimdKernel::AVX2}) {
+    if (LockstepEngine::supports(kernel)) {
+      kernels.push_back(kernel);
+    }
+  }
+  return kernels;
+}
+
+} // namespace
+
+class LockstepEngineTest : public ::testing::Test {
+protected:
+  CommandFactory  factory;
+  SimulatorGround ground = SimulatorGround(7, 9);
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    OutputSink::getInstance().flush();
+    OutputSink::getInstance().setRobotIds(false);
+    std::cout.rdbuf(oldCout);
+  }
+
+  // REPORT results are buffered until flushed
+  std::string output() {
+    OutputSink::getInstance().flush();
+    return capturedCout.str();
+  }
+
+  // Starts on free cells of `floor`
+  static std::vector<Robot> randomStarts(const SimulatorGround &floor, std::size_t count, unsigned seed) {
+    std::mt19937       random(seed);
+    std::vector<Robot> starts(count);
+    for (Robot &robot : starts) {
+      Position position;
+      do {
+        position = Position(static_cast<int>(random() % static_cast<unsigned>(floor.getCols())),
+                            static_cast<int>(random() % static_cast<unsigned>(floor.getRows())));
+      } while (!floor.isValidPosition(position));
+      robot.place(position, static_cast<Direction>(random() % 4));
+    }
+    return starts;
+  }
+
+  // Every kernel must match each robot run through CommandExecutor, the reference path
+  void expectKernelsMatchReference(const SimulatorGround &floor, const std::vector<Robot> &starts,
+                                   const std::vector<std::string> &script) {
+    CommandExecutor executor;
+    for (SimdKernel kernel : supportedKernels()) {
+      LockstepEngine     lockstep(floor, starts, kernel);
+      std::vector<Robot> reference        = starts;
+      std::size_t        expectedFailures = 0;
+      std::size_t        failures         = 0;
+
+      for (const std::string &line : script) {
+        ParsedCommand command = factory.decode(line);
+        for (Robot &robot : reference) {
+          expectedFailures += executor.tryExecute(command, robot, floor).ok() ? 0U : 1U;
+        }
+        failures += lockstep.execute(command).failures();
+      }
+
+      EXPECT_EQ(failures, expectedFailures) << toString(kernel);
+      for (std::size_t i = 0; i < reference.size(); ++i) {
+        Robot robot = lockstep.robot(i);
+        ASSERT_EQ(robot.hasPlaced(), reference[i].hasPlaced()) << toString(kernel) << " robot " << i;
+        if (robot.hasPlaced()) {
+          EXPECT_EQ(robot.getPosition(), reference[i].getPosition()) << toString(kernel) << " robot " << i;
+          EXPECT_EQ(robot.getDirection(), reference[i].getDirection()) << toString(kernel) << " robot " << i;
+        }
+      }
+    }
+  }
+
+  static std::vector<std::string> randomScript(std::size_t length, unsigned seed) {
+    const char              *pool[] = {"MOVE", "MOVE", "MOVE", "LEFT", "RIGHT", "MOVE"};
+    std::mt19937             random(seed);
+    std::vector<std::string> script;
+    for (std::size_t i = 0; i < length; ++i) {
+      script.emplace_back(pool[random() % 6]);
+    }
+    return script;
+  }
+};
+
+TEST_F(LockstepEngineTest, ScalarAndSse2AreAlwaysAvailable) {
+  EXPECT_TRUE(LockstepEngine::supports(SimdKernel::SCALAR));
+  EXPECT_TRUE(LockstepEngine::supports(LockstepEngine::bestKernel()));
+#if defined(__x86_64__)
+  EXPECT_TRUE(LockstepEngine::supports(SimdKernel::SSE2));
+#endif
+}
+
+TEST_F(LockstepEngineTest, KernelsMatchRobotReference) {
+  std::vector<std::string> script = randomScript(400, 7);
+  script[250]                     = "PLACE 8,6,SOUTH";
+  script[300]                     = "PLACE 9,0,NORTH";
+
+  // 101 robots: not a multiple of any vector width
+  std::vector<Robot> starts = randomStarts(ground, 101, 3);
+  starts[17]                = Robot(); // never placed
+
+  expectKernelsMatchReference(ground, starts, script);
+}
+
+TEST_F(LockstepEngineTest, KernelsMatchRobotReferenceAroundObstacles) {
+  // 11x13 cells: the obstacle bits span several words
+  auto         map = std::make_shared<ObstacleMap>(11, 13);
+  std::mt19937 random(5);
+  for (int i = 0; i < 30; ++i) {
+    map->block(Position(static_cast<int>(random() % 13), static_cast<int>(random() % 11)));
+  }
+  map->block(Position(3, 3));
+  SimulatorGround floor(11, 13);
+  floor.setObstacles(map);
+
+  std::vector<std::string> script = randomScript(600, 9);
+  script[200]                     = "PLACE 3,3,WEST"; // blocked for every robot
+  script[400]                     = "PLACE 12,10,SOUTH";
+
+  expectKernelsMatchReference(floor, randomStarts(floor, 203, 4), script);
+}
+
+// A sparse map has no bit array to gather from: the AVX2 kernel tests it lane by lane
+TEST_F(LockstepEngineTest, KernelsMatchRobotReferenceOnSparseMap) {
+  // Robots and obstacles in the 13x11 corner of the largest ground 32-bit lanes hold
+  const Coordinate side = INT32_MAX;
+  const Coordinate lowX = side - 13;
+  const Coordinate lowY = side - 11;
+  auto             map  = std::make_shared<ObstacleMap>(side, side);
+  std::mt19937     random(6);
+  for (int i = 0; i < 30; ++i) {
+    map->block(Position(lowX + static_cast<Coordinate>(random() % 13), lowY + static_cast<Coordinate>(random() % 11)));
+  }
+  ASSERT_FALSE(map->isDense());
+  SimulatorGround floor(side, side);
+  floor.setObstacles(map);
+
+  std::vector<Robot> starts(77);
+  for (Robot &robot : starts) {
+    Position position;
+    do {
+      position = Position(lowX + static_cast<Coordinate>(random() % 13), lowY + static_cast<Coordinate>(random() % 11));
+    } while (!floor.isValidPosition(position));
+    robot.place(position, static_cast<Direction>(random() % 4));
+  }
+
+  expectKernelsMatchReference(floor, starts, randomScript(600, 10));
+}
+
+TEST_F(LockstepEngineTest, RejectsGroundsBeyond32BitLanes) {
+  SimulatorGround huge(MAX_GROUND_SIDE, 5);
+  EXPECT_THROW(LockstepEngine(huge, {}), InvalidInputException);
+}
+
+TEST_F(LockstepEngineTest, FailuresAreCountedByKind) {
+  std::vector<Robot> starts(3);
+  starts[0].place(Position(0, 6), Direction::NORTH);
+  starts[1].place(Position(0, 0), Direction::NORTH);
+
+  for (SimdKernel kernel : supportedKernels()) {
+    LockstepEngine lockstep(ground, starts, kernel);
+    EXPECT_EQ(lockstep.size(), 3U);
+    EXPECT_EQ(lockstep.placedCount(), 2U);
+
+    LockstepResult result = lockstep.execute(factory.decode("MOVE"), 4);
+    EXPECT_EQ(result.opcode, Opcode::MOVE);
+    EXPECT_EQ(result.line, 4U);
+    EXPECT_EQ(result.notPlaced, 1U);
+    EXPECT_EQ(result.blocked, 1U);
+    EXPECT_EQ(lockstep.robot(1).getPosition(), Position(0, 1));
+
+    result = lockstep.execute(factory.decode("PLACE 9,9,EAST"));
+    EXPECT_EQ(result.blocked, 3U);
+    EXPECT_EQ(result.position, Position(9, 9));
+
+    result = lockstep.execute(factory.decode("PLACE 2,2,EAST"));
+    EXPECT_EQ(result.failures(), 0U);
+    EXPECT_EQ(lockstep.placedCount(), 3U);
+    EXPECT_EQ(lockstep.robot(2).getPosition(), Position(2, 2));
+  }
+}
+
+TEST_F(LockstepEngineTest, ReportListsPlacedRobotsInOrder) {
+  OutputSink::getInstance().setRobotIds(true);
+  std::vector<Robot> starts(3);
+  starts[0].place(Position(1, 2), Direction::WEST);
+  starts[2].place(Position(3, 4), Direction::SOUTH);
+
+  LockstepEngine lockstep(ground, starts);
+  lockstep.execute(factory.decode("REPORT"), 1);
+
+  EXPECT_EQ(output(), "0: Output: 1,2,WEST\n2: Output: 3,4,SOUTH\n");
+}
+
+TEST_F(LockstepEngineTest, ReadStarts) {
+  LineReader         reader({"PLACE 0,0,NORTH", "place 8,6,west"});
+  std::vector<Robot> starts = LockstepEngine::readStarts(reader, factory, ground);
+  ASSERT_EQ(starts.size(), 2U);
+  EXPECT_EQ(starts[1].getPosition(), Position(8, 6));
+  EXPECT_EQ(starts[1].getDirection(), Direction::WEST);
+
+  LineReader notPlace({"PLACE 0,0,NORTH", "MOVE"});
+  EXPECT_THROW(LockstepEngine::readStarts(notPlace, factory, ground), InvalidInputException);
+
+  LineReader outside({"PLACE 9,0,NORTH"});
+  EXPECT_THROW(LockstepEngine::readStarts(outside, factory, ground), InvalidInputException);
+}
+
+TEST_F(LockstepEngineTest, RunSimulatorWithoutStartsMatchesStepEngine) {
+  std::vector<std::string> lines{"MOVE",  "PLACE 1,1,NORTH", "MOVE", "MOVE", "LEFT",  "MOVE",
+                                 "MOVE",  "REPORT",          "JUMP", "RIGHT", "MOVE", "REPORT"};
+  std::string              results[2];
+  Engine                   engines[2] = {Engine::STEP, Engine::LOCKSTEP};
+
+  for (int i = 0; i < 2; ++i) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(5, 5), engines[i]);
+    sim.run();
+    results[i] = output();
+  }
+
+  EXPECT_EQ(results[0], "Output: 0,3,WEST\nOutput: 0,4,NORTH\n");
+  EXPECT_EQ(results[1], results[0]);
+}
+
+TEST_F(LockstepEngineTest, RunSimulatorLogsAggregatedFailures) {
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+  std::vector<Robot> starts(3);
+  starts[0].place(Position(0, 4), Direction::NORTH);
+  starts[1].place(Position(1, 4), Direction::NORTH);
+
+  RobotSimulator sim(std::make_unique<LineReader>(std::vector<std::string>{"MOVE", "PLACE 7,0,EAST"}),
+                     std::make_unique<CommandFactory>(), std::make_unique<SimulatorGround>(5, 5), Engine::LOCKSTEP,
+                     Optimizations(), starts);
+  sim.run();
+
+  std::string out = output();
+  EXPECT_NE(out.find("Execution error on line 1: Robot must be placed before MOVE command (1 of 3 robots)"),
+            std::string::npos);
+  EXPECT_NE(out.find("Execution error on line 1: Cannot move: position out of bounds (2 of 3 robots)"),
+            std::string::npos);
+  EXPECT_NE(out.find("Execution error on line 2: Cannot PLACE robot at 7,0: position out of bounds (ground is 5x5) "
+                     "(3 of 3 robots)"),
+            std::string::npos);
+}
@@ -1,7 +1,9 @@
 #include <chrono>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "Logger.hpp"
 
@@ -239,4 +241,43 @@ TEST_F(LoggerTest, LogLevelStreamOperatorUnknown) {
   oss << unknown;
 
   EXPECT_EQ(oss.str(), "UNKNOWN");
-}
\ No newline at end of file
+}
+
+TEST_F(LoggerTest, ConcurrentLinesStayWhole) {
+  Logger &logger = Logger::getInstance();
+  logger.setLogLevel(LogLevel::INFO);
+  clearOutput();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&logger, t] {
+      for (int i = 0; i < 200; ++i) {
+        logger.info("thread " + std::to_string(t) + " message " + std::to_string(i));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::istringstream lines(getCapturedOutput());
+  std::string        line;
+  int                count = 0;
+  while (std::getline(lines, line)) {
+    EXPECT_NE(line.find("] [INFO   ] thread "), std::string::npos) << line;
+    ++count;
+  }
+  EXPECT_EQ(count, 800);
+}
+
+TEST_F(LoggerTest, IsEnabledFollowsCurrentLevel) {
+  Logger &logger = Logger::getInstance();
+
+  logger.setLogLevel(LogLevel::WARNING);
+  EXPECT_TRUE(logger.isEnabled(LogLevel::ERROR));
+  EXPECT_TRUE(logger.isEnabled(LogLevel::WARNING));
+  EXPECT_FALSE(logger.isEnabled(LogLevel::INFO));
+
+  logger.setLogLevel(LogLevel::NONE);
+  EXPECT_FALSE(logger.isEnabled(LogLevel::ERROR));
+}
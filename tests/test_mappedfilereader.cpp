@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "MappedFileReader.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class MappedFileReaderTest : public ::testing::Test {
+protected:
+  std::string test_dir = "/tmp/mappedFileReaderTest_" + std::to_string(std::rand());
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir;
+    system(cmd.c_str());
+  }
+
+  void TearDown() override {
+    // Clean up test directory using system call
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath);
+    if (file.is_open()) {
+      file << content;
+      file.close();
+    }
+    return filepath;
+  }
+};
+
+TEST_F(MappedFileReaderTest, ReadSingleLine) {
+  std::string      filepath = createTestFile("input.txt", "PLACE 1,2,NORTH");
+  MappedFileReader reader(filepath);
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines[0], "PLACE 1,2,NORTH");
+}
+
+TEST_F(MappedFileReaderTest, ReadFileWithMultipleLines) {
+  std::string      filepath = createTestFile("input.txt", "PLACE 0,0,NORTH\nMOVE\nLEFT\nREPORT\n");
+  MappedFileReader reader(filepath);
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 4);
+  EXPECT_EQ(lines[0], "PLACE 0,0,NORTH");
+  EXPECT_EQ(lines[1], "MOVE");
+  EXPECT_EQ(lines[2], "LEFT");
+  EXPECT_EQ(lines[3], "REPORT");
+}
+
+TEST_F(MappedFileReaderTest, KeepsEmptyLinesLikeGetline) {
+  std::string      filepath = createTestFile("input.txt", "MOVE\n\nLEFT\n\n");
+  MappedFileReader reader(filepath);
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 4);
+  EXPECT_EQ(lines[1], "");
+  EXPECT_EQ(lines[3], "");
+}
+
+TEST_F(MappedFileReaderTest, LinesPointIntoTheMapping) {
+  std::string      filepath = createTestFile("input.txt", "MOVE\nLEFT\n");
+  MappedFileReader reader(filepath);
+
+  std::string_view first;
+  std::string_view second;
+  ASSERT_TRUE(reader.nextLine(first));
+  ASSERT_TRUE(reader.nextLine(second));
+
+  // Zero-copy: consecutive lines are adjacent slices of the same buffer
+  EXPECT_EQ(first.data() + first.size() + 1, second.data());
+  EXPECT_FALSE(reader.nextLine(second));
+}
+
+TEST_F(MappedFileReaderTest, ReadEmptyFile) {
+  std::string      filepath = createTestFile("empty.txt", "");
+  MappedFileReader reader(filepath);
+
+  std::string_view line;
+  EXPECT_FALSE(reader.nextLine(line));
+}
+
+TEST_F(MappedFileReaderTest, NonExistentFile) {
+  MappedFileReader reader("/somewhere/unknown/path/file.txt");
+
+  EXPECT_THROW(reader.readInput(), FileException);
+}
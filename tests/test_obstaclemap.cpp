@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ObstacleMap.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class ObstacleMapTest : public ::testing::Test {
+protected:
+  std::string test_dir = "/tmp/obstacleMapTest_" + std::to_string(std::rand());
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir;
+    system(cmd.c_str());
+  }
+
+  void TearDown() override {
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath, std::ios::binary);
+    file << content;
+    return filepath;
+  }
+
+  // Rows wide enough for a row to span several 64-bit words
+  static ObstacleMap randomMap(int rows, int cols, unsigned seed, unsigned oneIn = 8) {
+    std::mt19937 random(seed);
+    ObstacleMap  map(rows, cols);
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < cols; ++x) {
+        if (random() % oneIn == 0) {
+          map.block(Position(x, y));
+        }
+      }
+    }
+    return map;
+  }
+
+  // The cells of `dense` moved by (offsetX, offsetY) onto a sparse map of the largest size
+  static ObstacleMap sparseCopy(const ObstacleMap &dense, Coordinate offsetX, Coordinate offsetY) {
+    ObstacleMap sparse(MAX_GROUND_SIDE, MAX_GROUND_SIDE);
+    for (Coordinate y = 0; y < dense.getRows(); ++y) {
+      for (Coordinate x = 0; x < dense.getCols(); ++x) {
+        if (dense.isBlocked(Position(x, y))) {
+          sparse.block(Position(x + offsetX, y + offsetY));
+        }
+      }
+    }
+    return sparse;
+  }
+};
+
+TEST_F(ObstacleMapTest, FirstRowIsNorth) {
+  ObstacleMap map = ObstacleMap::fromRows({"#..", "...", ".#."});
+
+  EXPECT_EQ(map.getRows(), 3);
+  EXPECT_EQ(map.getCols(), 3);
+  EXPECT_EQ(map.blockedCount(), 2U);
+  EXPECT_TRUE(map.isBlocked(Position(0, 2)));
+  EXPECT_TRUE(map.isBlocked(Position(1, 0)));
+  EXPECT_FALSE(map.isBlocked(Position(0, 0)));
+  EXPECT_FALSE(map.isBlocked(Position(2, 2)));
+}
+
+TEST_F(ObstacleMapTest, InvalidMaps) {
+  EXPECT_THROW(ObstacleMap(0, 5), InvalidInputException);
+  EXPECT_THROW(ObstacleMap(5, -1), InvalidInputException);
+  EXPECT_THROW(ObstacleMap(MAX_GROUND_SIDE + 1, 5), InvalidInputException);
+  EXPECT_THROW(ObstacleMap::fromRows({}), InvalidInputException);
+  EXPECT_THROW(ObstacleMap::fromRows({"..#", ".."}), ParseException);
+  EXPECT_THROW(ObstacleMap::fromRows({"..#", ".x."}), ParseException);
+}
+
+TEST_F(ObstacleMapTest, LoadFromFile) {
+  std::string path = createTestFile("floor.txt", "#....\r\n..#..\r\n.....\r\n\r\n");
+
+  std::shared_ptr<const ObstacleMap> map = ObstacleMap::load(path);
+  EXPECT_EQ(map->getRows(), 3);
+  EXPECT_EQ(map->getCols(), 5);
+  EXPECT_EQ(map->blockedCount(), 2U);
+  EXPECT_TRUE(map->isBlocked(Position(0, 2)));
+  EXPECT_TRUE(map->isBlocked(Position(2, 1)));
+
+  EXPECT_THROW(ObstacleMap::load(test_dir + "/missing.txt"), FileException);
+  EXPECT_THROW(ObstacleMap::load(createTestFile("ragged.txt", "...\n..\n")), ParseException);
+}
+
+// Word-at-a-time scans must agree with testing one cell after another
+TEST_F(ObstacleMapTest, FreeStepsMatchesCellByCell) {
+  const int   rows = 9;
+  const int   cols = 150;
+  ObstacleMap map  = randomMap(rows, cols, 11);
+
+  const int dx[4] = {0, 1, 0, -1};
+  const int dy[4] = {1, 0, -1, 0};
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      for (unsigned d = 0; d < 4; ++d) {
+        const int     room[4] = {rows - 1 - y, cols - 1 - x, y, x};
+        std::uint32_t limit   = static_cast<std::uint32_t>(room[d]);
+
+        std::uint32_t expected = 0;
+        while (expected < limit && !map.isBlocked(Position(x + dx[d] * static_cast<int>(expected + 1),
+                                                           y + dy[d] * static_cast<int>(expected + 1)))) {
+          ++expected;
+        }
+        ASSERT_EQ(map.freeSteps(x, y, d, limit), expected) << x << "," << y << " direction " << d;
+        ASSERT_EQ(map.freeSteps(x, y, d, limit / 2), std::min(expected, limit / 2));
+      }
+    }
+  }
+}
+
+TEST_F(ObstacleMapTest, IsClearMatchesCellByCell) {
+  ObstacleMap  map = randomMap(12, 140, 5);
+  std::mt19937 random(3);
+
+  for (int i = 0; i < 2000; ++i) {
+    int lowX  = static_cast<int>(random() % 140);
+    int highX = std::min(139, lowX + static_cast<int>(random() % 100));
+    int lowY  = static_cast<int>(random() % 12);
+    int highY = std::min(11, lowY + static_cast<int>(random() % 3));
+
+    bool expected = true;
+    for (int y = lowY; y <= highY; ++y) {
+      for (int x = lowX; x <= highX; ++x) {
+        expected = expected && !map.isBlocked(Position(x, y));
+      }
+    }
+    ASSERT_EQ(map.isClear(lowX, lowY, highX, highY), expected) << lowX << ".." << highX << " x " << lowY << ".."
+                                                               << highY;
+  }
+}
+
+TEST_F(ObstacleMapTest, LargeMapsAreSparse) {
+  EXPECT_TRUE(ObstacleMap(1000, 1000).isDense());
+  EXPECT_NE(ObstacleMap(1000, 1000).data(), nullptr);
+
+  ObstacleMap map(MAX_GROUND_SIDE, MAX_GROUND_SIDE);
+  EXPECT_FALSE(map.isDense());
+  EXPECT_EQ(map.data(), nullptr);
+
+  const Coordinate far = MAX_GROUND_SIDE - 1;
+  map.block(Position(far, far));
+  map.block(Position(0, far));
+  map.block(Position(7, 8));
+  map.block(Position(7, 8));
+  EXPECT_EQ(map.blockedCount(), 3U);
+  EXPECT_TRUE(map.isBlocked(Position(far, far)));
+  EXPECT_TRUE(map.isBlocked(Position(7, 8)));
+  EXPECT_FALSE(map.isBlocked(Position(8, 8)));
+  EXPECT_FALSE(map.isBlocked(Position(far - 1, far)));
+
+  // Rays billions of cells long
+  EXPECT_EQ(map.freeSteps(1, far, 1, UINT32_MAX), UINT32_MAX);
+  EXPECT_EQ(map.freeSteps(far - 4000000000LL, far, 1, 4000000000U), 3999999999U);
+  EXPECT_EQ(map.freeSteps(far, far - 10, 0, 10), 9U);
+  EXPECT_EQ(map.freeSteps(7, 4000000000LL, 2, 4000000000U), 3999999991U);
+  EXPECT_TRUE(map.isClear(8, 0, far, far - 1));
+  EXPECT_FALSE(map.isClear(0, 8, far, far));
+}
+
+// Both ways of walking a sparse map (tile lookups, or a scan of the stored tiles) must agree
+// with a dense map holding the same cells
+TEST_F(ObstacleMapTest, SparseMatchesDense) {
+  const int        rows    = 20;
+  const int        cols    = 150;
+  const Coordinate offsetX = (Coordinate{1} << 39) + 3;
+  const Coordinate offsetY = (Coordinate{1} << 35) + 5;
+
+  for (unsigned oneIn : {8U, 300U}) {
+    ObstacleMap  dense  = randomMap(rows, cols, oneIn, oneIn);
+    ObstacleMap  sparse = sparseCopy(dense, offsetX, offsetY);
+    std::mt19937 random(oneIn);
+    ASSERT_EQ(sparse.blockedCount(), dense.blockedCount());
+
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < cols; ++x) {
+        ASSERT_EQ(sparse.isBlocked(Position(x + offsetX, y + offsetY)), dense.isBlocked(Position(x, y)));
+        for (unsigned d = 0; d < 4; ++d) {
+          const int     room[4] = {rows - 1 - y, cols - 1 - x, y, x};
+          std::uint32_t limit   = static_cast<std::uint32_t>(room[d]);
+          ASSERT_EQ(sparse.freeSteps(x + offsetX, y + offsetY, d, limit), dense.freeSteps(x, y, d, limit))
+            << x << "," << y << " direction " << d << " one in " << oneIn;
+        }
+      }
+    }
+
+    for (int i = 0; i < 2000; ++i) {
+      int lowX  = static_cast<int>(random() % cols);
+      int highX = std::min(cols - 1, lowX + static_cast<int>(random() % 100));
+      int lowY  = static_cast<int>(random() % rows);
+      int highY = std::min(rows - 1, lowY + static_cast<int>(random() % 12));
+      ASSERT_EQ(sparse.isClear(lowX + offsetX, lowY + offsetY, highX + offsetX, highY + offsetY),
+                dense.isClear(lowX, lowY, highX, highY))
+        << lowX << ".." << highX << " x " << lowY << ".." << highY << " one in " << oneIn;
+    }
+  }
+}
+
+TEST_F(ObstacleMapTest, LoadCellList) {
+  const Coordinate side = MAX_GROUND_SIDE;
+  std::string      path = createTestFile("cells.txt", "1000000000000,5\r\n 3 , 4 \n\n0,1099511627775\n");
+
+  std::shared_ptr<const ObstacleMap> map = ObstacleMap::load(path, side, side);
+  EXPECT_EQ(map->getRows(), side);
+  EXPECT_EQ(map->getCols(), side);
+  EXPECT_FALSE(map->isDense());
+  EXPECT_EQ(map->blockedCount(), 3U);
+  EXPECT_TRUE(map->isBlocked(Position(1000000000000, 5)));
+  EXPECT_TRUE(map->isBlocked(Position(3, 4)));
+  EXPECT_TRUE(map->isBlocked(Position(0, side - 1)));
+
+  // Small grounds keep a dense map whatever the file format
+  EXPECT_TRUE(ObstacleMap::load(createTestFile("small.txt", "1,2\n"), 5, 5)->isBlocked(Position(1, 2)));
+
+  EXPECT_THROW(ObstacleMap::load(path), InvalidInputException);
+  EXPECT_THROW(ObstacleMap::load(createTestFile("bad.txt", "1,2\n3;4\n"), 5, 5), ParseException);
+  EXPECT_THROW(ObstacleMap::load(createTestFile("junk.txt", "1,2x\n"), 5, 5), ParseException);
+  EXPECT_THROW(ObstacleMap::load(createTestFile("outside.txt", "1,2\n5,0\n"), 5, 5), ParseException);
+}
@@ -0,0 +1,235 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+class OutputSinkTest : public ::testing::Test {
+protected:
+  OutputSink &sink = OutputSink::getInstance();
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+  std::string       path    = "test_outputsink_results.txt";
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    sink.flush();
+    sink.useConsole();
+    sink.setRobotIds(false);
+    sink.setFormat(OutputFormat::TEXT);
+    sink.setInteractive(false);
+    std::cout.rdbuf(oldCout);
+    std::remove(path.c_str());
+  }
+
+  static std::string readFile(const std::string &name) {
+    std::ifstream     file(name, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+};
+
+TEST_F(OutputSinkTest, BuffersUntilFlush) {
+  sink.report(1, Position(1, 2), Direction::EAST);
+  sink.report(1, Position(0, 4), Direction::WEST);
+  EXPECT_EQ(capturedCout.str(), "");
+
+  sink.flush();
+  EXPECT_EQ(capturedCout.str(), "Output: 1,2,EAST\nOutput: 0,4,WEST\n");
+}
+
+TEST_F(OutputSinkTest, InteractiveWritesEveryResult) {
+  sink.setInteractive(true);
+
+  sink.report(1, Position(3, 0), Direction::SOUTH);
+  EXPECT_EQ(capturedCout.str(), "Output: 3,0,SOUTH\n");
+}
+
+TEST_F(OutputSinkTest, LogLinesFlushPendingResultsFirst) {
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+
+  sink.report(1, Position(0, 0), Direction::NORTH);
+  Logger::getInstance().error("after the report");
+
+  std::string output = capturedCout.str();
+  EXPECT_EQ(output.find("Output: 0,0,NORTH\n"), 0U);
+  EXPECT_NE(output.find("after the report"), std::string::npos);
+}
+
+TEST_F(OutputSinkTest, FormatsFullIntegerRange) {
+  sink.report(1, Position(-2147483647 - 1, 2147483647), Direction::NORTH);
+  sink.flush();
+
+  EXPECT_EQ(capturedCout.str(), "Output: -2147483648,2147483647,NORTH\n");
+}
+
+TEST_F(OutputSinkTest, FlushesWhenBufferIsFull) {
+  const std::string line  = "Output: 12345,67890,SOUTH\n";
+  const std::size_t count = 2 * OutputSink::BUFFER_SIZE / line.size() + 1;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    sink.report(1, Position(12345, 67890), Direction::SOUTH);
+  }
+  EXPECT_GT(capturedCout.str().size(), OutputSink::BUFFER_SIZE);
+  EXPECT_LT(capturedCout.str().size(), count * line.size());
+
+  sink.flush();
+  std::string expected;
+  for (std::size_t i = 0; i < count; ++i) {
+    expected += line;
+  }
+  EXPECT_EQ(capturedCout.str(), expected);
+}
+
+TEST_F(OutputSinkTest, WritesResultsToFile) {
+  sink.openFile(path);
+  EXPECT_FALSE(sink.writesToConsole());
+
+  sink.report(1, Position(4, 4), Direction::EAST);
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+  Logger::getInstance().error("log lines stay on the console");
+  sink.flush();
+
+  EXPECT_EQ(readFile(path), "Output: 4,4,EAST\n");
+  EXPECT_EQ(capturedCout.str().find("Output:"), std::string::npos);
+
+  sink.useConsole();
+  EXPECT_TRUE(sink.writesToConsole());
+}
+
+TEST_F(OutputSinkTest, ThrowsForUnwritablePath) {
+  EXPECT_THROW(sink.openFile("/nonexistent_directory/results.txt"), FileException);
+  EXPECT_TRUE(sink.writesToConsole());
+}
+
+TEST_F(OutputSinkTest, JsonlRecordsCarryLineNumbers) {
+  sink.setFormat(OutputFormat::JSONL);
+  sink.report(12, Position(1, 2), Direction::SOUTH);
+  sink.flush();
+
+  EXPECT_EQ(capturedCout.str(), "{\"line\":12,\"x\":1,\"y\":2,\"direction\":\"SOUTH\"}\n");
+}
+
+TEST_F(OutputSinkTest, CsvStartsWithHeader) {
+  sink.setFormat(OutputFormat::CSV);
+  sink.report(3, Position(0, 4), Direction::WEST);
+  sink.report(9, Position(4, 0), Direction::EAST);
+  sink.flush();
+
+  EXPECT_EQ(capturedCout.str(), "line,x,y,direction\n3,0,4,WEST\n9,4,0,EAST\n");
+}
+
+TEST_F(OutputSinkTest, BinaryRecordsAreFixedSize) {
+  sink.openFile(path);
+  sink.setFormat(OutputFormat::BINARY);
+  sink.report(7, Position(2, 3), Direction::EAST);
+  sink.report(4000000000ULL, Position(-1, 0), Direction::WEST);
+  sink.flush();
+
+  std::string content = readFile(path);
+  ASSERT_EQ(content.size(), rbr::HEADER_SIZE + 2 * rbr::RECORD_SIZE);
+  EXPECT_EQ(content.compare(0, 4, std::string(rbr::MAGIC, 4)), 0);
+  EXPECT_EQ(content[4], rbr::VERSION);
+  EXPECT_EQ(content[6], static_cast<char>(rbr::HEADER_SIZE));
+  EXPECT_EQ(content[8], static_cast<char>(rbr::RECORD_SIZE));
+
+  // Records can be used in place, as a memory-mapped reader would
+  ReportRecord records[2];
+  std::memcpy(records, content.data() + rbr::HEADER_SIZE, sizeof(records));
+  EXPECT_EQ(records[0].line, 7U);
+  EXPECT_EQ(records[0].x, 2);
+  EXPECT_EQ(records[0].y, 3);
+  EXPECT_EQ(records[0].direction, static_cast<std::uint32_t>(Direction::EAST));
+  EXPECT_EQ(records[1].line, 4000000000ULL);
+  EXPECT_EQ(records[1].x, -1);
+  EXPECT_EQ(records[1].direction, static_cast<std::uint32_t>(Direction::WEST));
+}
+
+TEST_F(OutputSinkTest, RobotIdsInEveryFormat) {
+  sink.setRobotIds(true);
+
+  sink.report(2, Position(1, 2), Direction::NORTH, 5);
+  sink.setFormat(OutputFormat::JSONL);
+  sink.report(3, Position(1, 2), Direction::NORTH, 5);
+  sink.setFormat(OutputFormat::CSV);
+  sink.report(4, Position(1, 2), Direction::NORTH, 5);
+  sink.flush();
+
+  EXPECT_EQ(capturedCout.str(), "5: Output: 1,2,NORTH\n"
+                                "{\"line\":3,\"robot\":5,\"x\":1,\"y\":2,\"direction\":\"NORTH\"}\n"
+                                "line,robot,x,y,direction\n4,5,1,2,NORTH\n");
+
+  sink.openFile(path);
+  sink.setFormat(OutputFormat::BINARY);
+  sink.report(6, Position(0, 0), Direction::SOUTH, 70000);
+  sink.flush();
+
+  ReportRecord record;
+  std::string  content = readFile(path);
+  ASSERT_EQ(content.size(), rbr::HEADER_SIZE + rbr::RECORD_SIZE);
+  std::memcpy(&record, content.data() + rbr::HEADER_SIZE, sizeof(record));
+  EXPECT_EQ(record.robot, 70000U);
+}
+
+TEST_F(OutputSinkTest, CaptureKeepsThreadOutputApart) {
+  sink.report(1, Position(0, 0), Direction::NORTH);
+
+  std::string captured;
+  std::thread worker([&] {
+    OutputSink::Capture capture(captured);
+    sink.report(2, Position(1, 1), Direction::EAST);
+    sink.print("notice\n");
+    Logger::getInstance().setLogLevel(LogLevel::ERROR);
+    Logger::getInstance().error("failed");
+    sink.flush();
+  });
+  worker.join();
+  Logger::getInstance().setLogLevel(LogLevel::NONE);
+
+  EXPECT_EQ(OutputSink::captured(), nullptr);
+  EXPECT_EQ(captured.substr(0, 27), "Output: 1,1,EAST\nnotice\n[20");
+  EXPECT_NE(captured.find("failed\n"), std::string::npos);
+
+  sink.write(captured);
+  sink.flush();
+  EXPECT_EQ(capturedCout.str(), "Output: 0,0,NORTH\n" + captured);
+}
+
+// Every engine must tag each result with the line of its REPORT
+TEST_F(OutputSinkTest, EnginesReportSourceLines) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH", "MOVE",   "REPORT", "MOVE",  "MOVE",
+                                 "RIGHT",           "REPORT", "JUMP",   "REPORT"};
+
+  Optimizations fuse;
+  fuse.fuseRuns = true;
+
+  sink.setFormat(OutputFormat::CSV);
+  sink.flush();
+  for (Engine engine : {Engine::STEP, Engine::TABLE, Engine::FLEET, Engine::VM, Engine::SEGMENT}) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(5, 5), engine, engine == Engine::VM ? fuse : Optimizations());
+    sim.run();
+
+    EXPECT_EQ(capturedCout.str(), "3,0,1,NORTH\n7,0,3,EAST\n9,0,3,EAST\n");
+  }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "PackedRobot.hpp"
+#include "Robot.hpp"
+#include "SimulatorGround.hpp"
+
+using namespace simulator;
+
+TEST(PackedRobotTest, DefaultIsUnplaced) {
+  PackedRobot robot;
+
+  EXPECT_FALSE(robot.hasPlaced());
+  EXPECT_EQ(robot.raw(), 0U);
+  EXPECT_FALSE(robot.toRobot().hasPlaced());
+}
+
+TEST(PackedRobotTest, RoundTripsThroughRobot) {
+  Robot robot;
+  robot.place(Position(16383, 9000), Direction::WEST);
+
+  PackedRobot packed = PackedRobot::fromRobot(robot);
+  EXPECT_TRUE(packed.hasPlaced());
+  EXPECT_EQ(packed.getPosition(), Position(16383, 9000));
+  EXPECT_EQ(packed.getDirection(), Direction::WEST);
+
+  Robot back = packed.toRobot();
+  EXPECT_EQ(back.getPosition(), robot.getPosition());
+  EXPECT_EQ(back.getDirection(), robot.getDirection());
+}
+
+TEST(PackedRobotTest, FitsGroundsUpToMaxSide) {
+  EXPECT_TRUE(PackedRobot::fits(5, 5));
+  EXPECT_TRUE(PackedRobot::fits(PackedRobot::MAX_SIDE, PackedRobot::MAX_SIDE));
+  EXPECT_FALSE(PackedRobot::fits(PackedRobot::MAX_SIDE + 1, 5));
+  EXPECT_FALSE(PackedRobot::fits(5, PackedRobot::MAX_SIDE + 1));
+}
+
+TEST(PackedRobotTest, UnplacedRobotDoesNotMoveOrRotate) {
+  PackedRobot robot;
+
+  EXPECT_FALSE(robot.move(5, 5));
+  robot.rotateLeft();
+  robot.rotateRight();
+  EXPECT_EQ(robot, PackedRobot());
+}
+
+// Every state of a few grounds must move and rotate exactly like Robot
+TEST(PackedRobotTest, MatchesRobotKinematics) {
+  for (auto size : {std::make_pair(1, 1), std::make_pair(5, 5), std::make_pair(3, 7)}) {
+    SimulatorGround ground(size.first, size.second);
+    const auto      cols = static_cast<std::uint32_t>(ground.getCols());
+    const auto      rows = static_cast<std::uint32_t>(ground.getRows());
+
+    for (int x = 0; x < ground.getCols(); ++x) {
+      for (int y = 0; y < ground.getRows(); ++y) {
+        for (Direction direction : {Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST}) {
+          Robot robot;
+          robot.place(Position(x, y), direction);
+          PackedRobot packed = PackedRobot::fromRobot(robot);
+
+          ASSERT_EQ(packed.nextPosition(), robot.calculateNextPosition());
+
+          PackedRobot moved  = packed;
+          bool        inside = ground.isValidPosition(robot.calculateNextPosition());
+          ASSERT_EQ(moved.move(cols, rows), inside);
+          if (inside) {
+            robot.move();
+          }
+          ASSERT_EQ(moved.getPosition(), robot.getPosition());
+          ASSERT_EQ(moved.getDirection(), robot.getDirection());
+
+          PackedRobot left  = packed;
+          PackedRobot right = packed;
+          left.rotateLeft();
+          right.rotateRight();
+          Robot reference = packed.toRobot();
+          reference.rotateLeft();
+          ASSERT_EQ(left.getDirection(), reference.getDirection());
+          ASSERT_EQ(left.getPosition(), packed.getPosition());
+          reference = packed.toRobot();
+          reference.rotateRight();
+          ASSERT_EQ(right.getDirection(), reference.getDirection());
+        }
+      }
+    }
+  }
+}
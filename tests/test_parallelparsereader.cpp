@@ -0,0 +1,140 @@
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "FileReader.hpp"
+#include "ParallelParseReader.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class ParallelParseReaderTest : public ::testing::Test {
+protected:
+  std::string    test_dir = "/tmp/parallelParseReaderTest_" + std::to_string(std::rand());
+  CommandFactory factory;
+
+  void SetUp() override {
+    std::string cmd = "mkdir -p " + test_dir;
+    system(cmd.c_str());
+  }
+
+  void TearDown() override {
+    // Clean up test directory using system call
+    std::string cmd = "rm -rf " + test_dir;
+    system(cmd.c_str());
+  }
+
+  std::string createTestFile(const std::string &filename, const std::string &content) {
+    std::string   filepath = test_dir + "/" + filename;
+    std::ofstream file(filepath);
+    if (file.is_open()) {
+      file << content;
+      file.close();
+    }
+    return filepath;
+  }
+
+  std::string generateScript(std::size_t lines) {
+    const char *samples[] = {"PLACE 1,2,NORTH", "MOVE", "", "left", "JUMP", "RIGHT", "  REPORT  ", "PLACE 9,9,EAST"};
+    std::string content;
+    for (std::size_t i = 0; i < lines; ++i) {
+      content += samples[i % 8];
+      content += '\n';
+    }
+    return content;
+  }
+};
+
+TEST_F(ParallelParseReaderTest, MatchesSerialReaderForAnyChunkSize) {
+  std::string filepath = createTestFile("input.txt", generateScript(500) + "MOVE");
+
+  FileReader serial(filepath);
+  auto       expected = serial.readInput();
+
+  for (std::size_t chunkSize : std::vector<std::size_t>{1, 3, 16, 100, 4096}) {
+    for (unsigned threads : {1U, 2U, 4U}) {
+      ParallelParseReader reader(filepath, threads, chunkSize);
+      ParsedCommand       command;
+      std::string_view    line;
+
+      for (const auto &text : expected) {
+        ASSERT_TRUE(reader.nextCommand(factory, command, line));
+        ASSERT_EQ(line, text);
+        ParsedCommand serialCommand = factory.decode(text);
+        EXPECT_EQ(command.opcode, serialCommand.opcode);
+        EXPECT_EQ(command.error, serialCommand.error);
+        EXPECT_EQ(command.position, serialCommand.position);
+      }
+      EXPECT_FALSE(reader.nextCommand(factory, command, line));
+    }
+  }
+}
+
+TEST_F(ParallelParseReaderTest, LinesLongerThanChunk) {
+  std::string filepath = createTestFile("input.txt", "PLACE 1,2,NORTH\nMOVE\n\nREPORT\n");
+
+  ParallelParseReader reader(filepath, 3, 4);
+  auto                lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 4);
+  EXPECT_EQ(lines[0], "PLACE 1,2,NORTH");
+  EXPECT_EQ(lines[2], "");
+  EXPECT_EQ(lines[3], "REPORT");
+}
+
+TEST_F(ParallelParseReaderTest, ReadEmptyFile) {
+  std::string         filepath = createTestFile("empty.txt", "");
+  ParallelParseReader reader(filepath, 2);
+
+  std::string_view line;
+  EXPECT_FALSE(reader.nextLine(line));
+}
+
+TEST_F(ParallelParseReaderTest, NonExistentFile) {
+  ParallelParseReader reader("/somewhere/unknown/path/file.txt", 2);
+
+  EXPECT_THROW(reader.readInput(), FileException);
+}
+
+TEST_F(ParallelParseReaderTest, DestroyBeforeFullyConsumed) {
+  std::string         filepath = createTestFile("input.txt", generateScript(10000));
+  ParallelParseReader reader(filepath, 4, 64);
+
+  std::string_view line;
+  EXPECT_TRUE(reader.nextLine(line));
+  // Destructor must stop workers that are still waiting for free slots
+}
+
+TEST_F(ParallelParseReaderTest, SimulatorKeepsSerialLineNumbers) {
+  std::string filepath = createTestFile("input.txt", generateScript(64));
+
+  auto runWith = [&](std::unique_ptr<InputReader> reader) {
+    std::stringstream capturedCout;
+    std::streambuf   *oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+    Logger::getInstance().setLogLevel(LogLevel::ERROR);
+
+    RobotSimulator sim(std::move(reader), std::make_unique<CommandFactory>(), std::make_unique<SimulatorGround>(5, 5));
+    sim.run();
+
+    std::cout.rdbuf(oldCout);
+    return capturedCout.str();
+  };
+
+  std::string serial   = runWith(std::make_unique<FileReader>(filepath));
+  std::string parallel = runWith(std::make_unique<ParallelParseReader>(filepath, 4, 32));
+
+  // Strip the timestamps so the logs can be compared line by line
+  auto strip = [](const std::string &log) {
+    std::istringstream in(log);
+    std::string        line;
+    std::string        out;
+    while (std::getline(in, line)) {
+      out += line.substr(std::min(line.size(), line.find(']') + 1)) + "\n";
+    }
+    return out;
+  };
+
+  EXPECT_NE(serial.find("Parse error on line 5"), std::string::npos);
+  EXPECT_EQ(strip(serial), strip(parallel));
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "PipelinedReader.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+#include "utils.hpp"
+
+using namespace simulator;
+
+class VectorInputReader : public InputReader {
+public:
+  VectorInputReader(const std::vector<std::string> &test_lines, bool failAtEnd = false)
+    : test_lines(test_lines)
+    , failAtEnd(failAtEnd) {}
+
+  bool nextLine(std::string_view &line) override {
+    if (next >= test_lines.size()) {
+      if (failAtEnd) {
+        throw FileException("broken.txt");
+      }
+      return false;
+    }
+    line = test_lines[next++];
+    return true;
+  }
+
+private:
+  std::vector<std::string> test_lines;
+  bool                     failAtEnd;
+  std::size_t              next = 0;
+};
+
+// Source that decodes on its own, like a compiled script; its text path must not be used
+class DecodingInputReader : public InputReader {
+public:
+  explicit DecodingInputReader(const std::vector<std::string> &test_lines) : test_lines(test_lines) {}
+
+  bool nextLine(std::string_view &line) override {
+    UNUSED(line);
+    ADD_FAILURE() << "nextLine() called on a source that decodes commands";
+    return false;
+  }
+
+  bool nextCommand(const CommandFactory &factory, ParsedCommand &command, std::string_view &line) override {
+    UNUSED(factory);
+    if (next >= test_lines.size()) {
+      return false;
+    }
+    line    = test_lines[next++];
+    command = decoder.decode(line);
+    return true;
+  }
+
+  bool decodesCommands() const override {
+    return true;
+  }
+
+private:
+  std::vector<std::string> test_lines;
+  CommandFactory           decoder;
+  std::size_t              next = 0;
+};
+
+class PipelinedReaderTest : public ::testing::Test {
+protected:
+  CommandFactory factory;
+
+  std::vector<std::string> generateScript(std::size_t lines) {
+    const char *samples[] = {"PLACE 1,2,NORTH", "MOVE", "", "left", "JUMP", "RIGHT", "REPORT"};
+    std::vector<std::string> script;
+    for (std::size_t i = 0; i < lines; ++i) {
+      script.push_back(std::string(samples[i % 7]) + (i % 3 == 0 ? "  " : ""));
+    }
+    return script;
+  }
+};
+
+TEST_F(PipelinedReaderTest, ThrowByConstructorForNullSource) {
+  EXPECT_THROW(PipelinedReader(nullptr, 4), InvalidInputException);
+}
+
+TEST_F(PipelinedReaderTest, DeliversEveryLineInOrder) {
+  auto            script = generateScript(10000);
+  PipelinedReader reader(std::make_unique<VectorInputReader>(script), 8);
+
+  ParsedCommand    command;
+  std::string_view line;
+  for (const auto &text : script) {
+    ASSERT_TRUE(reader.nextCommand(factory, command, line));
+    ASSERT_EQ(line, text);
+    ParsedCommand expected = factory.decode(text);
+    EXPECT_EQ(command.opcode, expected.opcode);
+    EXPECT_EQ(command.error, expected.error);
+  }
+  EXPECT_FALSE(reader.nextCommand(factory, command, line));
+  EXPECT_FALSE(reader.nextCommand(factory, command, line));
+}
+
+TEST_F(PipelinedReaderTest, DecodingSourceSkipsParserStage) {
+  auto            script = generateScript(10000);
+  PipelinedReader reader(std::make_unique<DecodingInputReader>(script), 8);
+
+  ParsedCommand    command;
+  std::string_view line;
+  for (const auto &text : script) {
+    ASSERT_TRUE(reader.nextCommand(factory, command, line));
+    ASSERT_EQ(line, text);
+    ParsedCommand expected = factory.decode(text);
+    EXPECT_EQ(command.opcode, expected.opcode);
+    EXPECT_EQ(command.error, expected.error);
+  }
+  EXPECT_FALSE(reader.nextCommand(factory, command, line));
+
+  PipelineStats stats = reader.getStats();
+  EXPECT_EQ(stats.maxLineQueueDepth, 0);
+  EXPECT_EQ(stats.parserStarved, 0);
+  EXPECT_GT(stats.maxCommandQueueDepth, 0);
+  EXPECT_LE(stats.maxCommandQueueDepth, 8);
+  EXPECT_TRUE(reader.decodesCommands());
+}
+
+TEST_F(PipelinedReaderTest, StatsStayWithinQueueCapacity) {
+  PipelinedReader reader(std::make_unique<VectorInputReader>(generateScript(5000)), 16);
+
+  auto lines = reader.readInput();
+
+  PipelineStats stats = reader.getStats();
+  EXPECT_EQ(lines.size(), 5000);
+  EXPECT_EQ(stats.queueCapacity, 16);
+  EXPECT_GT(stats.maxLineQueueDepth, 0);
+  EXPECT_LE(stats.maxLineQueueDepth, 16);
+  EXPECT_LE(stats.maxCommandQueueDepth, 16);
+  EXPECT_GE(stats.executorStarved, 1);
+}
+
+TEST_F(PipelinedReaderTest, RethrowsSourceErrorsAfterDeliveredLines) {
+  PipelinedReader reader(std::make_unique<VectorInputReader>(std::vector<std::string>{"MOVE", "LEFT"}, true), 4);
+
+  std::string_view line;
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "MOVE");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "LEFT");
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
+
+TEST_F(PipelinedReaderTest, DestroyBeforeFullyConsumed) {
+  PipelinedReader reader(std::make_unique<VectorInputReader>(generateScript(10000)), 4);
+
+  std::string_view line;
+  EXPECT_TRUE(reader.nextLine(line));
+  // Destructor must stop stages that are waiting on full queues
+}
+
+TEST_F(PipelinedReaderTest, SimulatorRunsPipelinedInput) {
+  std::vector<std::string> script{"PLACE 0,0,NORTH", "MOVE", "JUMP", "REPORT"};
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  Logger::getInstance().setLogLevel(LogLevel::INFO);
+
+  RobotSimulator sim(std::make_unique<PipelinedReader>(std::make_unique<VectorInputReader>(script), 2),
+                     std::make_unique<CommandFactory>(), std::make_unique<SimulatorGround>(5, 5));
+  sim.run();
+
+  std::cout.rdbuf(oldCout);
+  std::string output = capturedCout.str();
+  EXPECT_NE(output.find("Output: 0,1,NORTH"), std::string::npos);
+  EXPECT_NE(output.find("Parse error on line 3"), std::string::npos);
+  EXPECT_NE(output.find("Pipeline stalls:"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 1 Errors."), std::string::npos);
+}
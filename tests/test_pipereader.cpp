@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+#include "PipeReader.hpp"
+#include "SimulatorException.hpp"
+
+using namespace simulator;
+
+class PipeReaderTest : public ::testing::Test {
+protected:
+  int fds[2] = {-1, -1};
+
+  void SetUp() override {
+    ASSERT_EQ(pipe(fds), 0);
+  }
+
+  void TearDown() override {
+    closeWriteEnd();
+    close(fds[0]);
+  }
+
+  void send(const std::string &data) {
+    ASSERT_EQ(write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+  }
+
+  void closeWriteEnd() {
+    if (fds[1] >= 0) {
+      close(fds[1]);
+      fds[1] = -1;
+    }
+  }
+};
+
+TEST_F(PipeReaderTest, ReadsUntilEndOfStream) {
+  send("PLACE 0,0,NORTH\nMOVE\n\nREPORT\n");
+  closeWriteEnd();
+  PipeReader reader(fds[0]);
+
+  auto lines = reader.readInput();
+
+  // Empty lines do not terminate piped input
+  ASSERT_EQ(lines.size(), 4);
+  EXPECT_EQ(lines[0], "PLACE 0,0,NORTH");
+  EXPECT_EQ(lines[2], "");
+  EXPECT_EQ(lines[3], "REPORT");
+}
+
+TEST_F(PipeReaderTest, FinalLineWithoutNewline) {
+  send("MOVE\nLEFT");
+  closeWriteEnd();
+  PipeReader reader(fds[0]);
+
+  auto lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[1], "LEFT");
+}
+
+TEST_F(PipeReaderTest, LinesSpanningBufferBoundaries) {
+  std::string content;
+  for (int i = 0; i < 200; ++i) {
+    content += "PLACE " + std::to_string(i) + "," + std::to_string(i * 7) + ",NORTH\n";
+  }
+  send(content);
+  closeWriteEnd();
+
+  // Tiny buffer: lines are split across reads and some exceed the initial size
+  PipeReader reader(fds[0], 8);
+  auto       lines = reader.readInput();
+
+  ASSERT_EQ(lines.size(), 200);
+  EXPECT_EQ(lines[0], "PLACE 0,0,NORTH");
+  EXPECT_EQ(lines[199], "PLACE 199,1393,NORTH");
+}
+
+TEST_F(PipeReaderTest, ReturnsLinesAsTheyArrive) {
+  PipeReader       reader(fds[0]);
+  std::string_view line;
+
+  // The writer is still open: the first line must be returned without waiting for EOF
+  send("PLACE 1,1,EAST\n");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "PLACE 1,1,EAST");
+
+  send("REPORT\n");
+  ASSERT_TRUE(reader.nextLine(line));
+  EXPECT_EQ(line, "REPORT");
+
+  closeWriteEnd();
+  EXPECT_FALSE(reader.nextLine(line));
+}
+
+TEST_F(PipeReaderTest, ThrowByReaderForInvalidDescriptor) {
+  PipeReader       reader(-1);
+  std::string_view line;
+
+  EXPECT_THROW(reader.nextLine(line), FileException);
+}
@@ -0,0 +1,69 @@
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "QueueSignal.hpp"
+
+using namespace simulator;
+
+class QueueSignalTest : public ::testing::Test {
+protected:
+  QueueSignal      signal;
+  std::atomic<int> published{0};
+};
+
+TEST_F(QueueSignalTest, ReturnsAtOnceWhenReady) {
+  int checks = 0;
+  signal.wait([&]() {
+    ++checks;
+    return true;
+  });
+
+  EXPECT_EQ(checks, 1);
+}
+
+TEST_F(QueueSignalTest, SleeperWakesOnNotify) {
+  std::atomic<int> checks{0};
+  std::thread      waiter([&]() {
+    signal.wait([&]() {
+      checks.fetch_add(1, std::memory_order_relaxed);
+      return published.load(std::memory_order_acquire) != 0;
+    });
+  });
+
+  // Give the waiter time to exhaust its spins and go to sleep
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  int checksWhileAsleep = checks.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(checks.load(), checksWhileAsleep);
+  EXPECT_GT(checksWhileAsleep, static_cast<int>(QueueSignal::SPIN_LIMIT));
+
+  published.store(1, std::memory_order_release);
+  signal.notify();
+  waiter.join();
+}
+
+TEST_F(QueueSignalTest, NoWakeUpIsLostUnderContention) {
+  constexpr int    ROUNDS = 20000;
+  std::atomic<int> acknowledged{0};
+  QueueSignal      reply;
+
+  // Ping-pong: each side waits for the other's counter, exercising both the spin and the sleep path
+  std::thread consumer([&]() {
+    for (int round = 1; round <= ROUNDS; ++round) {
+      signal.wait([&]() { return published.load(std::memory_order_acquire) >= round; });
+      acknowledged.store(round, std::memory_order_release);
+      reply.notify();
+    }
+  });
+
+  for (int round = 1; round <= ROUNDS; ++round) {
+    published.store(round, std::memory_order_release);
+    signal.notify();
+    reply.wait([&]() { return acknowledged.load(std::memory_order_acquire) >= round; });
+  }
+  consumer.join();
+
+  EXPECT_EQ(acknowledged.load(), ROUNDS);
+}
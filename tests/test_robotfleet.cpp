@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "RobotFleet.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorGround.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+class RobotFleetTest : public ::testing::Test {
+protected:
+  CommandFactory  factory;
+  SimulatorGround ground = SimulatorGround(5, 5);
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    OutputSink::getInstance().flush();
+    OutputSink::getInstance().setRobotIds(false);
+    std::cout.rdbuf(oldCout);
+  }
+
+  // REPORT results are buffered until flushed
+  std::string output() {
+    OutputSink::getInstance().flush();
+    return capturedCout.str();
+  }
+
+  // Console output of a whole fleet simulation, with log timestamps removed
+  std::string simulate(const std::vector<std::string> &lines) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(5, 5), Engine::FLEET);
+    sim.run();
+    return std::regex_replace(capturedCout.str(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  }
+};
+
+TEST_F(RobotFleetTest, ParseAddress) {
+  std::uint32_t    robot = 7;
+  std::string_view command;
+
+  EXPECT_EQ(RobotFleet::parseAddress("MOVE", robot, command), RobotFleet::Address::OK);
+  EXPECT_EQ(robot, 0U);
+  EXPECT_EQ(command, "MOVE");
+
+  EXPECT_EQ(RobotFleet::parseAddress("  12 : PLACE 1,2,NORTH", robot, command), RobotFleet::Address::OK);
+  EXPECT_EQ(robot, 12U);
+  EXPECT_EQ(command, " PLACE 1,2,NORTH");
+
+  EXPECT_EQ(RobotFleet::parseAddress("*: REPORT", robot, command), RobotFleet::Address::OK);
+  EXPECT_EQ(robot, RobotFleet::ALL_ROBOTS);
+  EXPECT_EQ(command, " REPORT");
+
+  // Not an address: the whole line is handed to the parser
+  EXPECT_EQ(RobotFleet::parseAddress("12 MOVE", robot, command), RobotFleet::Address::OK);
+  EXPECT_EQ(robot, 0U);
+  EXPECT_EQ(command, "12 MOVE");
+
+  EXPECT_EQ(RobotFleet::parseAddress("1048576: MOVE", robot, command), RobotFleet::Address::INVALID_ID);
+  EXPECT_EQ(RobotFleet::parseAddress("99999999999999999999999: MOVE", robot, command),
+            RobotFleet::Address::INVALID_ID);
+  EXPECT_EQ(RobotFleet::parseAddress("1048575: MOVE", robot, command), RobotFleet::Address::OK);
+  EXPECT_EQ(robot, RobotFleet::MAX_ROBOTS - 1);
+}
+
+TEST_F(RobotFleetTest, RobotsAreCreatedOnFirstUse) {
+  RobotFleet fleet(ground);
+
+  EXPECT_TRUE(ground.tracksOccupancy());
+  EXPECT_EQ(fleet.size(), 0U);
+
+  EXPECT_TRUE(fleet.tryExecute(3, factory.decode("PLACE 1,1,EAST")).ok());
+  EXPECT_EQ(fleet.size(), 4U);
+  EXPECT_EQ(fleet.placedCount(), 1U);
+  EXPECT_FALSE(fleet.robot(0).hasPlaced());
+  EXPECT_FALSE(fleet.robot(100).hasPlaced());
+
+  Robot robot = fleet.robot(3);
+  ASSERT_TRUE(robot.hasPlaced());
+  EXPECT_EQ(robot.getPosition(), Position(1, 1));
+  EXPECT_EQ(robot.getDirection(), Direction::EAST);
+}
+
+TEST_F(RobotFleetTest, MatchesSingleRobotSemantics) {
+  RobotFleet fleet(ground);
+
+  ExecutionResult result = fleet.tryExecute(0, factory.decode("MOVE"), 1);
+  EXPECT_EQ(result.error, ExecutionError::NOT_PLACED);
+  EXPECT_EQ(result.robot, 0U);
+  EXPECT_EQ(result.line, 1U);
+
+  result = fleet.tryExecute(2, factory.decode("PLACE 5,0,NORTH"));
+  EXPECT_EQ(result.error, ExecutionError::PLACE_OUT_OF_BOUNDS);
+  EXPECT_EQ(result.robot, 2U);
+
+  EXPECT_TRUE(fleet.tryExecute(2, factory.decode("PLACE 4,4,NORTH")).ok());
+  result = fleet.tryExecute(2, factory.decode("MOVE"));
+  EXPECT_EQ(result.error, ExecutionError::MOVE_OUT_OF_BOUNDS);
+  EXPECT_EQ(result.position, Position(4, 5));
+
+  EXPECT_TRUE(fleet.tryExecute(2, factory.decode("LEFT")).ok());
+  EXPECT_TRUE(fleet.tryExecute(2, factory.decode("MOVE")).ok());
+  EXPECT_EQ(fleet.robot(2).getPosition(), Position(3, 4));
+  EXPECT_EQ(fleet.robot(2).getDirection(), Direction::WEST);
+  EXPECT_TRUE(fleet.tryExecute(2, factory.decode("RIGHT")).ok());
+  EXPECT_EQ(fleet.robot(2).getDirection(), Direction::NORTH);
+}
+
+TEST_F(RobotFleetTest, CollisionsAreRejected) {
+  RobotFleet fleet(ground);
+
+  EXPECT_TRUE(fleet.tryExecute(0, factory.decode("PLACE 0,0,NORTH")).ok());
+  EXPECT_TRUE(fleet.tryExecute(1, factory.decode("PLACE 0,1,SOUTH")).ok());
+  EXPECT_TRUE(ground.isOccupied(Position(0, 0)));
+  EXPECT_TRUE(ground.isOccupied(Position(0, 1)));
+
+  ExecutionResult result = fleet.tryExecute(1, factory.decode("MOVE"));
+  EXPECT_EQ(result.error, ExecutionError::OCCUPIED);
+  EXPECT_EQ(result.position, Position(0, 0));
+  EXPECT_EQ(CommandExecutor::describe(result, ground), "Cannot move to 0,0: position occupied by another robot");
+  EXPECT_EQ(fleet.robot(1).getPosition(), Position(0, 1));
+
+  result = fleet.tryExecute(2, factory.decode("PLACE 0,1,EAST"));
+  EXPECT_EQ(result.error, ExecutionError::OCCUPIED);
+  EXPECT_EQ(CommandExecutor::describe(result, ground),
+            "Cannot PLACE robot at 0,1: position occupied by another robot");
+  EXPECT_FALSE(fleet.robot(2).hasPlaced());
+
+  // A robot may be placed again on its own cell, and leaving a cell frees it
+  EXPECT_TRUE(fleet.tryExecute(1, factory.decode("PLACE 0,1,EAST")).ok());
+  EXPECT_TRUE(fleet.tryExecute(1, factory.decode("MOVE")).ok());
+  EXPECT_FALSE(ground.isOccupied(Position(0, 1)));
+  EXPECT_TRUE(ground.isOccupied(Position(1, 1)));
+  EXPECT_TRUE(fleet.tryExecute(0, factory.decode("MOVE")).ok());
+
+  // Re-placing elsewhere frees the old cell as well
+  EXPECT_TRUE(fleet.tryExecute(0, factory.decode("PLACE 3,3,NORTH")).ok());
+  EXPECT_FALSE(ground.isOccupied(Position(0, 1)));
+  EXPECT_TRUE(ground.isOccupied(Position(3, 3)));
+}
+
+TEST_F(RobotFleetTest, FleetReleasesOccupancy) {
+  {
+    RobotFleet fleet(ground);
+    fleet.tryExecute(0, factory.decode("PLACE 2,2,NORTH"));
+    EXPECT_TRUE(ground.isOccupied(Position(2, 2)));
+  }
+  EXPECT_FALSE(ground.tracksOccupancy());
+  EXPECT_FALSE(ground.isOccupied(Position(2, 2)));
+}
+
+TEST_F(RobotFleetTest, TickRunsEveryPlacedRobotInIdOrder) {
+  RobotFleet fleet(ground);
+  fleet.tryExecute(0, factory.decode("PLACE 0,0,EAST"));
+  fleet.tryExecute(1, factory.decode("PLACE 1,0,EAST"));
+  fleet.tryExecute(3, factory.decode("PLACE 4,4,EAST"));
+
+  std::vector<ExecutionResult> failures;
+  fleet.tick(factory.decode("MOVE"), 9, [&](const ExecutionResult &result) { failures.push_back(result); });
+
+  // Robot 0 is blocked by robot 1, which moves afterwards; robot 2 is not placed and skipped
+  ASSERT_EQ(failures.size(), 2U);
+  EXPECT_EQ(failures[0].robot, 0U);
+  EXPECT_EQ(failures[0].error, ExecutionError::OCCUPIED);
+  EXPECT_EQ(failures[0].line, 9U);
+  EXPECT_EQ(failures[1].robot, 3U);
+  EXPECT_EQ(failures[1].error, ExecutionError::MOVE_OUT_OF_BOUNDS);
+  EXPECT_EQ(fleet.robot(0).getPosition(), Position(0, 0));
+  EXPECT_EQ(fleet.robot(1).getPosition(), Position(2, 0));
+  EXPECT_FALSE(fleet.robot(2).hasPlaced());
+}
+
+TEST_F(RobotFleetTest, TickPlacesEveryRobotAndResolvesCollisionsInIdOrder) {
+  RobotFleet fleet(ground);
+  fleet.tryExecute(2, factory.decode("PLACE 0,0,NORTH"));
+
+  std::vector<ExecutionResult> failures;
+  fleet.tick(factory.decode("PLACE 3,3,EAST"), 4, [&](const ExecutionResult &result) { failures.push_back(result); });
+
+  // Unplaced robots take part in a broadcast PLACE; robot 0 claims the cell first
+  ASSERT_EQ(failures.size(), 2U);
+  EXPECT_EQ(failures[0].robot, 1U);
+  EXPECT_EQ(failures[0].error, ExecutionError::OCCUPIED);
+  EXPECT_EQ(failures[1].robot, 2U);
+  EXPECT_EQ(failures[1].error, ExecutionError::OCCUPIED);
+  EXPECT_EQ(failures[1].line, 4U);
+
+  ASSERT_TRUE(fleet.robot(0).hasPlaced());
+  EXPECT_EQ(fleet.robot(0).getPosition(), Position(3, 3));
+  EXPECT_EQ(fleet.robot(0).getDirection(), Direction::EAST);
+  EXPECT_FALSE(fleet.robot(1).hasPlaced());
+  EXPECT_EQ(fleet.robot(2).getPosition(), Position(0, 0));
+  EXPECT_EQ(fleet.placedCount(), 2U);
+}
+
+TEST_F(RobotFleetTest, ReportsCarryRobotIds) {
+  OutputSink::getInstance().setRobotIds(true);
+  RobotFleet fleet(ground);
+
+  fleet.tryExecute(0, factory.decode("REPORT"));
+  fleet.tryExecute(4, factory.decode("PLACE 1,2,WEST"));
+  fleet.tryExecute(4, factory.decode("REPORT"));
+
+  EXPECT_EQ(output(), "4: Output: 1,2,WEST\n");
+}
+
+TEST_F(RobotFleetTest, RunSimulatorWithFleetEngine) {
+  OutputSink::getInstance().setRobotIds(true);
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+
+  std::string out = simulate({"0: PLACE 0,0,NORTH", "1: PLACE 0,1,SOUTH", "1: MOVE", "PLACE 0,0,EAST", "*: MOVE",
+                              "*: REPORT", "1048576: REPORT", "2: JUMP"});
+
+  EXPECT_NE(out.find("Execution error on line 3 (robot 1): Invalid input: Cannot move to 0,0: position occupied"),
+            std::string::npos);
+  EXPECT_NE(out.find("Parse error on line 7: Invalid robot id in '1048576: REPORT'"), std::string::npos);
+  EXPECT_NE(out.find("Parse error on line 8: Parse error: Unknown command: JUMP"), std::string::npos);
+  EXPECT_NE(out.find("0: Output: 1,0,EAST\n1: Output: 0,0,SOUTH\n"), std::string::npos);
+}
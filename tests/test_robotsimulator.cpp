@@ -1,13 +1,19 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <random>
+#include <regex>
 #include <sstream>
 #include <vector>
 
+#include "CommandExecutor.hpp"
 #include "CommandFactory.hpp"
+#include "ObstacleMap.hpp"
+#include "OutputSink.hpp"
 #include "Robot.hpp"
 #include "RobotSimulator.hpp"
 #include "SimulatorException.hpp"
 #include "SimulatorGround.hpp"
+#include "StaticGround.hpp"
 
 using namespace simulator;
 
@@ -15,12 +21,41 @@ class MockInputReader : public InputReader {
 public:
   MockInputReader(const std::vector<std::string> &test_lines) : test_lines(test_lines) {}
 
-  std::vector<std::string> readInput() override {
-    return test_lines;
+  bool nextLine(std::string_view &line) override {
+    if (next >= test_lines.size()) {
+      return false;
+    }
+    line = test_lines[next++];
+    return true;
   }
 
 private:
   std::vector<std::string> test_lines;
+  std::size_t              next = 0;
+};
+
+// Reader that records what the simulator has printed by the time each line is requested
+class ObservingInputReader : public InputReader {
+public:
+  ObservingInputReader(const std::vector<std::string> &test_lines, const std::stringstream &output)
+    : test_lines(test_lines)
+    , output(output) {}
+
+  bool nextLine(std::string_view &line) override {
+    outputBeforeRead.push_back(output.str());
+    if (next >= test_lines.size()) {
+      return false;
+    }
+    line = test_lines[next++];
+    return true;
+  }
+
+  std::vector<std::string> outputBeforeRead;
+
+private:
+  std::vector<std::string> test_lines;
+  const std::stringstream &output;
+  std::size_t              next = 0;
 };
 
 class RobotSimulatorTest : public ::testing::Test {
@@ -196,3 +231,248 @@ TEST_F(RobotSimulatorTest, RunSimulatorMultipleInvalidCommandsInput) {
   std::string output = getCapturedOutput();
   EXPECT_NE(output.find("Simulation completed with 3 Errors"), std::string::npos);
 }
+
+TEST_F(RobotSimulatorTest, RunSimulatorExecutesCommandsBeforeInputIsExhausted) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH", "REPORT", "MOVE", "REPORT"};
+
+  auto  reader   = std::make_unique<ObservingInputReader>(lines, capturedCout);
+  auto *observer = reader.get();
+  auto  parser   = std::make_unique<CommandFactory>();
+  auto  ground   = std::make_unique<SimulatorGround>(5, 5);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground));
+
+  // Results are only written as they are produced in interactive mode
+  OutputSink::getInstance().setInteractive(true);
+  clearOutput();
+  sim.run();
+  OutputSink::getInstance().setInteractive(false);
+
+  // The first REPORT must be printed before the third line is pulled from the reader
+  ASSERT_EQ(observer->outputBeforeRead.size(), 5);
+  EXPECT_EQ(observer->outputBeforeRead[1].find("Output: 0,0,NORTH"), std::string::npos);
+  EXPECT_NE(observer->outputBeforeRead[2].find("Output: 0,0,NORTH"), std::string::npos);
+  EXPECT_EQ(observer->outputBeforeRead[2].find("Output: 0,1,NORTH"), std::string::npos);
+  EXPECT_NE(getCapturedOutput().find("Output: 0,1,NORTH"), std::string::npos);
+}
+
+TEST_F(RobotSimulatorTest, RunSimulatorBuffersResultsUntilEndOfRun) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH", "REPORT", "MOVE", "REPORT"};
+
+  auto  reader   = std::make_unique<ObservingInputReader>(lines, capturedCout);
+  auto *observer = reader.get();
+  auto  parser   = std::make_unique<CommandFactory>();
+  auto  ground   = std::make_unique<SimulatorGround>(5, 5);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground));
+
+  Logger::getInstance().setLogLevel(LogLevel::NONE);
+  clearOutput();
+  sim.run();
+
+  ASSERT_EQ(observer->outputBeforeRead.size(), 5);
+  EXPECT_EQ(observer->outputBeforeRead[4].find("Output:"), std::string::npos);
+  EXPECT_EQ(getCapturedOutput(), "Output: 0,0,NORTH\nOutput: 0,1,NORTH\n");
+}
+
+// Grounds too wide for PackedRobot run on Robot
+TEST_F(RobotSimulatorTest, RunSimulatorOnGroundWiderThanPackedState) {
+  std::vector<std::string> lines{"PLACE 20000,0,WEST", "MOVE", "REPORT", "PLACE 20001,0,EAST", "RIGHT", "MOVE"};
+
+  auto reader = std::make_unique<MockInputReader>(lines);
+  auto parser = std::make_unique<CommandFactory>();
+  auto ground = std::make_unique<SimulatorGround>(1, 20001);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground));
+
+  clearOutput();
+  sim.run();
+
+  std::string output = getCapturedOutput();
+  EXPECT_NE(output.find("Output: 19999,0,WEST"), std::string::npos);
+  EXPECT_NE(output.find("Cannot PLACE robot at 20001,0"), std::string::npos);
+  EXPECT_NE(output.find("Cannot move to 19999,1"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 2 Errors."), std::string::npos);
+}
+
+// 5x5 runs on StaticGround<5, 5>: coordinates above 2^32 must not wrap onto the ground
+TEST_F(RobotSimulatorTest, RunSimulatorRejectsPlaceAbove32BitsOnStaticGround) {
+  std::vector<std::string> lines{"PLACE 4294967296,0,NORTH", "REPORT", "PLACE 4294967299,4294967297,EAST", "REPORT"};
+
+  auto reader = std::make_unique<MockInputReader>(lines);
+  auto parser = std::make_unique<CommandFactory>();
+  auto ground = std::make_unique<SimulatorGround>(5, 5);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground));
+
+  clearOutput();
+  sim.run();
+  OutputSink::getInstance().flush();
+
+  std::string output = getCapturedOutput();
+  EXPECT_EQ(output.find("Output:"), std::string::npos);
+  EXPECT_NE(output.find("Cannot PLACE robot at 4294967296,0"), std::string::npos);
+  EXPECT_NE(output.find("Cannot PLACE robot at 4294967299,4294967297"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 2 Errors."), std::string::npos);
+
+  CommandExecutor executor;
+  Robot           robot;
+  EXPECT_EQ(executor.tryExecute(CommandFactory().decode("PLACE 4294967296,0,NORTH"), robot, StaticGround<5, 5>()).error,
+            ExecutionError::PLACE_OUT_OF_BOUNDS);
+  EXPECT_FALSE(robot.hasPlaced());
+}
+
+// More results than the sink buffers, written to a device that is always full: the write
+// error must surface as a FileException from run(), not end the process
+TEST_F(RobotSimulatorTest, RunSimulatorThrowsWhenResultsCannotBeWritten) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH"};
+  lines.insert(lines.end(), 20000, "REPORT");
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+
+  for (Engine engine : {Engine::STEP, Engine::TABLE}) {
+    OutputSink::getInstance().openFile("/dev/full");
+    RobotSimulator sim(std::make_unique<MockInputReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(5, 5), engine);
+    EXPECT_THROW(sim.run(), FileException) << static_cast<int>(engine);
+    OutputSink::getInstance().useConsole();
+  }
+}
+
+TEST_F(RobotSimulatorTest, RunSimulatorReportsLineCountAfterStreaming) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH", "MOVE", "INVALID"};
+
+  auto reader = std::make_unique<MockInputReader>(lines);
+  auto parser = std::make_unique<CommandFactory>();
+  auto ground = std::make_unique<SimulatorGround>(5, 5);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground));
+
+  clearOutput();
+  sim.run();
+
+  std::string output = getCapturedOutput();
+  EXPECT_NE(output.find("Parse error on line 3"), std::string::npos);
+  EXPECT_NE(output.find("Successfully read 3 lines"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 1 Errors."), std::string::npos);
+}
+
+TEST_F(RobotSimulatorTest, RunSimulatorWithVmEngine) {
+  std::vector<std::string> lines{"PLACE 0,0,NORTH", "MOVE", "MOVE", "MOVE", "RIGHT", "REPORT", "JUMP"};
+
+  auto reader = std::make_unique<MockInputReader>(lines);
+  auto parser = std::make_unique<CommandFactory>();
+  auto ground = std::make_unique<SimulatorGround>(2, 2);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground), Engine::VM);
+
+  clearOutput();
+  sim.run();
+
+  std::string output = getCapturedOutput();
+  EXPECT_NE(output.find("Output: 0,1,EAST"), std::string::npos);
+  EXPECT_NE(output.find("Execution error on line 3"), std::string::npos);
+  EXPECT_NE(output.find("Parse error on line 7"), std::string::npos);
+  EXPECT_NE(output.find("Successfully read 7 lines"), std::string::npos);
+  EXPECT_NE(output.find("Simulation completed with 3 Errors."), std::string::npos);
+}
+
+TEST_F(RobotSimulatorTest, RunSimulatorWithVmEngineAndEmptyInput) {
+  auto reader = std::make_unique<MockInputReader>(std::vector<std::string>{});
+  auto parser = std::make_unique<CommandFactory>();
+  auto ground = std::make_unique<SimulatorGround>(5, 5);
+
+  RobotSimulator sim(std::move(reader), std::move(parser), std::move(ground), Engine::VM);
+
+  clearOutput();
+  sim.run();
+
+  EXPECT_NE(getCapturedOutput().find("No input lines to process"), std::string::npos);
+}
+
+// Every engine must route around the same obstacles, with the step engine's output and messages
+TEST_F(RobotSimulatorTest, EnginesAgreeOnObstacleMap) {
+  auto map = std::make_shared<const ObstacleMap>(ObstacleMap::fromRows({
+    "......#...", //
+    "..##......", //
+    "......#...", //
+    ".#....#.#.", //
+    "..........", //
+    "...#......", //
+  }));
+
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 3,0,EAST", "PLACE 2,4,SOUTH", "PLACE 9,5,WEST", "MOVE", "MOVE",
+                        "MOVE",            "MOVE",           "LEFT",           "RIGHT",          "REPORT"};
+  std::mt19937             random(23);
+  std::vector<std::string> lines;
+  for (int i = 0; i < 3000; ++i) {
+    lines.emplace_back(pool[random() % (sizeof(pool) / sizeof(pool[0]))]);
+  }
+
+  auto simulate = [&](Engine engine, Optimizations optimizations) {
+    auto ground = std::make_unique<SimulatorGround>(6, 10);
+    ground->setObstacles(map);
+    clearOutput();
+    RobotSimulator sim(std::make_unique<MockInputReader>(lines), std::make_unique<CommandFactory>(), std::move(ground),
+                       engine, optimizations);
+    sim.run();
+    OutputSink::getInstance().flush();
+    return std::regex_replace(getCapturedOutput(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  };
+
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+  Optimizations none;
+  Optimizations all;
+  all.fuseRuns          = true;
+  all.eliminateDeadCode = true;
+
+  std::string expected = simulate(Engine::STEP, none);
+  EXPECT_NE(expected.find("position blocked by an obstacle"), std::string::npos);
+  for (Engine engine : {Engine::TABLE, Engine::LOCKSTEP, Engine::VM, Engine::SEGMENT}) {
+    EXPECT_EQ(simulate(engine, none), expected) << static_cast<int>(engine);
+  }
+  EXPECT_EQ(simulate(Engine::VM, all), expected);
+  EXPECT_EQ(simulate(Engine::SEGMENT, all), expected);
+}
+
+// A 2^40 x 2^40 ground with a sparse obstacle map, robots far from the origin and at the far edge
+TEST_F(RobotSimulatorTest, EnginesAgreeOnHugeSparseGround) {
+  const Coordinate side = MAX_GROUND_SIDE;
+  auto map = std::make_shared<const ObstacleMap>(ObstacleMap::fromCells(
+    {"1000000000003,5", "1000000000000,9", "999999999998,4", "1099511627775,1099511627772"}, side, side));
+  ASSERT_FALSE(map->isDense());
+
+  const char *pool[] = {"PLACE 1000000000000,5,EAST", "PLACE 1099511627775,1099511627775,SOUTH",
+                        "PLACE 1099511627776,0,NORTH", "MOVE", "MOVE", "MOVE", "MOVE", "LEFT", "RIGHT", "REPORT"};
+  std::mt19937             random(29);
+  std::vector<std::string> lines{"PLACE 1000000000000,5,EAST", "MOVE", "MOVE", "MOVE", "REPORT"};
+  for (int i = 0; i < 3000; ++i) {
+    lines.emplace_back(pool[random() % (sizeof(pool) / sizeof(pool[0]))]);
+  }
+
+  auto simulate = [&](Engine engine, Optimizations optimizations) {
+    auto ground = std::make_unique<SimulatorGround>(side, side);
+    ground->setObstacles(map);
+    clearOutput();
+    RobotSimulator sim(std::make_unique<MockInputReader>(lines), std::make_unique<CommandFactory>(), std::move(ground),
+                       engine, optimizations);
+    sim.run();
+    OutputSink::getInstance().flush();
+    return std::regex_replace(getCapturedOutput(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  };
+
+  Logger::getInstance().setLogLevel(LogLevel::ERROR);
+  Optimizations none;
+  Optimizations all;
+  all.fuseRuns          = true;
+  all.eliminateDeadCode = true;
+
+  std::string expected = simulate(Engine::STEP, none);
+  EXPECT_NE(expected.find("1000000000002,5,EAST"), std::string::npos);
+  EXPECT_NE(expected.find("position blocked by an obstacle"), std::string::npos);
+  EXPECT_NE(expected.find("Cannot PLACE robot at 1099511627776,0"), std::string::npos);
+  for (Engine engine : {Engine::TABLE, Engine::VM, Engine::SEGMENT}) {
+    EXPECT_EQ(simulate(engine, none), expected) << static_cast<int>(engine);
+  }
+  EXPECT_EQ(simulate(Engine::VM, all), expected);
+  EXPECT_EQ(simulate(Engine::SEGMENT, all), expected);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bytecode.hpp"
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "RobotSimulator.hpp"
+#include "SegmentEngine.hpp"
+#include "SimulatorGround.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+class SegmentEngineTest : public ::testing::Test {
+protected:
+  CommandFactory  factory;
+  SimulatorGround ground = SimulatorGround(5, 5);
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    std::cout.rdbuf(oldCout);
+  }
+
+  Program compileFused(const std::vector<std::string> &lines) {
+    LineReader reader(lines);
+    Program    program = compileProgram(reader, factory);
+    program.fuseRuns();
+    return program;
+  }
+
+  // Console output of a whole simulation, with log timestamps removed
+  std::string simulate(const std::vector<std::string> &lines, Engine engine,
+                       Optimizations optimizations = Optimizations()) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(6, 4), engine, optimizations);
+    sim.run();
+    return std::regex_replace(capturedCout.str(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  }
+};
+
+TEST_F(SegmentEngineTest, SegmentsSplitAtPlaceAndReport) {
+  Program program = compileFused({"MOVE", "PLACE 0,0,NORTH", "MOVE", "MOVE", "LEFT", "REPORT", "RIGHT", "MOVE"});
+
+  SegmentEngine engine(program);
+
+  EXPECT_EQ(engine.segmentCount(), 3U);
+}
+
+TEST_F(SegmentEngineTest, SegmentInsideGroundInClosedForm) {
+  Program program =
+      compileFused({"PLACE 0,0,NORTH", "MOVE", "MOVE", "MOVE", "RIGHT", "MOVE", "MOVE", "LEFT", "LEFT", "REPORT"});
+  Robot robot;
+
+  EXPECT_EQ(SegmentEngine(program).run(robot, ground), 0);
+  EXPECT_EQ(robot.getPosition(), Position(2, 3));
+  EXPECT_EQ(robot.getDirection(), Direction::WEST);
+  EXPECT_EQ(capturedCout.str(), "Output: 2,3,WEST\n");
+}
+
+TEST_F(SegmentEngineTest, SegmentCrossingEdgeFailsOnlyPastIt) {
+  std::vector<std::string> lines{"PLACE 3,3,EAST"};
+  lines.insert(lines.end(), 5, "MOVE");
+  lines.emplace_back("RIGHT");
+  lines.insert(lines.end(), 6, "MOVE");
+  lines.emplace_back("REPORT");
+
+  Program program = compileFused(lines);
+  Robot   robot;
+
+  // One cell east then three south; four and three moves fail
+  EXPECT_EQ(SegmentEngine(program).run(robot, ground), 7);
+  EXPECT_EQ(robot.getPosition(), Position(4, 0));
+  EXPECT_EQ(robot.getDirection(), Direction::SOUTH);
+}
+
+TEST_F(SegmentEngineTest, SegmentBeforePlaceFailsEveryLine) {
+  Program program = compileFused({"MOVE", "MOVE", "LEFT", "MOVE", "RIGHT", "RIGHT"});
+  Robot   robot;
+
+  EXPECT_EQ(SegmentEngine(program).run(robot, ground), 6);
+  EXPECT_FALSE(robot.hasPlaced());
+}
+
+TEST_F(SegmentEngineTest, ReturnsToStartAfterClosedLoop) {
+  Program program = compileFused({"PLACE 2,2,SOUTH", "MOVE", "LEFT", "MOVE", "LEFT", "MOVE", "LEFT", "MOVE", "LEFT"});
+  Robot   robot;
+
+  EXPECT_EQ(SegmentEngine(program).run(robot, ground), 0);
+  EXPECT_EQ(robot.getPosition(), Position(2, 2));
+  EXPECT_EQ(robot.getDirection(), Direction::SOUTH);
+}
+
+// REPORT output, error messages and error counts must match the step-by-step engine
+TEST_F(SegmentEngineTest, MatchesStepEngine) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 2,3,WEST", "PLACE 3,5,EAST", "PLACE 1,1", "MOVE", "MOVE",
+                        "MOVE",            "LEFT",           "RIGHT",          "REPORT",    "JUMP"};
+
+  std::mt19937                               random(17);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+  std::uniform_int_distribution<int>         runLength(1, 6);
+
+  Optimizations dce;
+  dce.eliminateDeadCode = true;
+
+  for (LogLevel level : {LogLevel::NONE, LogLevel::ERROR, LogLevel::WARNING}) {
+    Logger::getInstance().setLogLevel(level);
+
+    for (int script = 0; script < 20; ++script) {
+      std::vector<std::string> lines;
+      while (lines.size() < 300) {
+        const char *line = pool[pick(random)];
+        for (int i = runLength(random); i > 0; --i) {
+          lines.emplace_back(line);
+        }
+      }
+
+      std::string expected = simulate(lines, Engine::STEP);
+      ASSERT_EQ(simulate(lines, Engine::SEGMENT), expected) << "log level " << level;
+      ASSERT_EQ(simulate(lines, Engine::SEGMENT, dce), expected) << "log level " << level;
+    }
+  }
+}
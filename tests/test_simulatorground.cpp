@@ -2,6 +2,7 @@
 
 #include "SimulatorException.hpp"
 #include "SimulatorGround.hpp"
+#include "StaticGround.hpp"
 
 using namespace simulator;
 
@@ -72,3 +73,125 @@ TEST_F(SimulatorGroundTest, InvalidPositionForOutOfRangeYpos) {
 TEST_F(SimulatorGroundTest, InvalidPositionForOutOfRangeXYpos) {
   EXPECT_FALSE(ground.isValidPosition({5, 5}));
 }
+
+TEST_F(SimulatorGroundTest, OccupancyIsTrackedOnDemand) {
+  EXPECT_FALSE(ground.tracksOccupancy());
+  EXPECT_FALSE(ground.isOccupied({2, 3}));
+
+  ground.trackOccupancy();
+  EXPECT_TRUE(ground.tracksOccupancy());
+  ground.occupy({2, 3});
+  EXPECT_TRUE(ground.isOccupied({2, 3}));
+  EXPECT_FALSE(ground.isOccupied({3, 2}));
+  ground.vacate({2, 3});
+  EXPECT_FALSE(ground.isOccupied({2, 3}));
+
+  ground.occupy({4, 4});
+  ground.clearOccupancy();
+  EXPECT_FALSE(ground.tracksOccupancy());
+  EXPECT_FALSE(ground.isOccupied({4, 4}));
+}
+
+TEST(StaticGroundTest, MatchesDynamicGround) {
+  StaticGround<3, 7> fixed;
+  SimulatorGround    dynamic(3, 7);
+
+  EXPECT_EQ(fixed.getRows(), 3);
+  EXPECT_EQ(fixed.getCols(), 7);
+  for (int x = -2; x < 10; ++x) {
+    for (int y = -2; y < 10; ++y) {
+      EXPECT_EQ(fixed.isValidPosition({x, y}), dynamic.isValidPosition({x, y})) << x << "," << y;
+    }
+  }
+}
+
+TEST(StaticGroundTest, WithStaticGroundPicksTableEntry) {
+  int rows = 0;
+  int cols = 0;
+
+  EXPECT_TRUE(withStaticGround(5, 5, [&](const auto &ground) {
+    rows = ground.getRows();
+    cols = ground.getCols();
+  }));
+  EXPECT_EQ(rows, 5);
+  EXPECT_EQ(cols, 5);
+
+  EXPECT_TRUE(withStaticGround(100, 100, [&](const auto &ground) { rows = ground.getRows(); }));
+  EXPECT_EQ(rows, 100);
+}
+
+TEST(StaticGroundTest, WithStaticGroundFallsBackForOtherSizes) {
+  bool called = false;
+
+  EXPECT_FALSE(withStaticGround(5, 6, [&](const auto &) { called = true; }));
+  EXPECT_FALSE(withStaticGround(7, 7, [&](const auto &) { called = true; }));
+  EXPECT_FALSE(called);
+}
+
+TEST_F(SimulatorGroundTest, ObstaclesBlockCellsInsideTheBounds) {
+  EXPECT_FALSE(ground.hasObstacles());
+
+  auto map = std::make_shared<ObstacleMap>(5, 5);
+  map->block(Position(2, 3));
+  ground.setObstacles(map);
+
+  EXPECT_TRUE(ground.hasObstacles());
+  EXPECT_FALSE(ground.isValidPosition(Position(2, 3)));
+  EXPECT_TRUE(ground.isInside(Position(2, 3)));
+  EXPECT_TRUE(ground.isValidPosition(Position(3, 2)));
+  EXPECT_FALSE(ground.isInside(Position(5, 0)));
+
+  ground.setObstacles(nullptr);
+  EXPECT_TRUE(ground.isValidPosition(Position(2, 3)));
+}
+
+TEST_F(SimulatorGroundTest, ObstacleMapIsSharedNotCopied) {
+  auto map = std::make_shared<const ObstacleMap>(ObstacleMap::fromRows({".....", "..#..", ".....", ".....", "....."}));
+  ground.setObstacles(map);
+
+  SimulatorGround copy = ground;
+  EXPECT_EQ(copy.getObstacles(), map.get());
+  EXPECT_EQ(ground.getObstacles(), map.get());
+  EXPECT_FALSE(copy.isValidPosition(Position(2, 3)));
+  EXPECT_EQ(map.use_count(), 3);
+}
+
+TEST_F(SimulatorGroundTest, ObstacleMapMustMatchTheGround) {
+  EXPECT_THROW(ground.setObstacles(std::make_shared<const ObstacleMap>(5, 6)), InvalidInputException);
+  EXPECT_FALSE(ground.hasObstacles());
+}
+
+TEST_F(SimulatorGroundTest, SidesUpTo2To40Cells) {
+  const Coordinate side = MAX_GROUND_SIDE;
+  SimulatorGround  huge(side, side);
+
+  EXPECT_EQ(huge.getRows(), side);
+  EXPECT_EQ(huge.getCols(), side);
+  EXPECT_TRUE(huge.isValidPosition(Position(side - 1, side - 1)));
+  EXPECT_TRUE(huge.isValidPosition(Position(1000000000000, 5)));
+  EXPECT_FALSE(huge.isValidPosition(Position(side, 0)));
+  EXPECT_FALSE(huge.isValidPosition(Position(0, -1)));
+
+  EXPECT_THROW(SimulatorGround(side + 1, 5), InvalidInputException);
+  EXPECT_THROW(SimulatorGround(5, side + 1), InvalidInputException);
+}
+
+// Occupancy of a huge ground is a set of the occupied cells, not a grid
+TEST_F(SimulatorGroundTest, OccupancyOfHugeGround) {
+  const Coordinate side = MAX_GROUND_SIDE;
+  SimulatorGround  huge(side, side);
+
+  huge.trackOccupancy();
+  EXPECT_TRUE(huge.tracksOccupancy());
+  huge.occupy({side - 1, 7});
+  EXPECT_TRUE(huge.isOccupied({side - 1, 7}));
+  EXPECT_FALSE(huge.isOccupied({7, side - 1}));
+  huge.vacate({side - 1, 7});
+  EXPECT_FALSE(huge.isOccupied({side - 1, 7}));
+
+  huge.occupy({1, 1});
+  huge.clearOccupancy();
+  EXPECT_FALSE(huge.isOccupied({1, 1}));
+  huge.trackOccupancy();
+  EXPECT_FALSE(huge.isOccupied({1, 1}));
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "SimulatorException.hpp"
+#include "SpscRingBuffer.hpp"
+
+using namespace simulator;
+
+class SpscRingBufferTest : public ::testing::Test {
+protected:
+  SpscRingBuffer<int> buffer{4};
+
+  bool tryPush(int value) {
+    int *slot = buffer.producerSlot();
+    if (slot == nullptr) {
+      return false;
+    }
+    *slot = value;
+    buffer.push();
+    return true;
+  }
+};
+
+TEST_F(SpscRingBufferTest, ThrowByConstructorForInvalidCapacity) {
+  EXPECT_THROW(SpscRingBuffer<int>(0), InvalidInputException);
+  EXPECT_THROW(SpscRingBuffer<int>(3), InvalidInputException);
+}
+
+TEST_F(SpscRingBufferTest, InitiallyEmpty) {
+  EXPECT_EQ(buffer.front(), nullptr);
+  EXPECT_EQ(buffer.size(), 0);
+  EXPECT_EQ(buffer.capacity(), 4);
+}
+
+TEST_F(SpscRingBufferTest, FifoOrderAndFullDetection) {
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(tryPush(i));
+  }
+  EXPECT_FALSE(tryPush(4));
+  EXPECT_EQ(buffer.size(), 4);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NE(buffer.front(), nullptr);
+    EXPECT_EQ(*buffer.front(), i);
+    buffer.pop();
+  }
+  EXPECT_EQ(buffer.front(), nullptr);
+}
+
+TEST_F(SpscRingBufferTest, WrapsAround) {
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(tryPush(i));
+    ASSERT_NE(buffer.front(), nullptr);
+    EXPECT_EQ(*buffer.front(), i);
+    buffer.pop();
+  }
+}
+
+TEST_F(SpscRingBufferTest, ProducerAndConsumerThreads) {
+  SpscRingBuffer<int> queue(8);
+  const int           count = 100000;
+
+  std::thread producer([&]() {
+    for (int i = 0; i < count; ++i) {
+      int *slot;
+      while ((slot = queue.producerSlot()) == nullptr) {
+        std::this_thread::yield();
+      }
+      *slot = i;
+      queue.push();
+    }
+  });
+
+  int  expected = 0;
+  bool ordered  = true;
+  while (expected < count) {
+    int *value = queue.front();
+    if (value == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    ordered = ordered && *value == expected;
+    queue.pop();
+    ++expected;
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CommandExecutor.hpp"
+#include "CommandFactory.hpp"
+#include "Logger.hpp"
+#include "OutputSink.hpp"
+#include "RobotSimulator.hpp"
+#include "SimulatorException.hpp"
+#include "SimulatorGround.hpp"
+#include "TableExecutor.hpp"
+#include "TestLineReader.hpp"
+
+using namespace simulator;
+
+class TableExecutorTest : public ::testing::Test {
+protected:
+  CommandFactory  factory;
+  SimulatorGround ground = SimulatorGround(4, 6);
+
+  std::stringstream capturedCout;
+  std::streambuf   *oldCout = nullptr;
+
+  void SetUp() override {
+    Logger::getInstance().setLogLevel(LogLevel::NONE);
+    oldCout = std::cout.rdbuf(capturedCout.rdbuf());
+  }
+
+  void TearDown() override {
+    OutputSink::getInstance().flush();
+    std::cout.rdbuf(oldCout);
+  }
+
+  // REPORT results are buffered until flushed
+  std::string output() {
+    OutputSink::getInstance().flush();
+    return capturedCout.str();
+  }
+
+  // Console output of a whole simulation, with log timestamps removed
+  std::string simulate(const std::vector<std::string> &lines, Engine engine) {
+    capturedCout.str("");
+    RobotSimulator sim(std::make_unique<LineReader>(lines), std::make_unique<CommandFactory>(),
+                       std::make_unique<SimulatorGround>(4, 6), engine);
+    sim.run();
+    return std::regex_replace(capturedCout.str(), std::regex("^\\[[^\\]]*\\] ", std::regex::multiline), "");
+  }
+};
+
+TEST_F(TableExecutorTest, EncodeDecodeRoundTrip) {
+  TableExecutor table(ground);
+
+  EXPECT_EQ(table.stateCount(), 4U * 6U * 4U + 1U);
+  EXPECT_FALSE(table.decode(table.unplaced()).hasPlaced());
+  EXPECT_EQ(table.encode(Robot()), table.unplaced());
+
+  for (RobotState state = 0; state < table.unplaced(); ++state) {
+    Robot robot = table.decode(state);
+    ASSERT_TRUE(robot.hasPlaced());
+    ASSERT_TRUE(ground.isValidPosition(robot.getPosition()));
+    ASSERT_EQ(table.encode(robot), state);
+  }
+}
+
+TEST_F(TableExecutorTest, ReportsErrorsLikeCommandExecutor) {
+  TableExecutor table(ground);
+  RobotState    state = table.unplaced();
+
+  ExecutionResult result = table.tryExecute(factory.decode("MOVE"), state, 3);
+  EXPECT_EQ(result.error, ExecutionError::NOT_PLACED);
+  EXPECT_EQ(result.line, 3U);
+  EXPECT_EQ(state, table.unplaced());
+
+  result = table.tryExecute(factory.decode("PLACE 6,0,NORTH"), state);
+  EXPECT_EQ(result.error, ExecutionError::PLACE_OUT_OF_BOUNDS);
+
+  EXPECT_TRUE(table.tryExecute(factory.decode("PLACE 5,3,EAST"), state).ok());
+  result = table.tryExecute(factory.decode("MOVE"), state);
+  EXPECT_EQ(result.error, ExecutionError::MOVE_OUT_OF_BOUNDS);
+  EXPECT_EQ(result.position, Position(6, 3));
+  EXPECT_EQ(CommandExecutor::describe(result, ground), "Cannot move to 6,3: position out of bounds");
+
+  EXPECT_TRUE(table.tryExecute(factory.decode("LEFT"), state).ok());
+  EXPECT_TRUE(table.tryExecute(factory.decode("LEFT"), state).ok());
+  EXPECT_TRUE(table.tryExecute(factory.decode("MOVE"), state).ok());
+  EXPECT_TRUE(table.tryExecute(factory.decode("REPORT"), state).ok());
+  EXPECT_EQ(output(), "Output: 4,3,WEST\n");
+
+  EXPECT_EQ(table.tryExecute(ParsedCommand(), state).error, ExecutionError::INVALID_COMMAND);
+}
+
+TEST_F(TableExecutorTest, RejectsGroundOverCellLimit) {
+  EXPECT_TRUE(TableExecutor::fits(ground, 24));
+  EXPECT_FALSE(TableExecutor::fits(ground, 23));
+  EXPECT_THROW(TableExecutor(ground, 23), InvalidInputException);
+}
+
+// Every command on a random walk must agree with CommandExecutor on state, result and output
+TEST_F(TableExecutorTest, MatchesCommandExecutor) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 5,3,WEST", "PLACE 6,1,EAST", "MOVE", "MOVE",
+                        "MOVE",            "LEFT",           "RIGHT",          "REPORT"};
+
+  std::mt19937                               random(23);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+
+  TableExecutor   table(ground);
+  CommandExecutor executor;
+  RobotState      state = table.unplaced();
+  Robot           robot;
+
+  for (int i = 0; i < 5000; ++i) {
+    ParsedCommand command = factory.decode(pool[pick(random)]);
+
+    capturedCout.str("");
+    ExecutionResult expected       = executor.tryExecute(command, robot, ground);
+    std::string     expectedOutput = output();
+
+    capturedCout.str("");
+    ExecutionResult actual = table.tryExecute(command, state);
+
+    ASSERT_EQ(actual.error, expected.error);
+    ASSERT_EQ(actual.position, expected.position);
+    ASSERT_EQ(output(), expectedOutput);
+    ASSERT_EQ(state, table.encode(robot));
+  }
+}
+
+TEST_F(TableExecutorTest, MatchesStepEngine) {
+  const char *pool[] = {"PLACE 0,0,NORTH", "PLACE 2,3,WEST", "PLACE 3,5,EAST", "PLACE 1,1", "MOVE", "MOVE",
+                        "MOVE",            "LEFT",           "RIGHT",          "REPORT",    "JUMP"};
+
+  std::mt19937                               random(29);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+
+  for (LogLevel level : {LogLevel::NONE, LogLevel::ERROR, LogLevel::WARNING, LogLevel::INFO}) {
+    Logger::getInstance().setLogLevel(level);
+
+    for (int script = 0; script < 10; ++script) {
+      std::vector<std::string> lines;
+      for (int i = 0; i < 200; ++i) {
+        lines.emplace_back(pool[pick(random)]);
+      }
+
+      ASSERT_EQ(simulate(lines, Engine::TABLE), simulate(lines, Engine::STEP)) << "log level " << level;
+    }
+  }
+}
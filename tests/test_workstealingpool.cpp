@@ -0,0 +1,75 @@
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingPool.hpp"
+
+using namespace simulator;
+
+TEST(WorkStealingPoolTest, RunsEveryJobExactlyOnce) {
+  WorkStealingPool pool(4);
+  EXPECT_EQ(pool.getThreadCount(), 4U);
+
+  std::vector<std::atomic<int>> runs(10007);
+  pool.run(runs.size(), [&](std::size_t index) { runs[index].fetch_add(1); });
+
+  for (const auto &count : runs) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+TEST(WorkStealingPoolTest, DefaultUsesHardwareThreads) {
+  WorkStealingPool pool;
+  EXPECT_GE(pool.getThreadCount(), 1U);
+}
+
+TEST(WorkStealingPoolTest, EmptyAndTinyBatches) {
+  WorkStealingPool pool(8);
+  std::atomic<int> runs{0};
+
+  pool.run(0, [&](std::size_t) { runs++; });
+  EXPECT_EQ(runs.load(), 0);
+
+  // Fewer jobs than workers: idle workers steal nothing and stop
+  pool.run(3, [&](std::size_t) { runs++; });
+  EXPECT_EQ(runs.load(), 3);
+}
+
+TEST(WorkStealingPoolTest, IdleWorkersStealFromBusyOnes) {
+  WorkStealingPool pool(2);
+  std::atomic<int> runs{0};
+
+  // All slow jobs sit in the first worker's block; the second worker's block is done at once
+  pool.run(64, [&](std::size_t index) {
+    if (index < 32) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    runs++;
+  });
+
+  EXPECT_EQ(runs.load(), 64);
+  EXPECT_GT(pool.getSteals(), 0U);
+}
+
+TEST(WorkStealingPoolTest, RethrowsFirstJobException) {
+  WorkStealingPool pool(4);
+  std::atomic<int> runs{0};
+
+  EXPECT_THROW(pool.run(1000,
+                        [&](std::size_t index) {
+                          runs++;
+                          if (index == 10) {
+                            throw std::runtime_error("job failed");
+                          }
+                        }),
+               std::runtime_error);
+  EXPECT_LE(runs.load(), 1000);
+
+  // The pool can be reused after a failure
+  runs = 0;
+  pool.run(10, [&](std::size_t) { runs++; });
+  EXPECT_EQ(runs.load(), 10);
+}